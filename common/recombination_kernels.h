@@ -0,0 +1,175 @@
+#ifndef RECOMBINATION_KERNELS_H
+#define RECOMBINATION_KERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Branch-free helpers for the batched real-valued recombinations
+ *        and population mutations
+ *
+ * Shared by crossover/, mutation/ and the engines; tournament selection
+ * and the EDAs draw from the same hash32.
+ *
+ * Everything here works element by element on contiguous arrays without
+ * library calls, so loops built from it vectorise: uniforms come from a
+ * counter-based hash instead of a sequential engine, pow is computed
+ * as exp2(y log2 x) with polynomial log2/exp2 (relative error below 1e-9
+ * for normal positive x), and normals come from Box-Muller with the same
+ * polynomials plus a sine/cosine series.
+ */
+namespace recombination_kernels {
+
+/** @brief Counter-based 32-bit hash (lowbias32) */
+inline uint32_t hash32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief Key of sub-stream @p index of @p key
+ *
+ * The index goes through the hash rather than being added to a counter, so
+ * sub-streams never share uniforms however long they are or however many
+ * there are.
+ */
+inline uint32_t streamKey(uint32_t key, uint64_t index) {
+    const uint32_t mixed = hash32(static_cast<uint32_t>(index) ^ hash32(static_cast<uint32_t>(index >> 32)));
+    return hash32(key ^ mixed);
+}
+
+/**
+ * @brief Fill out[0..count) with uniforms in (0, 1)
+ * @param counter Index of out[0] in the stream; counter and key1 are summed,
+ *        so separate streams by key2 (see streamKey), not by counter offsets
+ */
+inline void fillUniform(double* out, size_t count, uint32_t counter, uint32_t key1, uint32_t key2) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t h = hash32(hash32(counter + static_cast<uint32_t>(i) + key1) ^ key2);
+        out[i] = (static_cast<double>(h) + 0.5) * (1.0 / 4294967296.0);
+    }
+}
+
+/**
+ * @brief Reinterpret helpers; integer/double conversions go through the
+ *        2^52 magic constant because SSE2 has no 64-bit integer conversions
+ */
+inline uint64_t bitsOf(double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return bits;
+}
+
+inline double fromBits(uint64_t bits) {
+    double x;
+    std::memcpy(&x, &bits, sizeof x);
+    return x;
+}
+
+/**
+ * @brief 1.0 where a < b, 0.0 elsewhere (finite arguments)
+ *
+ * Taken from the sign bit of a - b. Comparisons feeding a ?: are turned
+ * into branches around the arms, and GCC will not execute floating-point
+ * arms speculatively while traps are honoured, so the loop stays scalar.
+ */
+inline double lessThan(double a, double b) {
+    return fromBits(0x4330000000000000ULL | (bitsOf(a - b) >> 63)) - 4503599627370496.0;
+}
+
+/** @brief a where mask is 1.0, b where it is 0.0 (both finite) */
+inline double blend(double mask, double a, double b) {
+    return mask * a + (1.0 - mask) * b;
+}
+
+/** @brief log2 of a positive normal double */
+inline double fastLog2(double x) {
+    const uint64_t bits = bitsOf(x);
+    // x = m * 2^e with m in [0.75, 1.5), keeping the series argument small:
+    // a mantissa of 1.5 or more (top fraction bit set) is halved
+    const uint64_t high = (bits >> 51) & 1;
+    const double m = fromBits(((bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL) - (high << 52));
+    // Biased exponent as a double: 2^52 + e - 2^52
+    const double e = fromBits(0x4330000000000000ULL | (((bits >> 52) & 0x7ff) + high)) - 4503599627370496.0 - 1023.0;
+    // ln m = 2 atanh(t), t = (m - 1) / (m + 1), |t| <= 0.2
+    const double t = (m - 1.0) / (m + 1.0);
+    const double t2 = t * t;
+    const double series = t * (2.0 + t2 * (2.0 / 3 + t2 * (2.0 / 5 + t2 * (2.0 / 7 + t2 * (2.0 / 9 + t2 * (2.0 / 11 + t2 * (2.0 / 13)))))));
+    return e + series * 1.4426950408889634; // 1 / ln 2
+}
+
+/** @brief 2^y; beyond +-1022 the power of two saturates at 2^+-1022 */
+inline double fastExp2(double y) {
+    // y = n + f with f in [-0.5, 0.5]: adding 1.5 * 2^52 rounds y to n
+    const double rounded = (y + 6755399441055744.0) - 6755399441055744.0;
+    const double f = (y - rounded) * 0.6931471805599453; // f ln 2
+    // Clamping n rather than y keeps the polynomial live for every input
+    const double n = blend(lessThan(rounded, -1022.0), -1022.0, blend(lessThan(1022.0, rounded), 1022.0, rounded));
+    double p = 1.0 / 3628800;
+    p = p * f + 1.0 / 362880;
+    p = p * f + 1.0 / 40320;
+    p = p * f + 1.0 / 5040;
+    p = p * f + 1.0 / 720;
+    p = p * f + 1.0 / 120;
+    p = p * f + 1.0 / 24;
+    p = p * f + 1.0 / 6;
+    p = p * f + 0.5;
+    p = p * f + 1.0;
+    p = p * f + 1.0;
+    // n + 1.5 * 2^52 holds n in its low mantissa bits; n + 1023 is the exponent field
+    return p * fromBits((bitsOf(n + 6755399441055744.0) + 1023) << 52);
+}
+
+/** @brief x^y for positive normal x */
+inline double fastPow(double x, double y) {
+    return fastExp2(y * fastLog2(x));
+}
+
+/**
+ * @brief Two independent standard normals from two uniforms in (0, 1)
+ *
+ * Box-Muller: r = sqrt(-2 ln u1) at angle 2 pi (u2 - 1/2). The square root
+ * is taken by Newton's method, since std::sqrt keeps an errno branch; sine
+ * and cosine of the half angle (within +-pi/2) are Taylor series accurate
+ * to about 1e-12, doubled into the full angle. Hash uniforms stay above 2^-33,
+ * so |z| is at most about 6.8.
+ */
+inline void normalPair(double u1, double u2, double& z0, double& z1) {
+    const double squared = -1.3862943611198906 * fastLog2(u1); // -2 ln u1
+    // 1 / sqrt from the exponent-halving bit trick (within 4%), four Newton steps
+    double inv = fromBits(0x5fe6eb50c7b537a9ULL - (bitsOf(squared) >> 1));
+    for (int step = 0; step < 4; ++step) inv *= 1.5 - 0.5 * squared * inv * inv;
+    const double r = squared * inv;
+    const double h = 3.141592653589793 * (u2 - 0.5);
+    const double h2 = h * h;
+    double sine = 1.0 / 355687428096000;
+    sine = sine * h2 - 1.0 / 1307674368000;
+    sine = sine * h2 + 1.0 / 6227020800;
+    sine = sine * h2 - 1.0 / 39916800;
+    sine = sine * h2 + 1.0 / 362880;
+    sine = sine * h2 - 1.0 / 5040;
+    sine = sine * h2 + 1.0 / 120;
+    sine = sine * h2 - 1.0 / 6;
+    sine = (sine * h2 + 1.0) * h;
+    double cosine = 1.0 / 20922789888000;
+    cosine = cosine * h2 - 1.0 / 87178291200;
+    cosine = cosine * h2 + 1.0 / 479001600;
+    cosine = cosine * h2 - 1.0 / 3628800;
+    cosine = cosine * h2 + 1.0 / 40320;
+    cosine = cosine * h2 - 1.0 / 720;
+    cosine = cosine * h2 + 1.0 / 24;
+    cosine = cosine * h2 - 0.5;
+    cosine = cosine * h2 + 1.0;
+    z0 = r * (cosine * cosine - sine * sine);
+    z1 = r * (2.0 * sine * cosine);
+}
+
+} // namespace recombination_kernels
+
+#endif // RECOMBINATION_KERNELS_H
@@ -19,3 +19,52 @@ TreeNode* TreeNode::clone() const {
     }
     return copy;
 }
+
+// ============================================================================
+// BUFFER-BASED CROSSOVER FALLBACKS
+// ============================================================================
+
+void CrossoverOperator::checkBuffers(size_t parent1, size_t parent2, size_t child1, size_t child2) {
+    if (parent1 != parent2) {
+        throw std::invalid_argument("Parents must have the same length");
+    }
+    if (child1 != parent1 || child2 != parent1) {
+        throw std::invalid_argument("Child buffers must be pre-sized to the parent length");
+    }
+}
+
+void CrossoverOperator::crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                                      RealSpan child1, RealSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    auto children = crossover(RealVector(parent1.begin(), parent1.end()),
+                              RealVector(parent2.begin(), parent2.end()));
+    std::copy(children.first.begin(), children.first.end(), child1.begin());
+    std::copy(children.second.begin(), children.second.end(), child2.begin());
+}
+
+void CrossoverOperator::crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                                      IntSpan child1, IntSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    auto children = crossover(IntVector(parent1.begin(), parent1.end()),
+                              IntVector(parent2.begin(), parent2.end()));
+    std::copy(children.first.begin(), children.first.end(), child1.begin());
+    std::copy(children.second.begin(), children.second.end(), child2.begin());
+}
+
+void CrossoverOperator::crossoverInto(const BitString& parent1, const BitString& parent2,
+                                      BitString& child1, BitString& child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    auto children = crossover(parent1, parent2);
+    child1 = children.first;
+    child2 = children.second;
+}
+
+void CrossoverOperator::crossoverBatch(const double* population, size_t dimension, const size_t* parents,
+                                       size_t pairs, double* offspring) {
+    for (size_t t = 0; t < pairs; ++t) {
+        crossoverInto(ConstRealSpan(population + parents[2 * t] * dimension, dimension),
+                      ConstRealSpan(population + parents[2 * t + 1] * dimension, dimension),
+                      RealSpan(offspring + 2 * t * dimension, dimension),
+                      RealSpan(offspring + (2 * t + 1) * dimension, dimension));
+    }
+}
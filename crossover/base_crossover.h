@@ -9,6 +9,10 @@
 #include <set>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 // Type definitions
 using BitString = std::vector<bool>;
@@ -16,6 +20,41 @@ using RealVector = std::vector<double>;
 using IntVector = std::vector<int>;
 using Permutation = std::vector<int>;
 
+/**
+ * @brief Non-owning view over a contiguous run of genes
+ *
+ * Minimal stand-in for std::span (the project targets C++17). A view can be
+ * built from any container exposing data() and size(), e.g. std::vector<double>
+ * or a row of a population matrix, and never allocates.
+ */
+template <typename T>
+class GeneSpan {
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    GeneSpan() = default;
+    GeneSpan(T* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible<
+                  decltype(std::declval<Container&>().data()), T*>::value>>
+    GeneSpan(Container& container) : data_(container.data()), size_(container.size()) {}
+
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T& operator[](size_t i) const { return data_[i]; }
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+};
+
+using RealSpan = GeneSpan<double>;
+using ConstRealSpan = GeneSpan<const double>;
+using IntSpan = GeneSpan<int>;
+using ConstIntSpan = GeneSpan<const int>;
+
 // Tree node structure for GP
 struct TreeNode {
     std::string value;
@@ -63,6 +102,40 @@ public:
         throw std::runtime_error("Integer vector crossover not implemented for " + operator_name);
     }
     
+    // Buffer-based crossover: parents are read through views and the children
+    // are written into caller-owned storage that already has the parents'
+    // length. Operators override these to avoid allocating per mating; the
+    // defaults fall back to the allocating overloads above and copy the result.
+    // The children must not overlap the parents or each other: the real-valued
+    // kernels read the parents while writing the children through restricted
+    // pointers.
+    virtual void crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                               RealSpan child1, RealSpan child2);
+    
+    virtual void crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                               IntSpan child1, IntSpan child2);
+    
+    // std::vector<bool> is bit-packed and cannot be viewed as a span, so bit
+    // strings are passed by reference; child1/child2 must be pre-sized.
+    virtual void crossoverInto(const BitString& parent1, const BitString& parent2,
+                               BitString& child1, BitString& child2);
+    
+    /**
+     * @brief Recombine many real-valued parent pairs of a population matrix
+     * @param population Row-major parents, dimension genes per row
+     * @param dimension Genes per row
+     * @param parents 2 * pairs row indices; pair t is parents[2t], parents[2t + 1]
+     * @param pairs Number of pairs
+     * @param offspring Output, row-major, rows 2t and 2t + 1 for pair t;
+     *        must not overlap population
+     *
+     * The default calls crossoverInto() once per pair. The real-valued
+     * recombinations override it with kernels that draw all uniforms of a
+     * pair in one bulk fill and run branch-free over the genes.
+     */
+    virtual void crossoverBatch(const double* population, size_t dimension, const size_t* parents,
+                                size_t pairs, double* offspring);
+    
     // Statistics methods
     size_t getOperationCount() const { return operation_count; }
     size_t getErrorCount() const { return error_count; }
@@ -73,6 +146,24 @@ public:
     
     // Getter for operator name
     std::string getName() const { return operator_name; }
+
+protected:
+    /**
+     * @brief Validate parent/child lengths for the buffer-based interface
+     * @throws std::invalid_argument if parents differ in length or a child
+     *         buffer is not sized to match them
+     */
+    static void checkBuffers(size_t parent1, size_t parent2, size_t child1, size_t child2);
+    
+    /**
+     * @brief Draw the two stream keys of one crossoverBatch() call from rng
+     */
+    void batchKeys(uint32_t& key1, uint32_t& key2) {
+        key1 = static_cast<uint32_t>(rng());
+        key2 = static_cast<uint32_t>(rng());
+    }
+    
+    std::vector<double> batch_uniforms_; ///< Per-pair uniforms of crossoverBatch()
 };
 
 #endif // BASE_CROSSOVER_H
@@ -1,4 +1,5 @@
 #include "blend_crossover.h"
+#include "common/recombination_kernels.h"
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
@@ -7,37 +8,55 @@
 // BLEND CROSSOVER (BLX-α) IMPLEMENTATION
 // ============================================================================
 
-std::pair<RealVector, RealVector> BlendCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
+void BlendCrossover::recombine(const double* parent1, const double* parent2, const double* u,
+                               double* __restrict child1, double* __restrict child2, size_t n) const {
+    const double width = 1.0 + 2.0 * alpha;
+    for (size_t i = 0; i < n; ++i) {
+        // Uniform over [lower - alpha I, upper + alpha I], I = upper - lower
+        const double lower = std::min(parent1[i], parent2[i]);
+        const double interval = std::max(parent1[i], parent2[i]) - lower;
+        const double extended_lower = lower - alpha * interval;
+        child1[i] = extended_lower + u[i] * width * interval;
+        child2[i] = extended_lower + u[n + i] * width * interval;
     }
+}
+
+void BlendCrossover::crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                                   RealSpan child1, RealSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
     
     operation_count++;
     
-    size_t length = parent1.size();
-    RealVector child1(length), child2(length);
-    
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    const size_t n = parent1.size();
+    uint32_t key1, key2;
+    batchKeys(key1, key2);
+    batch_uniforms_.resize(2 * n);
+    recombination_kernels::fillUniform(batch_uniforms_.data(), 2 * n, 0, key1, key2);
+    recombine(parent1.data(), parent2.data(), batch_uniforms_.data(), child1.data(), child2.data(), n);
+}
+
+void BlendCrossover::crossoverBatch(const double* population, size_t dimension, const size_t* parents,
+                                    size_t pairs, double* offspring) {
+    operation_count += pairs;
     
-    // For each gene position, perform blend crossover
-    for (size_t i = 0; i < length; ++i) {
-        double p1_val = parent1[i];
-        double p2_val = parent2[i];
-        
-        // Determine the interval bounds
-        double lower = std::min(p1_val, p2_val);
-        double upper = std::max(p1_val, p2_val);
-        double interval = upper - lower;
-        
-        // Extend the interval by alpha on both sides
-        double extended_lower = lower - alpha * interval;
-        double extended_upper = upper + alpha * interval;
-        
-        // Generate random values within the extended interval
-        std::uniform_real_distribution<double> gene_dist(extended_lower, extended_upper);
-        child1[i] = gene_dist(rng);
-        child2[i] = gene_dist(rng);
+    uint32_t key1, key2;
+    batchKeys(key1, key2);
+    batch_uniforms_.resize(2 * dimension);
+    for (size_t t = 0; t < pairs; ++t) {
+        recombination_kernels::fillUniform(batch_uniforms_.data(), 2 * dimension,
+                                           static_cast<uint32_t>(2 * t * dimension), key1, key2);
+        recombine(population + parents[2 * t] * dimension, population + parents[2 * t + 1] * dimension,
+                  batch_uniforms_.data(), offspring + 2 * t * dimension, offspring + (2 * t + 1) * dimension,
+                  dimension);
+    }
+}
+
+std::pair<RealVector, RealVector> BlendCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
     }
     
-    return {child1, child2};
+    RealVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
@@ -48,6 +48,24 @@ public:
      */
     std::pair<RealVector, RealVector> crossover(const RealVector& parent1, const RealVector& parent2) override;
     
+    /**
+     * @brief Perform blend crossover on real-valued vectors without allocation
+     * @param parent1 First parent chromosome
+     * @param parent2 Second parent chromosome
+     * @param child1 First offspring buffer, sized like the parents
+     * @param child2 Second offspring buffer, sized like the parents
+     */
+    void crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                       RealSpan child1, RealSpan child2) override;
+    using CrossoverOperator::crossoverInto;
+    
+    /**
+     * @brief Blend crossover over parent pairs of a population matrix
+     * @see CrossoverOperator::crossoverBatch
+     */
+    void crossoverBatch(const double* population, size_t dimension, const size_t* parents,
+                        size_t pairs, double* offspring) override;
+    
     // Note: BLX-α is specifically designed for real-valued representations
     // Binary and integer versions are not implemented as they don't make sense
     std::pair<BitString, BitString> crossover(const BitString& /* parent1 */, const BitString& /* parent2 */) override {
@@ -57,6 +75,13 @@ public:
     std::pair<IntVector, IntVector> crossover(const IntVector& /* parent1 */, const IntVector& /* parent2 */) override {
         throw std::runtime_error("BLX-α crossover is not applicable to integer vectors");
     }
+
+private:
+    /**
+     * @brief BLX-α of one pair given 2n uniforms, u[i] for child1 and u[n + i] for child2
+     */
+    void recombine(const double* parent1, const double* parent2, const double* u,
+                   double* __restrict child1, double* __restrict child2, size_t n) const;
 };
 
 #endif // BLEND_CROSSOVER_H
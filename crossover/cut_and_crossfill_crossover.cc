@@ -1,49 +1,60 @@
 #include "cut_and_crossfill_crossover.h"
-#include <unordered_set>
+#include <algorithm>
 #include <stdexcept>
 
 // ============================================================================
 // CUT-AND-CROSSFILL CROSSOVER IMPLEMENTATION
 // ============================================================================
 
-std::pair<Permutation, Permutation> CutAndCrossfillCrossover::crossover(const Permutation& parent1, const Permutation& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
-    }
+void CutAndCrossfillCrossover::crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                                             IntSpan child1, IntSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
     
     operation_count++;
     
     size_t length = parent1.size();
-    if (length <= 1) return {parent1, parent2};
+    if (length <= 1) {
+        std::copy(parent1.begin(), parent1.end(), child1.begin());
+        std::copy(parent2.begin(), parent2.end(), child2.begin());
+        return;
+    }
+    
+    validatePermutation(parent1, used1_);
+    validatePermutation(parent2, used2_);
     
     // Select random cut point
     std::uniform_int_distribution<size_t> dist(1, length - 1);
     size_t cut_point = dist(rng);
     
-    Permutation child1, child2;
-    child1.reserve(length);
-    child2.reserve(length);
-    
     // Copy first segments
+    used1_.reset(length);
+    used2_.reset(length);
     for (size_t i = 0; i < cut_point; ++i) {
-        child1.push_back(parent1[i]);
-        child2.push_back(parent2[i]);
+        child1[i] = parent1[i];
+        child2[i] = parent2[i];
+        used1_.set(parent1[i]);
+        used2_.set(parent2[i]);
     }
     
     // Fill remaining positions from other parent (in order)
-    std::unordered_set<int> used1(child1.begin(), child1.end());
-    std::unordered_set<int> used2(child2.begin(), child2.end());
-    
+    size_t fill1 = cut_point;
+    size_t fill2 = cut_point;
     for (size_t i = 0; i < length; ++i) {
-        if (used1.find(parent2[i]) == used1.end()) {
-            child1.push_back(parent2[i]);
-            used1.insert(parent2[i]);
+        if (!used1_.test(parent2[i])) {
+            child1[fill1++] = parent2[i];
         }
-        if (used2.find(parent1[i]) == used2.end()) {
-            child2.push_back(parent1[i]);
-            used2.insert(parent1[i]);
+        if (!used2_.test(parent1[i])) {
+            child2[fill2++] = parent1[i];
         }
     }
+}
+
+std::pair<Permutation, Permutation> CutAndCrossfillCrossover::crossover(const Permutation& parent1, const Permutation& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
+    }
     
-    return {child1, child2};
+    Permutation child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
@@ -2,13 +2,21 @@
 #define CUT_AND_CROSSFILL_CROSSOVER_H
 
 #include "base_crossover.h"
+#include "permutation_index.h"
 
 class CutAndCrossfillCrossover : public CrossoverOperator {
+private:
+    ValueBitmap used1_; ///< Values already placed in child1
+    ValueBitmap used2_; ///< Values already placed in child2
+    
 public:
     CutAndCrossfillCrossover(unsigned seed = std::random_device{}()) 
         : CrossoverOperator("CutAndCrossfillCrossover", seed) {}
     
     std::pair<Permutation, Permutation> crossover(const Permutation& parent1, const Permutation& parent2);
+    void crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                       IntSpan child1, IntSpan child2) override;
+    using CrossoverOperator::crossoverInto;
 };
 
 #endif // CUT_AND_CROSSFILL_CROSSOVER_H
@@ -1,39 +1,45 @@
 #include "cycle_crossover.h"
-#include <unordered_set>
+#include <algorithm>
 #include <stdexcept>
 
 // ============================================================================
 // CYCLE CROSSOVER IMPLEMENTATION
 // ============================================================================
 
-std::vector<std::vector<int>> CycleCrossover::findCycles(const Permutation& parent1, const Permutation& parent2) {
-    std::vector<std::vector<int>> cycles;
-    std::unordered_set<int> processed;
+void CycleCrossover::crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                                   IntSpan child1, IntSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
     
+    operation_count++;
+    
+    validatePermutation(parent1, visited_);
+    position2_.build(parent2);
+    
+    std::copy(parent2.begin(), parent2.end(), child1.begin());
+    std::copy(parent1.begin(), parent1.end(), child2.begin());
+    
+    // Walk each cycle once, in order of its smallest position; even-numbered
+    // cycles keep their genes from the same parent, odd ones are exchanged.
+    // The inverse of parent2 gives the next position in O(1), so the whole
+    // pass is O(n).
+    visited_.reset(parent1.size());
+    bool from_same_parent = true;
     for (size_t i = 0; i < parent1.size(); ++i) {
-        if (processed.find(i) != processed.end()) continue;
-        
-        std::vector<int> cycle;
-        int current = i;
+        if (visited_.test(static_cast<int>(i))) continue;
         
+        int current = static_cast<int>(i);
         do {
-            cycle.push_back(current);
-            processed.insert(current);
-            
-            // Find where parent1[current] appears in parent2
-            int target_value = parent1[current];
-            for (size_t j = 0; j < parent2.size(); ++j) {
-                if (parent2[j] == target_value) {
-                    current = j;
-                    break;
-                }
+            visited_.set(current);
+            if (from_same_parent) {
+                child1[current] = parent1[current];
+                child2[current] = parent2[current];
             }
+            // Find where parent1[current] appears in parent2
+            current = position2_[parent1[current]];
         } while (current != static_cast<int>(i));
         
-        cycles.push_back(cycle);
+        from_same_parent = !from_same_parent;
     }
-    
-    return cycles;
 }
 
 std::pair<Permutation, Permutation> CycleCrossover::crossover(const Permutation& parent1, const Permutation& parent2) {
@@ -41,20 +47,7 @@ std::pair<Permutation, Permutation> CycleCrossover::crossover(const Permutation&
         throw std::invalid_argument("Parents must have the same length");
     }
     
-    operation_count++;
-    
-    auto cycles = findCycles(parent1, parent2);
-    
-    Permutation child1 = parent2;
-    Permutation child2 = parent1;
-    
-    // Alternate cycles between parents
-    for (size_t i = 0; i < cycles.size(); i += 2) {
-        for (int pos : cycles[i]) {
-            child1[pos] = parent1[pos];
-            child2[pos] = parent2[pos];
-        }
-    }
-    
-    return {child1, child2};
+    Permutation child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
@@ -2,16 +2,27 @@
 #define CYCLE_CROSSOVER_H
 
 #include "base_crossover.h"
+#include "permutation_index.h"
 
+/**
+ * @brief Cycle Crossover (CX) for permutations of 0..n-1
+ *
+ * Cycles are traced through the inverse of parent2, giving an O(n) pass with
+ * scratch buffers reused between calls.
+ */
 class CycleCrossover : public CrossoverOperator {
+private:
+    PositionIndex position2_; ///< Inverse of parent2
+    ValueBitmap visited_;     ///< Positions already assigned to a cycle
+    
 public:
     CycleCrossover(unsigned seed = std::random_device{}()) 
         : CrossoverOperator("CycleCrossover", seed) {}
     
     std::pair<Permutation, Permutation> crossover(const Permutation& parent1, const Permutation& parent2);
-    
-private:
-    std::vector<std::vector<int>> findCycles(const Permutation& parent1, const Permutation& parent2);
+    void crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                       IntSpan child1, IntSpan child2) override;
+    using CrossoverOperator::crossoverInto;
 };
 
 #endif // CYCLE_CROSSOVER_H
@@ -6,24 +6,33 @@
 // ============================================================================
 
 RealVector DifferentialEvolutionCrossover::performCrossover(const RealVector& target, const RealVector& mutant) {
-    if (target.size() != mutant.size()) {
+    RealVector trial(target.size());
+    binomialInto(target, mutant, trial, crossover_rate);
+    return trial;
+}
+
+void DifferentialEvolutionCrossover::binomialInto(ConstRealSpan target, ConstRealSpan mutant,
+                                                  RealSpan trial, double cr) {
+    if (target.size() != mutant.size() || target.size() != trial.size()) {
         throw std::invalid_argument("Target and mutant must have the same length");
     }
+    if (target.empty()) return;
     
     operation_count++;
     
-    RealVector trial = target;
+    const size_t n = target.size();
     std::uniform_real_distribution<double> dist(0.0, 1.0);
-    std::uniform_int_distribution<size_t> pos_dist(0, target.size() - 1);
+    std::uniform_int_distribution<size_t> pos_dist(0, n - 1);
     
     // Ensure at least one parameter comes from the mutant
     size_t forced_index = pos_dist(rng);
     
-    for (size_t i = 0; i < target.size(); ++i) {
-        if (dist(rng) < crossover_rate || i == forced_index) {
-            trial[i] = mutant[i];
-        }
-    }
+    // Draw first, then blend in a branch-free loop the compiler can vectorise
+    if (draws_.size() < n) draws_.resize(n);
+    for (size_t i = 0; i < n; ++i) draws_[i] = dist(rng);
+    draws_[forced_index] = -1.0;
     
-    return trial;
+    for (size_t i = 0; i < n; ++i) {
+        trial[i] = draws_[i] < cr ? mutant[i] : target[i];
+    }
 }
@@ -6,12 +6,26 @@
 class DifferentialEvolutionCrossover : public CrossoverOperator {
 private:
     double crossover_rate;
+    std::vector<double> draws_; ///< Per-gene uniforms of the last binomialInto call
     
 public:
     DifferentialEvolutionCrossover(double cr = 0.5, unsigned seed = std::random_device{}()) 
         : CrossoverOperator("DifferentialEvolutionCrossover", seed), crossover_rate(cr) {}
     
     RealVector performCrossover(const RealVector& target, const RealVector& mutant);
+
+    /**
+     * @brief Binomial crossover into caller-owned storage
+     *
+     * trial[i] takes mutant[i] with probability cr (and always at one random
+     * index), target[i] otherwise. trial may alias mutant, so an engine can
+     * build the mutant in a row of its trial matrix and cross it in place.
+     * @param cr Crossover rate for this call; adaptive DE variants draw one per individual
+     */
+    void binomialInto(ConstRealSpan target, ConstRealSpan mutant, RealSpan trial, double cr);
+
+    double getCrossoverRate() const { return crossover_rate; }
+    void setCrossoverRate(double cr) { crossover_rate = cr; }
 };
 
 #endif // DIFFERENTIAL_EVOLUTION_CROSSOVER_H
@@ -1,100 +1,360 @@
 #include "edge_crossover.h"
-#include <unordered_set>
+#include <algorithm>
+#include <numeric>
 #include <stdexcept>
-#include <climits>
 
 // ============================================================================
 // EDGE CROSSOVER IMPLEMENTATION
 // ============================================================================
 
-std::map<int, std::set<int>> EdgeCrossover::buildEdgeTable(const Permutation& parent1, const Permutation& parent2) {
-    std::map<int, std::set<int>> edge_table;
-    
-    // Add edges from parent1
-    for (size_t i = 0; i < parent1.size(); ++i) {
-        int current = parent1[i];
-        int prev = parent1[(i - 1 + parent1.size()) % parent1.size()];
-        int next = parent1[(i + 1) % parent1.size()];
-        
-        edge_table[current].insert(prev);
-        edge_table[current].insert(next);
+namespace {
+
+void linkTour(ConstIntSpan tour, std::vector<int>& links) {
+    const size_t n = tour.size();
+    links.resize(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+        links[2 * tour[i]] = tour[(i + n - 1) % n];
+        links[2 * tour[i] + 1] = tour[(i + 1) % n];
     }
-    
-    // Add edges from parent2
-    for (size_t i = 0; i < parent2.size(); ++i) {
-        int current = parent2[i];
-        int prev = parent2[(i - 1 + parent2.size()) % parent2.size()];
-        int next = parent2[(i + 1) % parent2.size()];
-        
-        edge_table[current].insert(prev);
-        edge_table[current].insert(next);
+}
+
+bool hasLink(const std::vector<int>& links, int from, int to) {
+    return links[2 * from] == to || links[2 * from + 1] == to;
+}
+
+void replaceLink(std::vector<int>& links, int city, int old_link, int new_link) {
+    links[2 * city + (links[2 * city] == old_link ? 0 : 1)] = new_link;
+}
+
+// Next city along a cycle of links, coming from prev
+int nextOnTour(const std::vector<int>& links, int city, int prev) {
+    return links[2 * city] != prev ? links[2 * city] : links[2 * city + 1];
+}
+
+// Clear the G_AB bit for the edge city -> to in one parent's link table
+void useEdge(std::vector<uint8_t>& left, const std::vector<int>& links, int city, int to) {
+    left[city] &= static_cast<uint8_t>(links[2 * city] == to ? ~1u : ~2u);
+}
+
+} // namespace
+
+void EdgeCrossover::buildEdgeTable(ConstIntSpan parent1, ConstIntSpan parent2) {
+    const size_t n = parent1.size();
+    neighbours_.resize(kMaxNeighbours * n);
+    degree_.assign(n, 0);
+    shared_.assign(n, 0);
+
+    auto add = [&](int city, int neighbour) {
+        int* list = &neighbours_[kMaxNeighbours * city];
+        for (int k = 0; k < degree_[city]; ++k) {
+            if (list[k] == neighbour) {
+                shared_[city] |= static_cast<uint8_t>(1u << k);
+                return;
+            }
+        }
+        list[degree_[city]++] = neighbour;
+    };
+
+    for (ConstIntSpan parent : {parent1, parent2}) {
+        for (size_t i = 0; i < n; ++i) {
+            int current = parent[i];
+            int next = parent[(i + 1) % n];
+            add(current, next);
+            add(next, current);
+        }
     }
-    
-    return edge_table;
 }
 
-Permutation EdgeCrossover::performCrossover(const Permutation& parent1, const Permutation& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
+void EdgeCrossover::removeNeighbour(int city, int neighbour) {
+    int* list = &neighbours_[kMaxNeighbours * city];
+    int last = --degree_[city];
+    for (int k = 0; k <= last; ++k) {
+        if (list[k] == neighbour) {
+            list[k] = list[last];
+            uint8_t bits = shared_[city];
+            bits = static_cast<uint8_t>((bits & ~(1u << k)) | (((bits >> last) & 1u) << k));
+            shared_[city] = static_cast<uint8_t>(bits & ~(1u << last));
+            return;
+        }
     }
-    
+    ++degree_[city];
+}
+
+void EdgeCrossover::performCrossoverInto(ConstIntSpan parent1, ConstIntSpan parent2, IntSpan child) {
     operation_count++;
-    
-    auto edge_table = buildEdgeTable(parent1, parent2);
-    Permutation child;
-    child.reserve(parent1.size());
-    
+
+    const size_t n = parent1.size();
+    if (n < 3) {
+        std::copy(parent1.begin(), parent1.end(), child.begin());
+        return;
+    }
+
+    validatePermutation(parent1, checked_);
+    validatePermutation(parent2, checked_);
+
+    if (variant_ == Variant::EAX) {
+        edgeAssemblyInto(parent1, parent2, child);
+        return;
+    }
+
+    buildEdgeTable(parent1, parent2);
+    unvisited_.resize(n);
+    slot_.resize(n);
+    std::iota(unvisited_.begin(), unvisited_.end(), 0);
+    std::iota(slot_.begin(), slot_.end(), 0);
+
     // Start with random city from parent1
-    std::uniform_int_distribution<size_t> dist(0, parent1.size() - 1);
+    std::uniform_int_distribution<size_t> dist(0, n - 1);
     int current = parent1[dist(rng)];
-    child.push_back(current);
-    
-    std::unordered_set<int> visited;
-    visited.insert(current);
-    
-    while (child.size() < parent1.size()) {
-        // Remove current city from all edge lists
-        for (auto& [city, edges] : edge_table) {
-            edges.erase(current);
+
+    for (size_t filled = 0;;) {
+        child[filled++] = current;
+
+        int moved = unvisited_.back();
+        unvisited_[slot_[current]] = moved;
+        slot_[moved] = slot_[current];
+        unvisited_.pop_back();
+
+        // Only the (at most four) neighbours can list the placed city
+        const int* list = &neighbours_[kMaxNeighbours * current];
+        for (int k = 0; k < degree_[current]; ++k) {
+            removeNeighbour(list[k], current);
+        }
+        if (filled == n) break;
+
+        // Next city: fewest remaining edges, ER4 restricting to shared edges
+        unsigned candidates = (1u << degree_[current]) - 1;
+        if (variant_ == Variant::ER4 && shared_[current] != 0) {
+            candidates = shared_[current];
         }
-        
-        // Find next city with minimum edge count
         int next_city = -1;
-        int min_edges = INT_MAX;
-        
-        for (int neighbor : edge_table[current]) {
-            if (visited.find(neighbor) == visited.end()) {
-                int edge_count = edge_table[neighbor].size();
-                if (edge_count < min_edges) {
-                    min_edges = edge_count;
-                    next_city = neighbor;
-                }
+        int min_edges = kMaxNeighbours + 1;
+        int ties = 0;
+        for (int k = 0; k < degree_[current]; ++k) {
+            if (!((candidates >> k) & 1u)) continue;
+            int edge_count = degree_[list[k]];
+            if (edge_count < min_edges) {
+                min_edges = edge_count;
+                next_city = list[k];
+                ties = 1;
+            } else if (edge_count == min_edges &&
+                       std::uniform_int_distribution<int>(0, ties++)(rng) == 0) {
+                next_city = list[k];
             }
         }
-        
+
         // If no connected city found, pick random unvisited
         if (next_city == -1) {
-            for (const auto& [city, edges] : edge_table) {
-                if (visited.find(city) == visited.end()) {
-                    next_city = city;
-                    break;
+            std::uniform_int_distribution<size_t> pick(0, unvisited_.size() - 1);
+            next_city = unvisited_[pick(rng)];
+        }
+        current = next_city;
+    }
+}
+
+// ============================================================================
+// EDGE ASSEMBLY CROSSOVER (EAX)
+// ============================================================================
+
+int EdgeCrossover::findABCycle(size_t length) {
+    // Random start among cities that still have edges in G_AB
+    std::uniform_int_distribution<size_t> dist(0, length - 1);
+    size_t first = dist(rng);
+    int start = -1;
+    for (size_t i = 0; i < length && start == -1; ++i) {
+        int city = static_cast<int>((first + i) % length);
+        if (a_left_[city] != 0) start = city;
+    }
+    if (start == -1) return -1;
+
+    // Walk alternating A and B edges until a city repeats at the same parity;
+    // the segment between the two visits is an AB-cycle
+    mark_.assign(2 * length, -1);
+    walk_.clear();
+    walk_.push_back(start);
+    mark_[2 * start] = 0;
+
+    std::uniform_int_distribution<int> coin(0, 1);
+    for (int step = 0;; ++step) {
+        int city = walk_.back();
+        bool a_edge = (step % 2) == 0;
+        std::vector<uint8_t>& left = a_edge ? a_left_ : b_left_;
+        std::vector<int>& links = a_edge ? a_links_ : b_links_;
+        if (left[city] == 0) return -1;
+
+        int side = left[city] == 3 ? coin(rng) : (left[city] == 1 ? 0 : 1);
+        int to = links[2 * city + side];
+        useEdge(left, links, city, to);
+        useEdge(left, links, to, city);
+
+        walk_.push_back(to);
+        int parity = (step + 1) % 2;
+        int& seen = mark_[2 * to + parity];
+        if (seen != -1) return seen;
+        seen = step + 1;
+    }
+}
+
+void EdgeCrossover::mergeSubtours(size_t length) {
+    const int n = static_cast<int>(length);
+    tour_id_.assign(length, -1);
+    tour_size_.clear();
+    tour_start_.clear();
+
+    for (int city = 0; city < n; ++city) {
+        if (tour_id_[city] != -1) continue;
+        int id = static_cast<int>(tour_size_.size());
+        int size = 0;
+        for (int prev = -1, cur = city; tour_id_[cur] == -1;) {
+            tour_id_[cur] = id;
+            ++size;
+            int next = nextOnTour(links_, cur, prev);
+            prev = cur;
+            cur = next;
+        }
+        tour_size_.push_back(size);
+        tour_start_.push_back(city);
+    }
+
+    auto parent_edge = [&](int x, int y) {
+        return (hasLink(a_links_, x, y) || hasLink(b_links_, x, y)) ? 1.0 : 0.0;
+    };
+
+    // Repeatedly join the smallest subtour to a neighbouring one with the
+    // cheapest 2-exchange: drop (u, u2) and (v, v2), add (u, v) and (u2, v2)
+    // or (u, v2) and (u2, v). Candidate v are parent neighbours of u, which
+    // always include a city outside the subtour because the parents are tours.
+    for (size_t remaining = tour_size_.size(); remaining > 1; --remaining) {
+        int small = -1;
+        for (size_t id = 0; id < tour_size_.size(); ++id) {
+            if (tour_size_[id] > 0 && (small == -1 || tour_size_[id] < tour_size_[small])) {
+                small = static_cast<int>(id);
+            }
+        }
+
+        double best = 0.0;
+        int best_u = -1, best_u2 = -1, best_v = -1, best_v2 = -1;
+        bool best_crossed = false;
+        int start = tour_start_[small];
+        for (int prev = -1, u = start, i = 0; i < tour_size_[small]; ++i) {
+            int u2 = nextOnTour(links_, u, prev);
+            const int candidates[4] = {a_links_[2 * u], a_links_[2 * u + 1],
+                                       b_links_[2 * u], b_links_[2 * u + 1]};
+            for (int v : candidates) {
+                if (tour_id_[v] == small) continue;
+                for (int side = 0; side < 2; ++side) {
+                    int v2 = links_[2 * v + side];
+                    for (int crossed = 0; crossed < 2; ++crossed) {
+                        int x = crossed ? v2 : v;
+                        int y = crossed ? v : v2;
+                        double delta;
+                        if (edge_cost_) {
+                            delta = edge_cost_(u, x) + edge_cost_(u2, y) - edge_cost_(u, u2) - edge_cost_(v, v2);
+                        } else {
+                            delta = -(parent_edge(u, x) + parent_edge(u2, y));
+                        }
+                        if (best_u == -1 || delta < best) {
+                            best = delta;
+                            best_u = u; best_u2 = u2; best_v = v; best_v2 = v2;
+                            best_crossed = crossed != 0;
+                        }
+                    }
                 }
             }
+            prev = u;
+            u = u2;
         }
-        
-        current = next_city;
-        child.push_back(current);
-        visited.insert(current);
+
+        // Relabel the small subtour before its links change
+        int target = tour_id_[best_v];
+        for (int prev = -1, cur = start, i = 0; i < tour_size_[small]; ++i) {
+            tour_id_[cur] = target;
+            int next = nextOnTour(links_, cur, prev);
+            prev = cur;
+            cur = next;
+        }
+        tour_size_[target] += tour_size_[small];
+        tour_size_[small] = 0;
+
+        int x = best_crossed ? best_v2 : best_v;
+        int y = best_crossed ? best_v : best_v2;
+        replaceLink(links_, best_u, best_u2, x);
+        replaceLink(links_, best_u2, best_u, y);
+        replaceLink(links_, best_v, best_v2, best_crossed ? best_u2 : best_u);
+        replaceLink(links_, best_v2, best_v, best_crossed ? best_u : best_u2);
     }
-    
+}
+
+void EdgeCrossover::edgeAssemblyInto(ConstIntSpan parent1, ConstIntSpan parent2, IntSpan child) {
+    const size_t n = parent1.size();
+    linkTour(parent1, a_links_);
+    linkTour(parent2, b_links_);
+    links_ = a_links_;
+
+    // G_AB holds the edges of each parent that the other parent lacks
+    a_left_.assign(n, 0);
+    b_left_.assign(n, 0);
+    for (size_t c = 0; c < n; ++c) {
+        int city = static_cast<int>(c);
+        for (int side = 0; side < 2; ++side) {
+            if (!hasLink(b_links_, city, a_links_[2 * c + side])) a_left_[c] |= static_cast<uint8_t>(1u << side);
+            if (!hasLink(a_links_, city, b_links_[2 * c + side])) b_left_[c] |= static_cast<uint8_t>(1u << side);
+        }
+    }
+
+    int begin = findABCycle(n);
+    if (begin != -1) {
+        // Swap the cycle's A edges for its B edges; every city keeps two links.
+        // Walk step i is an A edge when i is even, and the cycle may begin on
+        // a B edge
+        const int end = static_cast<int>(walk_.size()) - 1;
+        const int first_a = begin + (begin & 1);
+        const int first_b = begin + 1 - (begin & 1);
+        for (int i = first_a; i < end; i += 2) {
+            replaceLink(links_, walk_[i], walk_[i + 1], -1);
+            replaceLink(links_, walk_[i + 1], walk_[i], -1);
+        }
+        for (int i = first_b; i < end; i += 2) {
+            replaceLink(links_, walk_[i], -1, walk_[i + 1]);
+            replaceLink(links_, walk_[i + 1], -1, walk_[i]);
+        }
+        mergeSubtours(n);
+    }
+
+    int prev = -1;
+    int current = parent1[0];
+    for (size_t i = 0; i < n; ++i) {
+        child[i] = current;
+        int next = nextOnTour(links_, current, prev);
+        prev = current;
+        current = next;
+    }
+}
+
+Permutation EdgeCrossover::performCrossover(const Permutation& parent1, const Permutation& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
+    }
+
+    Permutation child(parent1.size());
+    performCrossoverInto(parent1, parent2, child);
     return child;
 }
 
-std::pair<IntVector, IntVector> EdgeCrossover::crossover(const IntVector& parent1, const IntVector& parent2) {
+void EdgeCrossover::crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                                  IntSpan child1, IntSpan child2) {
     // Edge recombination is permutation-based; treat IntVector as permutation
-    Permutation p1 = parent1;
-    Permutation p2 = parent2;
-    auto child1 = performCrossover(p1, p2);
-    auto child2 = performCrossover(p2, p1);
-    return { child1, child2 };
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    performCrossoverInto(parent1, parent2, child1);
+    performCrossoverInto(parent2, parent1, child2);
+}
+
+std::pair<IntVector, IntVector> EdgeCrossover::crossover(const IntVector& parent1, const IntVector& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
+    }
+
+    IntVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return { std::move(child1), std::move(child2) };
 }
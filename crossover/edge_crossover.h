@@ -2,19 +2,89 @@
 #define EDGE_CROSSOVER_H
 
 #include "base_crossover.h"
-#include <map>
-#include <set>
+#include "permutation_index.h"
+#include <cstdint>
+#include <functional>
 
+/**
+ * @brief Edge recombination crossover for permutations of 0..n-1
+ *
+ * Cities are treated as the vertices of a cyclic tour. The edge table is a
+ * flat array with at most four neighbours per city plus a degree counter, and
+ * unvisited cities sit in a swap-remove free list, so every step of the
+ * construction is O(1) and a child costs O(n). All scratch storage is kept
+ * between calls.
+ *
+ * Variants:
+ * - ER:  classic edge recombination, next city is the neighbour with the
+ *        fewest remaining edges (ties broken at random)
+ * - ER4: enhanced edge recombination, edges present in both parents are
+ *        taken first
+ * - EAX: edge assembly crossover, one AB-cycle of parent2 edges is swapped
+ *        into parent1 and the resulting subtours are merged with 2-exchanges
+ */
 class EdgeCrossover : public CrossoverOperator {
 public:
-    EdgeCrossover(unsigned seed = std::random_device{}()) 
-        : CrossoverOperator("EdgeCrossover", seed) {}
-    
+    enum class Variant { ER, ER4, EAX };
+
+    /// Cost of travelling between two cities, used by EAX to merge subtours
+    using EdgeCost = std::function<double(int, int)>;
+
+    EdgeCrossover(unsigned seed = std::random_device{}())
+        : CrossoverOperator("EdgeCrossover", seed), variant_(Variant::ER) {}
+
+    /**
+     * @brief Constructor
+     * @param variant Edge recombination variant
+     * @param seed Random seed for reproducible results
+     */
+    explicit EdgeCrossover(Variant variant, unsigned seed = std::random_device{}())
+        : CrossoverOperator("EdgeCrossover", seed), variant_(variant) {}
+
+    void setVariant(Variant variant) { variant_ = variant; }
+    Variant getVariant() const { return variant_; }
+
+    /**
+     * @brief Set the edge cost used when EAX reconnects subtours
+     * @param cost Symmetric city-to-city cost; an empty function makes EAX
+     *             prefer reconnecting through edges found in either parent
+     */
+    void setEdgeCost(EdgeCost cost) { edge_cost_ = std::move(cost); }
+
     Permutation performCrossover(const Permutation& parent1, const Permutation& parent2);
     std::pair<IntVector, IntVector> crossover(const IntVector& parent1, const IntVector& parent2) override;
-    
+    void crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                       IntSpan child1, IntSpan child2) override;
+    using CrossoverOperator::crossoverInto;
+
 private:
-    std::map<int, std::set<int>> buildEdgeTable(const Permutation& parent1, const Permutation& parent2);
+    static constexpr int kMaxNeighbours = 4;
+
+    Variant variant_;
+    EdgeCost edge_cost_;
+
+    // Edge table: neighbours_[kMaxNeighbours * city + k] for k < degree_[city]
+    std::vector<int> neighbours_;
+    std::vector<uint8_t> degree_;
+    std::vector<uint8_t> shared_;   ///< Bit k set when neighbour k is in both parents
+    std::vector<int> unvisited_;    ///< Free list of cities not yet placed
+    std::vector<int> slot_;         ///< Position of each city in unvisited_
+    ValueBitmap checked_;
+
+    // EAX scratch: two tour links per city and alternating-walk bookkeeping
+    std::vector<int> links_;        ///< links_[2 * city + side]
+    std::vector<int> a_links_, b_links_;
+    std::vector<uint8_t> a_left_, b_left_;
+    std::vector<int> walk_;
+    std::vector<int> mark_;         ///< mark_[2 * city + parity] = walk index
+    std::vector<int> tour_id_, tour_size_, tour_start_;
+
+    void buildEdgeTable(ConstIntSpan parent1, ConstIntSpan parent2);
+    void removeNeighbour(int city, int neighbour);
+    void performCrossoverInto(ConstIntSpan parent1, ConstIntSpan parent2, IntSpan child);
+    void edgeAssemblyInto(ConstIntSpan parent1, ConstIntSpan parent2, IntSpan child);
+    int findABCycle(size_t length);
+    void mergeSubtours(size_t length);
 };
 
 #endif // EDGE_CROSSOVER_H
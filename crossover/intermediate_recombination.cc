@@ -5,23 +5,41 @@
 // INTERMEDIATE RECOMBINATION IMPLEMENTATION
 // ============================================================================
 
-std::pair<RealVector, RealVector> IntermediateRecombination::crossover(const RealVector& parent1, const RealVector& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
+void IntermediateRecombination::recombine(const double* parent1, const double* parent2,
+                                          double* __restrict child1, double* __restrict child2, size_t n) const {
+    for (size_t i = 0; i < n; ++i) {
+        child1[i] = alpha * parent1[i] + (1.0 - alpha) * parent2[i];
+        child2[i] = alpha * parent2[i] + (1.0 - alpha) * parent1[i];
     }
+}
+
+void IntermediateRecombination::crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                                              RealSpan child1, RealSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
     
     operation_count++;
     
-    RealVector child1, child2;
-    child1.reserve(parent1.size());
-    child2.reserve(parent1.size());
+    recombine(parent1.data(), parent2.data(), child1.data(), child2.data(), parent1.size());
+}
+
+void IntermediateRecombination::crossoverBatch(const double* population, size_t dimension, const size_t* parents,
+                                               size_t pairs, double* offspring) {
+    operation_count += pairs;
     
-    for (size_t i = 0; i < parent1.size(); ++i) {
-        child1.push_back(alpha * parent1[i] + (1.0 - alpha) * parent2[i]);
-        child2.push_back(alpha * parent2[i] + (1.0 - alpha) * parent1[i]);
+    for (size_t t = 0; t < pairs; ++t) {
+        recombine(population + parents[2 * t] * dimension, population + parents[2 * t + 1] * dimension,
+                  offspring + 2 * t * dimension, offspring + (2 * t + 1) * dimension, dimension);
+    }
+}
+
+std::pair<RealVector, RealVector> IntermediateRecombination::crossover(const RealVector& parent1, const RealVector& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
     }
     
-    return {child1, child2};
+    RealVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
 
 RealVector IntermediateRecombination::singleArithmeticRecombination(const RealVector& parent1, const RealVector& parent2) {
@@ -12,8 +12,17 @@ public:
         : CrossoverOperator("IntermediateRecombination", seed), alpha(a) {}
     
     std::pair<RealVector, RealVector> crossover(const RealVector& parent1, const RealVector& parent2);
+    void crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                       RealSpan child1, RealSpan child2) override;
+    using CrossoverOperator::crossoverInto;
+    void crossoverBatch(const double* population, size_t dimension, const size_t* parents,
+                        size_t pairs, double* offspring) override;
     RealVector singleArithmeticRecombination(const RealVector& parent1, const RealVector& parent2);
     RealVector wholeArithmeticRecombination(const RealVector& parent1, const RealVector& parent2);
+
+private:
+    void recombine(const double* parent1, const double* parent2,
+                   double* __restrict child1, double* __restrict child2, size_t n) const;
 };
 
 #endif // INTERMEDIATE_RECOMBINATION_H
@@ -1,30 +1,60 @@
 #include "line_recombination.h"
+#include "common/recombination_kernels.h"
 #include <stdexcept>
 
 // ============================================================================
 // LINE RECOMBINATION IMPLEMENTATION
 // ============================================================================
 
-std::pair<RealVector, RealVector> LineRecombination::crossover(const RealVector& parent1, const RealVector& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
+void LineRecombination::recombine(const double* parent1, const double* parent2, const double* u,
+                                  double* __restrict child1, double* __restrict child2, size_t n) const {
+    // alpha uniform over [-p, 1 + p]
+    const double width = 1.0 + 2.0 * extension_factor;
+    for (size_t i = 0; i < n; ++i) {
+        const double alpha1 = u[i] * width - extension_factor;
+        const double alpha2 = u[n + i] * width - extension_factor;
+        
+        child1[i] = alpha1 * parent1[i] + (1.0 - alpha1) * parent2[i];
+        child2[i] = alpha2 * parent1[i] + (1.0 - alpha2) * parent2[i];
     }
+}
+
+void LineRecombination::crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                                      RealSpan child1, RealSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
     
     operation_count++;
     
-    std::uniform_real_distribution<double> dist(-extension_factor, 1.0 + extension_factor);
-    
-    RealVector child1, child2;
-    child1.reserve(parent1.size());
-    child2.reserve(parent1.size());
+    const size_t n = parent1.size();
+    uint32_t key1, key2;
+    batchKeys(key1, key2);
+    batch_uniforms_.resize(2 * n);
+    recombination_kernels::fillUniform(batch_uniforms_.data(), 2 * n, 0, key1, key2);
+    recombine(parent1.data(), parent2.data(), batch_uniforms_.data(), child1.data(), child2.data(), n);
+}
+
+void LineRecombination::crossoverBatch(const double* population, size_t dimension, const size_t* parents,
+                                       size_t pairs, double* offspring) {
+    operation_count += pairs;
     
-    for (size_t i = 0; i < parent1.size(); ++i) {
-        double alpha1 = dist(rng);
-        double alpha2 = dist(rng);
-        
-        child1.push_back(alpha1 * parent1[i] + (1.0 - alpha1) * parent2[i]);
-        child2.push_back(alpha2 * parent1[i] + (1.0 - alpha2) * parent2[i]);
+    uint32_t key1, key2;
+    batchKeys(key1, key2);
+    batch_uniforms_.resize(2 * dimension);
+    for (size_t t = 0; t < pairs; ++t) {
+        recombination_kernels::fillUniform(batch_uniforms_.data(), 2 * dimension,
+                                           static_cast<uint32_t>(2 * t * dimension), key1, key2);
+        recombine(population + parents[2 * t] * dimension, population + parents[2 * t + 1] * dimension,
+                  batch_uniforms_.data(), offspring + 2 * t * dimension, offspring + (2 * t + 1) * dimension,
+                  dimension);
+    }
+}
+
+std::pair<RealVector, RealVector> LineRecombination::crossover(const RealVector& parent1, const RealVector& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
     }
     
-    return {child1, child2};
+    RealVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
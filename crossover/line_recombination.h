@@ -12,6 +12,16 @@ public:
         : CrossoverOperator("LineRecombination", seed), extension_factor(p) {}
     
     std::pair<RealVector, RealVector> crossover(const RealVector& parent1, const RealVector& parent2);
+    void crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                       RealSpan child1, RealSpan child2) override;
+    using CrossoverOperator::crossoverInto;
+    void crossoverBatch(const double* population, size_t dimension, const size_t* parents,
+                        size_t pairs, double* offspring) override;
+
+private:
+    // One pair given 2n uniforms, u[i] for child1 and u[n + i] for child2
+    void recombine(const double* parent1, const double* parent2, const double* u,
+                   double* __restrict child1, double* __restrict child2, size_t n) const;
 };
 
 #endif // LINE_RECOMBINATION_H
@@ -0,0 +1,112 @@
+#include "linear_tree.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+size_t countNodes(const TreeNode* tree) {
+    if (!tree) {
+        throw std::invalid_argument("Tree nodes cannot be null");
+    }
+    size_t count = 1;
+    for (const auto* child : tree->children) {
+        count += countNodes(child);
+    }
+    return count;
+}
+
+uint32_t linearise(const TreeNode* tree, OpcodeTable& opcodes, LinearNode* out) {
+    uint32_t size = 1;
+    for (const auto* child : tree->children) {
+        size += linearise(child, opcodes, out + size);
+    }
+    out[0] = {opcodes.intern(tree->value), size, static_cast<uint32_t>(tree->children.size())};
+    return size;
+}
+
+TreeNode* rebuild(const LinearTree& tree, size_t index, const OpcodeTable& opcodes) {
+    TreeNode* node = new TreeNode(opcodes.symbol(tree[index].opcode));
+    size_t child = index + 1;
+    for (uint32_t k = 0; k < tree[index].arity; ++k) {
+        node->children.push_back(rebuild(tree, child, opcodes));
+        child = tree.subtreeEnd(child);
+    }
+    return node;
+}
+
+} // namespace
+
+// ============================================================================
+// OPCODE TABLE IMPLEMENTATION
+// ============================================================================
+
+Opcode OpcodeTable::intern(const std::string& symbol) {
+    auto it = ids_.find(symbol);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    Opcode opcode = static_cast<Opcode>(symbols_.size());
+    symbols_.push_back(symbol);
+    ids_.emplace(symbol, opcode);
+    return opcode;
+}
+
+// ============================================================================
+// TREE ARENA IMPLEMENTATION
+// ============================================================================
+
+LinearNode* TreeArena::allocate(size_t count) {
+    while (current_ < blocks_.size()) {
+        if (used_ + count <= capacities_[current_]) {
+            LinearNode* nodes = blocks_[current_].get() + used_;
+            used_ += count;
+            return nodes;
+        }
+        ++current_;
+        used_ = 0;
+    }
+    size_t capacity = std::max(block_size_, count);
+    blocks_.emplace_back(new LinearNode[capacity]);
+    capacities_.push_back(capacity);
+    current_ = blocks_.size() - 1;
+    used_ = count;
+    return blocks_.back().get();
+}
+
+// ============================================================================
+// LINEAR TREE IMPLEMENTATION
+// ============================================================================
+
+size_t LinearTree::depth() const {
+    // Ends of the subtrees enclosing the current node
+    std::vector<size_t> open;
+    size_t deepest = 0;
+    for (size_t i = 0; i < length_; ++i) {
+        while (!open.empty() && open.back() <= i) {
+            open.pop_back();
+        }
+        open.push_back(subtreeEnd(i));
+        deepest = std::max(deepest, open.size());
+    }
+    return deepest;
+}
+
+LinearTree LinearTree::copyTo(TreeArena& arena) const {
+    LinearNode* nodes = arena.allocate(length_);
+    std::copy(nodes_, nodes_ + length_, nodes);
+    return LinearTree(nodes, length_);
+}
+
+LinearTree LinearTree::fromTree(const TreeNode* tree, OpcodeTable& opcodes, TreeArena& arena) {
+    size_t count = countNodes(tree);
+    LinearNode* nodes = arena.allocate(count);
+    linearise(tree, opcodes, nodes);
+    return LinearTree(nodes, static_cast<uint32_t>(count));
+}
+
+TreeNode* LinearTree::toTree(const OpcodeTable& opcodes) const {
+    if (empty()) {
+        return nullptr;
+    }
+    return rebuild(*this, 0, opcodes);
+}
@@ -0,0 +1,149 @@
+#ifndef LINEAR_TREE_H
+#define LINEAR_TREE_H
+
+#include "base_crossover.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+using Opcode = uint32_t;
+
+/**
+ * @brief Interns GP node symbols as dense integer opcodes
+ *
+ * Every distinct TreeNode::value gets one opcode, so linear trees compare and
+ * copy plain integers instead of strings.
+ */
+class OpcodeTable {
+private:
+    std::vector<std::string> symbols_;
+    std::unordered_map<std::string, Opcode> ids_;
+
+public:
+    /**
+     * @brief Opcode for a symbol, assigning a new one on first use
+     * @param symbol Node symbol, e.g. "+", "x0" or "3.5"
+     * @return Interned opcode
+     */
+    Opcode intern(const std::string& symbol);
+
+    /**
+     * @brief Symbol of an interned opcode
+     * @param opcode Opcode returned by intern()
+     * @return Symbol string
+     */
+    const std::string& symbol(Opcode opcode) const { return symbols_.at(opcode); }
+
+    size_t size() const { return symbols_.size(); }
+};
+
+/**
+ * @brief One node of a linear tree
+ *
+ * Nodes are stored in prefix order, so the subtree rooted at index i occupies
+ * [i, i + size) and its first child, if any, sits at i + 1.
+ */
+struct LinearNode {
+    Opcode opcode;
+    uint32_t size;   ///< Number of nodes in the subtree rooted here
+    uint32_t arity;  ///< Number of children
+};
+
+/**
+ * @brief Bump allocator for linear tree nodes
+ *
+ * Trees of one generation are allocated from one arena and released together
+ * by reset(), which keeps the blocks for the next generation. A GA typically
+ * holds two arenas, one for the current population and one for offspring,
+ * and swaps them every generation.
+ */
+class TreeArena {
+private:
+    std::vector<std::unique_ptr<LinearNode[]>> blocks_;
+    std::vector<size_t> capacities_;
+    size_t block_size_;
+    size_t current_ = 0;  ///< Block being filled
+    size_t used_ = 0;     ///< Nodes used in the current block
+
+public:
+    /**
+     * @brief Constructor
+     * @param block_size Nodes per block; larger requests get their own block
+     */
+    explicit TreeArena(size_t block_size = 1 << 16) : block_size_(block_size) {}
+
+    TreeArena(const TreeArena&) = delete;
+    TreeArena& operator=(const TreeArena&) = delete;
+
+    /**
+     * @brief Allocate uninitialised storage for count nodes
+     * @param count Number of nodes
+     * @return Pointer valid until the next reset()
+     */
+    LinearNode* allocate(size_t count);
+
+    /**
+     * @brief Release every tree allocated from this arena
+     *
+     * Blocks are kept, so refilling the arena with a generation of similar
+     * size does not touch the heap.
+     */
+    void reset() { current_ = 0; used_ = 0; }
+};
+
+/**
+ * @brief GP genome as a prefix-order array of interned opcodes
+ *
+ * A non-owning view of nodes living in a TreeArena; copying a LinearTree
+ * copies the view, not the nodes. Subtree boundaries come from the stored
+ * sizes, so picking a crossover point is O(1).
+ */
+class LinearTree {
+private:
+    const LinearNode* nodes_ = nullptr;
+    uint32_t length_ = 0;
+
+public:
+    LinearTree() = default;
+    LinearTree(const LinearNode* nodes, uint32_t length) : nodes_(nodes), length_(length) {}
+
+    size_t size() const { return length_; }
+    bool empty() const { return length_ == 0; }
+    const LinearNode& operator[](size_t index) const { return nodes_[index]; }
+    const LinearNode* data() const { return nodes_; }
+
+    /**
+     * @brief One past the last node of the subtree rooted at index
+     */
+    size_t subtreeEnd(size_t index) const { return index + nodes_[index].size; }
+
+    /**
+     * @brief Depth of the tree (a single leaf has depth 1)
+     */
+    size_t depth() const;
+
+    /**
+     * @brief Copy the nodes into another arena, e.g. to carry an elite over
+     * @param arena Destination arena
+     * @return View of the copy
+     */
+    LinearTree copyTo(TreeArena& arena) const;
+
+    /**
+     * @brief Linearise a pointer tree
+     * @param tree Root node, must not be null
+     * @param opcodes Table used to intern node symbols
+     * @param arena Arena the nodes are allocated from
+     * @return Linear tree with the same structure and symbols
+     */
+    static LinearTree fromTree(const TreeNode* tree, OpcodeTable& opcodes, TreeArena& arena);
+
+    /**
+     * @brief Rebuild a heap-allocated pointer tree
+     * @param opcodes Table the tree was interned with
+     * @return New tree owned by the caller
+     */
+    TreeNode* toTree(const OpcodeTable& opcodes) const;
+};
+
+#endif // LINEAR_TREE_H
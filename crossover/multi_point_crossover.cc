@@ -1,57 +1,75 @@
 #include "multi_point_crossover.h"
 #include <stdexcept>
 #include <algorithm>
-#include <set>
 
 // ============================================================================
 // MULTI-POINT CROSSOVER IMPLEMENTATION
 // ============================================================================
 
-std::pair<BitString, BitString> MultiPointCrossover::crossover(const BitString& parent1, const BitString& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
-    }
-    
-    operation_count++;
-    
+namespace {
+
+// Shared kernel for every representation: children start as copies of their
+// parents and exchange alternating segments delimited by the sorted points.
+template <typename Parent, typename Child>
+void multiPointInto(const std::vector<size_t>& points, const Parent& parent1, const Parent& parent2,
+                    Child& child1, Child& child2) {
     size_t length = parent1.size();
-    if (length <= 1 || num_points >= static_cast<int>(length)) {
-        return {parent1, parent2};
-    }
-    
-    // Generate crossover points
-    std::vector<size_t> points = generateCrossoverPoints(length);
     
-    // Create offspring
-    BitString child1 = parent1;
-    BitString child2 = parent2;
-    
-    // Exchange segments alternately
-    bool exchange = true;
-    for (size_t i = 0; i < points.size(); ++i) {
-        size_t start = (i == 0) ? 0 : points[i-1];
-        size_t end = points[i];
+    // No points means the parents pass through unchanged
+    bool exchange = !points.empty();
+    size_t start = 0;
+    for (size_t i = 0; i <= points.size(); ++i) {
+        size_t end = (i < points.size()) ? points[i] : length;
         
-        if (exchange) {
-            for (size_t j = start; j < end; ++j) {
-                bool temp = child1[j];
-                child1[j] = child2[j];
-                child2[j] = temp;
+        for (size_t j = start; j < end; ++j) {
+            if (exchange) {
+                child1[j] = parent2[j];
+                child2[j] = parent1[j];
+            } else {
+                child1[j] = parent1[j];
+                child2[j] = parent2[j];
             }
         }
+        
         exchange = !exchange;
+        start = end;
     }
-    
-    // Handle the last segment
-    if (exchange && !points.empty()) {
-        for (size_t j = points.back(); j < length; ++j) {
-            bool temp = child1[j];
-            child1[j] = child2[j];
-            child2[j] = temp;
-        }
+}
+
+} // namespace
+
+void MultiPointCrossover::crossoverInto(const BitString& parent1, const BitString& parent2,
+                                        BitString& child1, BitString& child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    generateCrossoverPoints(parent1.size());
+    multiPointInto(points_, parent1, parent2, child1, child2);
+}
+
+void MultiPointCrossover::crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                                        RealSpan child1, RealSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    generateCrossoverPoints(parent1.size());
+    multiPointInto(points_, parent1, parent2, child1, child2);
+}
+
+void MultiPointCrossover::crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                                        IntSpan child1, IntSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    generateCrossoverPoints(parent1.size());
+    multiPointInto(points_, parent1, parent2, child1, child2);
+}
+
+std::pair<BitString, BitString> MultiPointCrossover::crossover(const BitString& parent1, const BitString& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
     }
     
-    return {child1, child2};
+    BitString child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
 
 std::pair<RealVector, RealVector> MultiPointCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
@@ -59,42 +77,9 @@ std::pair<RealVector, RealVector> MultiPointCrossover::crossover(const RealVecto
         throw std::invalid_argument("Parents must have the same length");
     }
     
-    operation_count++;
-    
-    size_t length = parent1.size();
-    if (length <= 1 || num_points >= static_cast<int>(length)) {
-        return {parent1, parent2};
-    }
-    
-    // Generate crossover points
-    std::vector<size_t> points = generateCrossoverPoints(length);
-    
-    // Create offspring
-    RealVector child1 = parent1;
-    RealVector child2 = parent2;
-    
-    // Exchange segments alternately
-    bool exchange = true;
-    for (size_t i = 0; i < points.size(); ++i) {
-        size_t start = (i == 0) ? 0 : points[i-1];
-        size_t end = points[i];
-        
-        if (exchange) {
-            for (size_t j = start; j < end; ++j) {
-                std::swap(child1[j], child2[j]);
-            }
-        }
-        exchange = !exchange;
-    }
-    
-    // Handle the last segment
-    if (exchange && !points.empty()) {
-        for (size_t j = points.back(); j < length; ++j) {
-            std::swap(child1[j], child2[j]);
-        }
-    }
-    
-    return {child1, child2};
+    RealVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
 
 std::pair<IntVector, IntVector> MultiPointCrossover::crossover(const IntVector& parent1, const IntVector& parent2) {
@@ -102,54 +87,28 @@ std::pair<IntVector, IntVector> MultiPointCrossover::crossover(const IntVector&
         throw std::invalid_argument("Parents must have the same length");
     }
     
-    operation_count++;
+    IntVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
+}
+
+void MultiPointCrossover::generateCrossoverPoints(size_t length) {
+    points_.clear();
     
-    size_t length = parent1.size();
+    // Too few genes for the requested points: children are plain copies
     if (length <= 1 || num_points >= static_cast<int>(length)) {
-        return {parent1, parent2};
-    }
-    
-    // Generate crossover points
-    std::vector<size_t> points = generateCrossoverPoints(length);
-    
-    // Create offspring
-    IntVector child1 = parent1;
-    IntVector child2 = parent2;
-    
-    // Exchange segments alternately
-    bool exchange = true;
-    for (size_t i = 0; i < points.size(); ++i) {
-        size_t start = (i == 0) ? 0 : points[i-1];
-        size_t end = points[i];
-        
-        if (exchange) {
-            for (size_t j = start; j < end; ++j) {
-                std::swap(child1[j], child2[j]);
-            }
-        }
-        exchange = !exchange;
-    }
-    
-    // Handle the last segment
-    if (exchange && !points.empty()) {
-        for (size_t j = points.back(); j < length; ++j) {
-            std::swap(child1[j], child2[j]);
-        }
+        return;
     }
     
-    return {child1, child2};
-}
-
-std::vector<size_t> MultiPointCrossover::generateCrossoverPoints(size_t length) {
-    std::set<size_t> point_set;
+    // Draw unique points into the reused buffer; num_points is small, so a
+    // linear duplicate check beats building a set
     std::uniform_int_distribution<size_t> dist(1, length - 1);
-    
-    // Generate unique crossover points
-    while (static_cast<int>(point_set.size()) < num_points && point_set.size() < length - 1) {
-        point_set.insert(dist(rng));
+    while (static_cast<int>(points_.size()) < num_points) {
+        size_t point = dist(rng);
+        if (std::find(points_.begin(), points_.end(), point) == points_.end()) {
+            points_.push_back(point);
+        }
     }
     
-    // Convert to sorted vector
-    std::vector<size_t> points(point_set.begin(), point_set.end());
-    return points;
+    std::sort(points_.begin(), points_.end());
 }
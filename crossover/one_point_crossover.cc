@@ -1,66 +1,80 @@
 #include "one_point_crossover.h"
 #include <stdexcept>
+#include <algorithm>
 
 // ============================================================================
 // ONE-POINT CROSSOVER IMPLEMENTATION
 // ============================================================================
 
-std::pair<BitString, BitString> OnePointCrossover::crossover(const BitString& parent1, const BitString& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
-    }
-    
-    operation_count++;
-    
+namespace {
+
+// Shared kernel for every representation: children start as copies of their
+// parents and exchange genetic material after a single random cut point.
+template <typename Parent, typename Child>
+void onePointInto(std::mt19937& rng, const Parent& parent1, const Parent& parent2,
+                  Child& child1, Child& child2) {
     size_t length = parent1.size();
-    if (length <= 1) {
-        return {parent1, parent2};
-    }
     
-    // Select random crossover point (1 to length-1)
-    std::uniform_int_distribution<size_t> dist(1, length - 1);
-    size_t crossover_point = dist(rng);
+    // Select random crossover point (1 to length-1); short parents pass through
+    size_t crossover_point = length;
+    if (length > 1) {
+        std::uniform_int_distribution<size_t> dist(1, length - 1);
+        crossover_point = dist(rng);
+    }
     
-    // Create offspring
-    BitString child1 = parent1;
-    BitString child2 = parent2;
+    for (size_t i = 0; i < crossover_point; ++i) {
+        child1[i] = parent1[i];
+        child2[i] = parent2[i];
+    }
     
     // Exchange genetic material after crossover point
     for (size_t i = crossover_point; i < length; ++i) {
         child1[i] = parent2[i];
         child2[i] = parent1[i];
     }
-    
-    return {child1, child2};
 }
 
-std::pair<RealVector, RealVector> OnePointCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
+} // namespace
+
+void OnePointCrossover::crossoverInto(const BitString& parent1, const BitString& parent2,
+                                      BitString& child1, BitString& child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    onePointInto(rng, parent1, parent2, child1, child2);
+}
+
+void OnePointCrossover::crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                                      RealSpan child1, RealSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    onePointInto(rng, parent1, parent2, child1, child2);
+}
+
+void OnePointCrossover::crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                                      IntSpan child1, IntSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    onePointInto(rng, parent1, parent2, child1, child2);
+}
+
+std::pair<BitString, BitString> OnePointCrossover::crossover(const BitString& parent1, const BitString& parent2) {
     if (parent1.size() != parent2.size()) {
         throw std::invalid_argument("Parents must have the same length");
     }
     
-    operation_count++;
-    
-    size_t length = parent1.size();
-    if (length <= 1) {
-        return {parent1, parent2};
-    }
-    
-    // Select random crossover point (1 to length-1)
-    std::uniform_int_distribution<size_t> dist(1, length - 1);
-    size_t crossover_point = dist(rng);
-    
-    // Create offspring
-    RealVector child1 = parent1;
-    RealVector child2 = parent2;
-    
-    // Exchange genetic material after crossover point
-    for (size_t i = crossover_point; i < length; ++i) {
-        child1[i] = parent2[i];
-        child2[i] = parent1[i];
+    BitString child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
+}
+
+std::pair<RealVector, RealVector> OnePointCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
     }
     
-    return {child1, child2};
+    RealVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
 
 std::pair<IntVector, IntVector> OnePointCrossover::crossover(const IntVector& parent1, const IntVector& parent2) {
@@ -68,26 +82,7 @@ std::pair<IntVector, IntVector> OnePointCrossover::crossover(const IntVector& pa
         throw std::invalid_argument("Parents must have the same length");
     }
     
-    operation_count++;
-    
-    size_t length = parent1.size();
-    if (length <= 1) {
-        return {parent1, parent2};
-    }
-    
-    // Select random crossover point (1 to length-1)
-    std::uniform_int_distribution<size_t> dist(1, length - 1);
-    size_t crossover_point = dist(rng);
-    
-    // Create offspring
-    IntVector child1 = parent1;
-    IntVector child2 = parent2;
-    
-    // Exchange genetic material after crossover point
-    for (size_t i = crossover_point; i < length; ++i) {
-        child1[i] = parent2[i];
-        child2[i] = parent1[i];
-    }
-    
-    return {child1, child2};
+    IntVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
@@ -1,35 +1,45 @@
 #include "order_crossover.h"
 #include <stdexcept>
 #include <algorithm>
-#include <unordered_set>
 
 // ============================================================================
 // ORDER CROSSOVER (OX) IMPLEMENTATION
 // ============================================================================
 
-std::pair<Permutation, Permutation> OrderCrossover::crossover(const Permutation& parent1, const Permutation& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
-    }
+void OrderCrossover::crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                                   IntSpan child1, IntSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
     
     if (parent1.empty()) {
-        return {parent1, parent2};
+        return;
     }
     
     operation_count++;
     
+    validatePermutation(parent1, copied_);
+    validatePermutation(parent2, copied_);
+    
     // Create both offspring
-    Permutation child1 = createOffspring(parent1, parent2);
-    Permutation child2 = createOffspring(parent2, parent1);
+    createOffspring(parent1, parent2, child1);
+    createOffspring(parent2, parent1, child2);
+}
+
+std::pair<Permutation, Permutation> OrderCrossover::crossover(const Permutation& parent1, const Permutation& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
+    }
     
-    return {child1, child2};
+    Permutation child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
 
-Permutation OrderCrossover::createOffspring(const Permutation& p1, const Permutation& p2) {
+void OrderCrossover::createOffspring(ConstIntSpan p1, ConstIntSpan p2, IntSpan offspring) {
     size_t length = p1.size();
     
     if (length <= 2) {
-        return p1; // No meaningful crossover for very short permutations
+        std::copy(p1.begin(), p1.end(), offspring.begin()); // No meaningful crossover for very short permutations
+        return;
     }
     
     // Select two random cut points
@@ -42,14 +52,11 @@ Permutation OrderCrossover::createOffspring(const Permutation& p1, const Permuta
         std::swap(cut1, cut2);
     }
     
-    // Initialize offspring with -1 (indicating empty positions)
-    Permutation offspring(length, -1);
-    
-    // Copy the segment between cut points from parent1
-    std::unordered_set<int> copied_elements;
+    // Copy the segment between cut points from parent1, marking its values
+    copied_.reset(length);
     for (size_t i = cut1; i <= cut2; ++i) {
         offspring[i] = p1[i];
-        copied_elements.insert(p1[i]);
+        copied_.set(p1[i]);
     }
     
     // Fill remaining positions with elements from parent2 in order
@@ -66,11 +73,9 @@ Permutation OrderCrossover::createOffspring(const Permutation& p1, const Permuta
         }
         
         // If element from p2 is not already copied, add it
-        if (copied_elements.find(p2[i]) == copied_elements.end()) {
+        if (!copied_.test(p2[i])) {
             offspring[offspring_pos] = p2[i];
             offspring_pos++;
         }
     }
-    
-    return offspring;
 }
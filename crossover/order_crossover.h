@@ -2,6 +2,7 @@
 #define ORDER_CROSSOVER_H
 
 #include "base_crossover.h"
+#include "permutation_index.h"
 
 /**
  * @brief Order Crossover (OX) Operator
@@ -10,8 +11,14 @@
  * designed for permutation representations. It preserves the relative
  * order of elements from one parent while filling in elements from
  * the other parent.
+ * 
+ * Parents must be permutations of 0..n-1. Membership of the copied segment
+ * is tracked in a reusable bitmap, so each offspring is built in O(n).
  */
 class OrderCrossover : public CrossoverOperator {
+private:
+    ValueBitmap copied_; ///< Values already placed in the offspring
+    
 public:
     /**
      * @brief Constructor
@@ -28,6 +35,17 @@ public:
      */
     std::pair<IntVector, IntVector> crossover(const IntVector& parent1, const IntVector& parent2) override;
     
+    /**
+     * @brief Perform order crossover into pre-sized offspring buffers
+     * @param parent1 First parent permutation
+     * @param parent2 Second parent permutation
+     * @param child1 First offspring buffer, sized like the parents
+     * @param child2 Second offspring buffer, sized like the parents
+     */
+    void crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                       IntSpan child1, IntSpan child2) override;
+    using CrossoverOperator::crossoverInto;
+    
     // Order crossover is specifically for permutations
     std::pair<BitString, BitString> crossover(const BitString& /* parent1 */, const BitString& /* parent2 */) override {
         throw std::runtime_error("Order crossover is only applicable to permutations");
@@ -42,9 +60,9 @@ private:
      * @brief Create one offspring using order crossover
      * @param p1 First parent
      * @param p2 Second parent
-     * @return Single offspring
+     * @param offspring Output buffer, sized like the parents
      */
-    IntVector createOffspring(const IntVector& p1, const IntVector& p2);
+    void createOffspring(ConstIntSpan p1, ConstIntSpan p2, IntSpan offspring);
 };
 
 #endif // ORDER_CROSSOVER_H
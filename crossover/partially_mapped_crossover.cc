@@ -1,20 +1,26 @@
 #include "partially_mapped_crossover.h"
-#include <map>
+#include <algorithm>
 #include <stdexcept>
 
 // ============================================================================
 // PARTIALLY MAPPED CROSSOVER (PMX) IMPLEMENTATION
 // ============================================================================
 
-std::pair<Permutation, Permutation> PartiallyMappedCrossover::crossover(const Permutation& parent1, const Permutation& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
-    }
+void PartiallyMappedCrossover::crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                                             IntSpan child1, IntSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
     
     operation_count++;
     
     size_t length = parent1.size();
-    if (length <= 2) return {parent1, parent2};
+    if (length <= 2) {
+        std::copy(parent1.begin(), parent1.end(), child1.begin());
+        std::copy(parent2.begin(), parent2.end(), child2.begin());
+        return;
+    }
+    
+    position1_.build(parent1);
+    position2_.build(parent2);
     
     // Select two random crossover points
     std::uniform_int_distribution<size_t> dist(0, length - 1);
@@ -23,36 +29,43 @@ std::pair<Permutation, Permutation> PartiallyMappedCrossover::crossover(const Pe
     
     if (point1 > point2) std::swap(point1, point2);
     
-    Permutation child1(length, -1);
-    Permutation child2(length, -1);
+    auto in_segment = [&](int pos) {
+        return static_cast<size_t>(pos) >= point1 && static_cast<size_t>(pos) <= point2;
+    };
     
-    // Copy mapping sections and build mappings
-    std::map<int, int> mapping1, mapping2;
+    // Copy mapping sections
     for (size_t i = point1; i <= point2; ++i) {
         child1[i] = parent2[i];
         child2[i] = parent1[i];
-        mapping1[parent2[i]] = parent1[i];
-        mapping2[parent1[i]] = parent2[i];
     }
     
-    // Fill remaining positions using mappings
+    // Fill remaining positions by following the mapping chains. The section
+    // maps parent2[j] -> parent1[j] (child1) and parent1[j] -> parent2[j]
+    // (child2); the inverse positions find j in O(1), and because the chains
+    // are disjoint paths the total work over all positions is O(n).
     for (size_t i = 0; i < length; ++i) {
-        if (i < point1 || i > point2) {
-            // For child1
-            int val1 = parent1[i];
-            while (mapping1.find(val1) != mapping1.end()) {
-                val1 = mapping1[val1];
-            }
-            child1[i] = val1;
-            
-            // For child2
-            int val2 = parent2[i];
-            while (mapping2.find(val2) != mapping2.end()) {
-                val2 = mapping2[val2];
-            }
-            child2[i] = val2;
+        if (in_segment(static_cast<int>(i))) continue;
+        
+        int val1 = parent1[i];
+        while (in_segment(position2_[val1])) {
+            val1 = parent1[position2_[val1]];
+        }
+        child1[i] = val1;
+        
+        int val2 = parent2[i];
+        while (in_segment(position1_[val2])) {
+            val2 = parent2[position1_[val2]];
         }
+        child2[i] = val2;
+    }
+}
+
+std::pair<Permutation, Permutation> PartiallyMappedCrossover::crossover(const Permutation& parent1, const Permutation& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
     }
     
-    return {child1, child2};
+    Permutation child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
@@ -2,13 +2,27 @@
 #define PARTIALLY_MAPPED_CROSSOVER_H
 
 #include "base_crossover.h"
+#include "permutation_index.h"
 
+/**
+ * @brief Partially Mapped Crossover (PMX) for permutations of 0..n-1
+ *
+ * Runs in O(n) using inverse-position arrays that are reused between calls.
+ * Throws std::invalid_argument if a parent is not a permutation of 0..n-1.
+ */
 class PartiallyMappedCrossover : public CrossoverOperator {
+private:
+    PositionIndex position1_; ///< Inverse of parent1, reused between calls
+    PositionIndex position2_; ///< Inverse of parent2, reused between calls
+    
 public:
     PartiallyMappedCrossover(unsigned seed = std::random_device{}()) 
         : CrossoverOperator("PartiallyMappedCrossover", seed) {}
     
     std::pair<Permutation, Permutation> crossover(const Permutation& parent1, const Permutation& parent2);
+    void crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                       IntSpan child1, IntSpan child2) override;
+    using CrossoverOperator::crossoverInto;
 };
 
 #endif // PARTIALLY_MAPPED_CROSSOVER_H
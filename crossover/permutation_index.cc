@@ -0,0 +1,40 @@
+#include "permutation_index.h"
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+[[noreturn]] void throwNotPermutation(size_t length) {
+    throw std::invalid_argument("Parent must be a permutation of 0.." + std::to_string(static_cast<long>(length) - 1));
+}
+
+} // namespace
+
+// ============================================================================
+// PERMUTATION POSITION INDEX IMPLEMENTATION
+// ============================================================================
+
+void PositionIndex::build(ConstIntSpan permutation) {
+    const int length = static_cast<int>(permutation.size());
+    position_.assign(permutation.size(), -1);
+    
+    for (int i = 0; i < length; ++i) {
+        int value = permutation[i];
+        if (value < 0 || value >= length || position_[value] != -1) {
+            throwNotPermutation(permutation.size());
+        }
+        position_[value] = i;
+    }
+}
+
+void validatePermutation(ConstIntSpan permutation, ValueBitmap& seen) {
+    const int length = static_cast<int>(permutation.size());
+    seen.reset(permutation.size());
+    
+    for (int value : permutation) {
+        if (value < 0 || value >= length || seen.test(value)) {
+            throwNotPermutation(permutation.size());
+        }
+        seen.set(value);
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef PERMUTATION_INDEX_H
+#define PERMUTATION_INDEX_H
+
+#include "base_crossover.h"
+#include <cstdint>
+
+/**
+ * @brief Packed membership set over the values 0..n-1
+ *
+ * Used by the permutation crossovers in place of hash sets. The word storage
+ * is kept between calls, so resetting for a permutation no longer than any
+ * seen before does not allocate.
+ */
+class ValueBitmap {
+private:
+    std::vector<uint64_t> words_;
+    
+public:
+    /**
+     * @brief Clear the bitmap and size it for values 0..count-1
+     * @param count Number of representable values
+     */
+    void reset(size_t count) { words_.assign((count + 63) / 64, 0); }
+    
+    void set(int value) { words_[static_cast<size_t>(value) >> 6] |= uint64_t(1) << (value & 63); }
+    bool test(int value) const { return (words_[static_cast<size_t>(value) >> 6] >> (value & 63)) & 1u; }
+};
+
+/**
+ * @brief Inverse permutation (value -> position) for permutations of 0..n-1
+ *
+ * Building the index also validates its input: every value must lie in
+ * [0, n) and occur exactly once. Dense arrays make lookups O(1) with no
+ * hashing, which is what keeps PMX, OX and CX linear in n.
+ */
+class PositionIndex {
+private:
+    std::vector<int> position_;
+    
+public:
+    /**
+     * @brief Rebuild the index for a permutation
+     * @param permutation Permutation of 0..n-1
+     * @throws std::invalid_argument if the input is not such a permutation
+     */
+    void build(ConstIntSpan permutation);
+    
+    /**
+     * @brief Position of a value in the indexed permutation
+     * @param value Value in [0, n)
+     * @return Index at which the value occurs
+     */
+    int operator[](int value) const { return position_[value]; }
+};
+
+/**
+ * @brief Check that a sequence is a permutation of 0..n-1
+ * @param permutation Sequence to check
+ * @param seen Scratch bitmap, reset by this call
+ * @throws std::invalid_argument if a value is out of range or repeated
+ */
+void validatePermutation(ConstIntSpan permutation, ValueBitmap& seen);
+
+#endif // PERMUTATION_INDEX_H
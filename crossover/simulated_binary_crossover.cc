@@ -1,4 +1,5 @@
 #include "simulated_binary_crossover.h"
+#include "common/recombination_kernels.h"
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
@@ -7,59 +8,121 @@
 // SIMULATED BINARY CROSSOVER (SBX) IMPLEMENTATION
 // ============================================================================
 
-std::pair<RealVector, RealVector> SimulatedBinaryCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
+using recombination_kernels::blend;
+using recombination_kernels::fastPow;
+using recombination_kernels::lessThan;
+
+void SimulatedBinaryCrossover::setBounds(ConstRealSpan lower, ConstRealSpan upper) {
+    if (lower.size() != upper.size()) {
+        throw std::invalid_argument("Bounds must have the same length");
     }
-    
-    operation_count++;
-    
-    size_t length = parent1.size();
-    RealVector child1(length), child2(length);
-    
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    
-    // For each gene position, perform SBX
-    for (size_t i = 0; i < length; ++i) {
-        double p1_val = parent1[i];
-        double p2_val = parent2[i];
-        
-        // If parents are identical, children are identical
-        if (std::abs(p1_val - p2_val) < 1e-14) {
-            child1[i] = p1_val;
-            child2[i] = p2_val;
-            continue;
+    for (size_t i = 0; i < lower.size(); ++i) {
+        if (!(lower[i] <= upper[i])) {
+            throw std::invalid_argument("Lower bound exceeds upper bound");
         }
-        
-        // Ensure p1_val <= p2_val
-        if (p1_val > p2_val) {
-            std::swap(p1_val, p2_val);
+    }
+    lower_bounds = lower;
+    upper_bounds = upper;
+}
+
+void SimulatedBinaryCrossover::recombine(const double* parent1, const double* parent2, const double* u,
+                                         double* __restrict child1, double* __restrict child2, size_t n) const {
+    const double exponent = 1.0 / (eta_c + 1.0);
+    
+    if (!isBounded()) {
+        for (size_t i = 0; i < n; ++i) {
+            const double lo = std::min(parent1[i], parent2[i]);
+            const double hi = std::max(parent1[i], parent2[i]);
+            // beta = (2u)^e below the median, (1 / (2 (1 - u)))^e above it
+            const double below = 2.0 * u[i];
+            const double above = 1.0 / (2.0 * (1.0 - u[i]));
+            const double x = blend(lessThan(0.5, u[i]), above, below);
+            const double spread = fastPow(x, exponent) * (hi - lo);
+            // Identical parents (within 1e-14) are copied
+            const double same = lessThan(hi - lo, 1e-14);
+            child1[i] = blend(same, parent1[i], 0.5 * ((lo + hi) - spread));
+            child2[i] = blend(same, parent2[i], 0.5 * ((lo + hi) + spread));
         }
+        return;
+    }
+    
+    // Bounded SBX: the spread distribution on each side is truncated at the
+    // bound on that side, alpha = 2 - beta^-(eta + 1) renormalising it
+    const double* lower = lower_bounds.data();
+    const double* upper = upper_bounds.data();
+    const double tail = -(eta_c + 1.0);
+    for (size_t i = 0; i < n; ++i) {
+        const double lo = std::min(parent1[i], parent2[i]);
+        const double hi = std::max(parent1[i], parent2[i]);
+        const double same = lessThan(hi - lo, 1e-14);
+        const double gap = blend(same, 1.0, hi - lo);
         
-        // Generate random number
-        double u = dist(rng);
-        
-        // Calculate beta using the distribution
-        double beta = calculateBeta(u);
+        // Distances to the bounds; (d + |d|) / 2 rather than max(0, d), whose
+        // constant arm would put the pow below behind a branch
+        const double below = lo - lower[i];
+        const double above = upper[i] - hi;
+        const double beta1 = 1.0 + (below + std::fabs(below)) / gap;
+        const double alpha1 = 2.0 - fastPow(beta1, tail);
+        const double a1 = u[i] * alpha1;
+        const double r1 = 1.0 / (2.0 - a1);
+        const double q1 = fastPow(blend(lessThan(1.0, a1), r1, a1), exponent);
         
-        // Calculate offspring values
-        double alpha = 2.0 - std::pow(beta, -(eta_c + 1.0));
+        const double beta2 = 1.0 + (above + std::fabs(above)) / gap;
+        const double alpha2 = 2.0 - fastPow(beta2, tail);
+        const double a2 = u[i] * alpha2;
+        const double r2 = 1.0 / (2.0 - a2);
+        const double q2 = fastPow(blend(lessThan(1.0, a2), r2, a2), exponent);
         
-        child1[i] = 0.5 * ((p1_val + p2_val) - beta * std::abs(p2_val - p1_val));
-        child2[i] = 0.5 * ((p1_val + p2_val) + beta * std::abs(p2_val - p1_val));
+        const double c1 = std::min(upper[i], std::max(lower[i], 0.5 * ((lo + hi) - q1 * gap)));
+        const double c2 = std::min(upper[i], std::max(lower[i], 0.5 * ((lo + hi) + q2 * gap)));
+        child1[i] = blend(same, parent1[i], c1);
+        child2[i] = blend(same, parent2[i], c2);
+    }
+}
+
+void SimulatedBinaryCrossover::crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                                             RealSpan child1, RealSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    if (isBounded() && lower_bounds.size() != parent1.size()) {
+        throw std::invalid_argument("Bounds must match the chromosome length");
     }
     
-    return {child1, child2};
+    operation_count++;
+    
+    const size_t n = parent1.size();
+    uint32_t key1, key2;
+    batchKeys(key1, key2);
+    batch_uniforms_.resize(n);
+    recombination_kernels::fillUniform(batch_uniforms_.data(), n, 0, key1, key2);
+    recombine(parent1.data(), parent2.data(), batch_uniforms_.data(), child1.data(), child2.data(), n);
 }
 
-double SimulatedBinaryCrossover::calculateBeta(double u) const {
-    double beta;
+void SimulatedBinaryCrossover::crossoverBatch(const double* population, size_t dimension, const size_t* parents,
+                                              size_t pairs, double* offspring) {
+    if (isBounded() && lower_bounds.size() != dimension) {
+        throw std::invalid_argument("Bounds must match the chromosome length");
+    }
     
-    if (u <= 0.5) {
-        beta = std::pow(2.0 * u, 1.0 / (eta_c + 1.0));
-    } else {
-        beta = std::pow(1.0 / (2.0 * (1.0 - u)), 1.0 / (eta_c + 1.0));
+    operation_count += pairs;
+    
+    uint32_t key1, key2;
+    batchKeys(key1, key2);
+    batch_uniforms_.resize(dimension);
+    for (size_t t = 0; t < pairs; ++t) {
+        recombination_kernels::fillUniform(batch_uniforms_.data(), dimension,
+                                           static_cast<uint32_t>(t * dimension), key1, key2);
+        recombine(population + parents[2 * t] * dimension, population + parents[2 * t + 1] * dimension,
+                  batch_uniforms_.data(), offspring + 2 * t * dimension, offspring + (2 * t + 1) * dimension,
+                  dimension);
+    }
+}
+
+std::pair<RealVector, RealVector> SimulatedBinaryCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
     }
     
-    return beta;
+    RealVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
@@ -9,10 +9,17 @@
  * This class implements the Simulated Binary Crossover (SBX) operator
  * for real-valued chromosomes. SBX mimics the behavior of single-point
  * crossover on binary strings but works directly on real values.
+ *
+ * With bounds set, the spread distribution is truncated to the bounds as in
+ * Deb & Agrawal's bounded SBX, so children fall inside rather than being
+ * clipped onto the bounds. Spreads use the vectorisable pow of
+ * common/recombination_kernels.h.
  */
 class SimulatedBinaryCrossover : public CrossoverOperator {
 private:
     double eta_c; ///< Distribution index (controls spread of offspring)
+    ConstRealSpan lower_bounds; ///< Per-gene lower bounds (empty: unbounded)
+    ConstRealSpan upper_bounds; ///< Per-gene upper bounds
     
 public:
     /**
@@ -40,6 +47,20 @@ public:
      */
     double getEta() const { return eta_c; }
     
+    /**
+     * @brief Use bounded SBX within [lower, upper]
+     * @param lower Per-gene lower bounds; viewed, not copied, so the storage
+     *        must stay valid until the next setBounds() or clearBounds()
+     * @param upper Per-gene upper bounds, same length
+     * @throws std::invalid_argument if the lengths differ or lower > upper
+     */
+    void setBounds(ConstRealSpan lower, ConstRealSpan upper);
+    
+    /** @brief Return to unbounded SBX */
+    void clearBounds() { lower_bounds = ConstRealSpan(); upper_bounds = ConstRealSpan(); }
+    
+    bool isBounded() const { return !lower_bounds.empty(); }
+    
     /**
      * @brief Perform SBX crossover on real-valued vectors
      * @param parent1 First parent chromosome
@@ -48,6 +69,20 @@ public:
      */
     std::pair<RealVector, RealVector> crossover(const RealVector& parent1, const RealVector& parent2) override;
     
+    /**
+     * @brief Perform SBX crossover on real-valued vectors without allocation
+     * @param parent1 First parent chromosome
+     * @param parent2 Second parent chromosome
+     * @param child1 First offspring buffer, sized like the parents
+     * @param child2 Second offspring buffer, sized like the parents
+     */
+    void crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                       RealSpan child1, RealSpan child2) override;
+    using CrossoverOperator::crossoverInto;
+    
+    void crossoverBatch(const double* population, size_t dimension, const size_t* parents,
+                        size_t pairs, double* offspring) override;
+    
     // Note: SBX is specifically designed for real-valued representations
     std::pair<BitString, BitString> crossover(const BitString& /* parent1 */, const BitString& /* parent2 */) override {
         throw std::runtime_error("SBX crossover is not applicable to binary strings");
@@ -59,11 +94,13 @@ public:
 
 private:
     /**
-     * @brief Calculate the beta value for SBX
-     * @param u Random number [0,1]
-     * @return Beta value for crossover calculation
+     * @brief SBX of one pair given one uniform per gene
+     *
+     * The children must not overlap the inputs; __restrict saves the
+     * bounded loop from more run-time alias checks than GCC will emit.
      */
-    double calculateBeta(double u) const;
+    void recombine(const double* parent1, const double* parent2, const double* u,
+                   double* __restrict child1, double* __restrict child2, size_t n) const;
 };
 
 #endif // SIMULATED_BINARY_CROSSOVER_H
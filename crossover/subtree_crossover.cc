@@ -1,9 +1,37 @@
 #include "subtree_crossover.h"
 #include <stdexcept>
 #include <memory>
+#include <algorithm>
 
 // TreeNode implementation is in base_crossover.cc
 
+namespace {
+
+// Copy host with the subtree at `at` replaced by donor's subtree at `from`
+LinearTree splice(const LinearTree& host, size_t at, const LinearTree& donor, size_t from, TreeArena& arena) {
+    const size_t old_size = host[at].size;
+    const size_t new_size = donor[from].size;
+    const size_t length = host.size() - old_size + new_size;
+    
+    LinearNode* nodes = arena.allocate(length);
+    std::copy(host.data(), host.data() + at, nodes);
+    std::copy(donor.data() + from, donor.data() + from + new_size, nodes + at);
+    std::copy(host.data() + at + old_size, host.data() + host.size(), nodes + at + new_size);
+    
+    // Ancestors of the crossover point are the only nodes whose size changes
+    for (size_t k = 0; k != at;) {
+        nodes[k].size = static_cast<uint32_t>(nodes[k].size + new_size - old_size);
+        size_t child = k + 1;
+        while (host.subtreeEnd(child) <= at) {
+            child = host.subtreeEnd(child);
+        }
+        k = child;
+    }
+    return LinearTree(nodes, static_cast<uint32_t>(length));
+}
+
+} // namespace
+
 // ============================================================================
 // SUBTREE CROSSOVER IMPLEMENTATION
 // ============================================================================
@@ -63,3 +91,20 @@ std::pair<TreeNode*, TreeNode*> SubtreeCrossover::crossover(const TreeNode* pare
     
     return {child1, child2};
 }
+
+std::pair<LinearTree, LinearTree> SubtreeCrossover::crossover(const LinearTree& parent1, const LinearTree& parent2,
+                                                             TreeArena& arena) {
+    if (parent1.empty() || parent2.empty()) {
+        throw std::invalid_argument("Parents cannot be empty");
+    }
+    
+    operation_count++;
+    
+    std::uniform_int_distribution<size_t> dist1(0, parent1.size() - 1);
+    std::uniform_int_distribution<size_t> dist2(0, parent2.size() - 1);
+    size_t point1 = dist1(rng);
+    size_t point2 = dist2(rng);
+    
+    return {splice(parent1, point1, parent2, point2, arena),
+            splice(parent2, point2, parent1, point1, arena)};
+}
@@ -2,6 +2,7 @@
 #define SUBTREE_CROSSOVER_H
 
 #include "base_crossover.h"
+#include "linear_tree.h"
 
 // Tree node structure for GP - using the one from base_crossover.h
 
@@ -12,6 +13,20 @@ public:
     
     std::pair<TreeNode*, TreeNode*> crossover(const TreeNode* parent1, const TreeNode* parent2);
     
+    /**
+     * @brief Subtree crossover on linear trees
+     * @param parent1 First parent tree
+     * @param parent2 Second parent tree
+     * @param arena Arena the offspring nodes are allocated from
+     * @return Pair of offspring trees
+     *
+     * Crossover points are drawn uniformly over nodes in O(1). Each child is
+     * assembled from three range copies (prefix, donated subtree, suffix),
+     * after which only the sizes along the path to the root are adjusted.
+     */
+    std::pair<LinearTree, LinearTree> crossover(const LinearTree& parent1, const LinearTree& parent2,
+                                                TreeArena& arena);
+    
 private:
     TreeNode* selectRandomNode(TreeNode* tree);
     int countNodes(const TreeNode* tree);
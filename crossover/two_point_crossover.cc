@@ -6,16 +6,22 @@
 // TWO-POINT CROSSOVER IMPLEMENTATION
 // ============================================================================
 
-std::pair<BitString, BitString> TwoPointCrossover::crossover(const BitString& parent1, const BitString& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
-    }
+namespace {
+
+// Shared kernel for every representation: children start as copies of their
+// parents and exchange the segment between two random cut points.
+template <typename Parent, typename Child>
+void twoPointInto(std::mt19937& rng, const Parent& parent1, const Parent& parent2,
+                  Child& child1, Child& child2) {
+    size_t length = parent1.size();
     
-    operation_count++;
+    for (size_t i = 0; i < length; ++i) {
+        child1[i] = parent1[i];
+        child2[i] = parent2[i];
+    }
     
-    size_t length = parent1.size();
     if (length <= 2) {
-        return {parent1, parent2};
+        return;
     }
     
     // Select two random crossover points
@@ -33,57 +39,54 @@ std::pair<BitString, BitString> TwoPointCrossover::crossover(const BitString& pa
         point2 = std::min(point1 + 1, length - 1);
     }
     
-    // Create offspring
-    BitString child1 = parent1;
-    BitString child2 = parent2;
-    
     // Exchange genetic material between crossover points
     for (size_t i = point1; i < point2; ++i) {
         child1[i] = parent2[i];
         child2[i] = parent1[i];
     }
-    
-    return {child1, child2};
 }
 
-std::pair<RealVector, RealVector> TwoPointCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
+} // namespace
+
+void TwoPointCrossover::crossoverInto(const BitString& parent1, const BitString& parent2,
+                                      BitString& child1, BitString& child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    twoPointInto(rng, parent1, parent2, child1, child2);
+}
+
+void TwoPointCrossover::crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                                      RealSpan child1, RealSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    twoPointInto(rng, parent1, parent2, child1, child2);
+}
+
+void TwoPointCrossover::crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                                      IntSpan child1, IntSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    twoPointInto(rng, parent1, parent2, child1, child2);
+}
+
+std::pair<BitString, BitString> TwoPointCrossover::crossover(const BitString& parent1, const BitString& parent2) {
     if (parent1.size() != parent2.size()) {
         throw std::invalid_argument("Parents must have the same length");
     }
     
-    operation_count++;
-    
-    size_t length = parent1.size();
-    if (length <= 2) {
-        return {parent1, parent2};
-    }
-    
-    // Select two random crossover points
-    std::uniform_int_distribution<size_t> dist(1, length - 1);
-    size_t point1 = dist(rng);
-    size_t point2 = dist(rng);
-    
-    // Ensure point1 < point2
-    if (point1 > point2) {
-        std::swap(point1, point2);
-    }
-    
-    // If points are the same, make it one-point crossover
-    if (point1 == point2) {
-        point2 = std::min(point1 + 1, length - 1);
-    }
-    
-    // Create offspring
-    RealVector child1 = parent1;
-    RealVector child2 = parent2;
-    
-    // Exchange genetic material between crossover points
-    for (size_t i = point1; i < point2; ++i) {
-        child1[i] = parent2[i];
-        child2[i] = parent1[i];
+    BitString child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
+}
+
+std::pair<RealVector, RealVector> TwoPointCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
     }
     
-    return {child1, child2};
+    RealVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
 
 std::pair<IntVector, IntVector> TwoPointCrossover::crossover(const IntVector& parent1, const IntVector& parent2) {
@@ -91,37 +94,7 @@ std::pair<IntVector, IntVector> TwoPointCrossover::crossover(const IntVector& pa
         throw std::invalid_argument("Parents must have the same length");
     }
     
-    operation_count++;
-    
-    size_t length = parent1.size();
-    if (length <= 2) {
-        return {parent1, parent2};
-    }
-    
-    // Select two random crossover points
-    std::uniform_int_distribution<size_t> dist(1, length - 1);
-    size_t point1 = dist(rng);
-    size_t point2 = dist(rng);
-    
-    // Ensure point1 < point2
-    if (point1 > point2) {
-        std::swap(point1, point2);
-    }
-    
-    // If points are the same, make it one-point crossover
-    if (point1 == point2) {
-        point2 = std::min(point1 + 1, length - 1);
-    }
-    
-    // Create offspring
-    IntVector child1 = parent1;
-    IntVector child2 = parent2;
-    
-    // Exchange genetic material between crossover points
-    for (size_t i = point1; i < point2; ++i) {
-        child1[i] = parent2[i];
-        child2[i] = parent1[i];
-    }
-    
-    return {child1, child2};
+    IntVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
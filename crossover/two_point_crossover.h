@@ -42,6 +42,36 @@ public:
      * @return Pair of offspring chromosomes
      */
     std::pair<IntVector, IntVector> crossover(const IntVector& parent1, const IntVector& parent2) override;
+    
+    /**
+     * @brief Two-point crossover on binary strings into pre-sized children
+     * @param parent1 First parent chromosome
+     * @param parent2 Second parent chromosome
+     * @param child1 First offspring, sized like the parents
+     * @param child2 Second offspring, sized like the parents
+     */
+    void crossoverInto(const BitString& parent1, const BitString& parent2,
+                       BitString& child1, BitString& child2) override;
+    
+    /**
+     * @brief Two-point crossover on real-valued vectors without allocation
+     * @param parent1 First parent chromosome
+     * @param parent2 Second parent chromosome
+     * @param child1 First offspring buffer, sized like the parents
+     * @param child2 Second offspring buffer, sized like the parents
+     */
+    void crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                       RealSpan child1, RealSpan child2) override;
+    
+    /**
+     * @brief Two-point crossover on integer vectors without allocation
+     * @param parent1 First parent chromosome
+     * @param parent2 Second parent chromosome
+     * @param child1 First offspring buffer, sized like the parents
+     * @param child2 Second offspring buffer, sized like the parents
+     */
+    void crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                       IntSpan child1, IntSpan child2) override;
 };
 
 #endif // TWO_POINT_CROSSOVER_H
@@ -5,64 +5,69 @@
 // UNIFORM CROSSOVER IMPLEMENTATION
 // ============================================================================
 
-std::pair<BitString, BitString> UniformCrossover::crossover(const BitString& parent1, const BitString& parent2) {
-    if (parent1.size() != parent2.size()) {
-        throw std::invalid_argument("Parents must have the same length");
-    }
-    
-    operation_count++;
-    
-    size_t length = parent1.size();
-    BitString child1, child2;
-    child1.reserve(length);
-    child2.reserve(length);
-    
+namespace {
+
+// Shared kernel for every representation
+template <typename Parent, typename Child>
+void uniformInto(std::mt19937& rng, double probability, const Parent& parent1, const Parent& parent2,
+                 Child& child1, Child& child2) {
     std::uniform_real_distribution<double> dist(0.0, 1.0);
     
     // For each gene position, randomly choose which parent to take gene from
-    for (size_t i = 0; i < length; ++i) {
+    for (size_t i = 0; i < parent1.size(); ++i) {
         if (dist(rng) < probability) {
             // Take from first parent for child1, second parent for child2
-            child1.push_back(parent1[i]);
-            child2.push_back(parent2[i]);
+            child1[i] = parent1[i];
+            child2[i] = parent2[i];
         } else {
             // Take from second parent for child1, first parent for child2
-            child1.push_back(parent2[i]);
-            child2.push_back(parent1[i]);
+            child1[i] = parent2[i];
+            child2[i] = parent1[i];
         }
     }
-    
-    return {child1, child2};
 }
 
-std::pair<RealVector, RealVector> UniformCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
+} // namespace
+
+void UniformCrossover::crossoverInto(const BitString& parent1, const BitString& parent2,
+                                     BitString& child1, BitString& child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    uniformInto(rng, probability, parent1, parent2, child1, child2);
+}
+
+void UniformCrossover::crossoverInto(ConstRealSpan parent1, ConstRealSpan parent2,
+                                     RealSpan child1, RealSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    uniformInto(rng, probability, parent1, parent2, child1, child2);
+}
+
+void UniformCrossover::crossoverInto(ConstIntSpan parent1, ConstIntSpan parent2,
+                                     IntSpan child1, IntSpan child2) {
+    checkBuffers(parent1.size(), parent2.size(), child1.size(), child2.size());
+    operation_count++;
+    uniformInto(rng, probability, parent1, parent2, child1, child2);
+}
+
+std::pair<BitString, BitString> UniformCrossover::crossover(const BitString& parent1, const BitString& parent2) {
     if (parent1.size() != parent2.size()) {
         throw std::invalid_argument("Parents must have the same length");
     }
     
-    operation_count++;
-    
-    size_t length = parent1.size();
-    RealVector child1, child2;
-    child1.reserve(length);
-    child2.reserve(length);
-    
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    
-    // For each gene position, randomly choose which parent to take gene from
-    for (size_t i = 0; i < length; ++i) {
-        if (dist(rng) < probability) {
-            // Take from first parent for child1, second parent for child2
-            child1.push_back(parent1[i]);
-            child2.push_back(parent2[i]);
-        } else {
-            // Take from second parent for child1, first parent for child2
-            child1.push_back(parent2[i]);
-            child2.push_back(parent1[i]);
-        }
+    BitString child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
+}
+
+std::pair<RealVector, RealVector> UniformCrossover::crossover(const RealVector& parent1, const RealVector& parent2) {
+    if (parent1.size() != parent2.size()) {
+        throw std::invalid_argument("Parents must have the same length");
     }
     
-    return {child1, child2};
+    RealVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
 
 std::pair<IntVector, IntVector> UniformCrossover::crossover(const IntVector& parent1, const IntVector& parent2) {
@@ -70,27 +75,7 @@ std::pair<IntVector, IntVector> UniformCrossover::crossover(const IntVector& par
         throw std::invalid_argument("Parents must have the same length");
     }
     
-    operation_count++;
-    
-    size_t length = parent1.size();
-    IntVector child1, child2;
-    child1.reserve(length);
-    child2.reserve(length);
-    
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    
-    // For each gene position, randomly choose which parent to take gene from
-    for (size_t i = 0; i < length; ++i) {
-        if (dist(rng) < probability) {
-            // Take from first parent for child1, second parent for child2
-            child1.push_back(parent1[i]);
-            child2.push_back(parent2[i]);
-        } else {
-            // Take from second parent for child1, first parent for child2
-            child1.push_back(parent2[i]);
-            child2.push_back(parent1[i]);
-        }
-    }
-    
-    return {child1, child2};
+    IntVector child1(parent1.size()), child2(parent2.size());
+    crossoverInto(parent1, parent2, child1, child2);
+    return {std::move(child1), std::move(child2)};
 }
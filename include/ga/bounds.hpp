@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "ga/config.hpp"
+
+namespace ga {
+
+// Per-gene bounds of a run: Config::lower/upper when set, otherwise
+// Config::bounds for every gene. Throws std::invalid_argument when the
+// per-dimension vectors do not both hold `dimension` values or a lower
+// bound exceeds its upper bound.
+void resolveBounds(const Config& cfg, std::vector<double>& lower, std::vector<double>& upper);
+
+// Gene x brought back into [lower, upper] as `handling` prescribes; genes
+// inside are returned unchanged, so the common case costs two compares.
+// `parent` is the parent's gene at the same locus (MidpointToParent) and
+// u a uniform in [0, 1) (Resample).
+inline double repairGene(BoundHandling handling, double x, double lower, double upper, double parent, double u) {
+    if (x >= lower && x <= upper) return x;
+    const double width = upper - lower;
+    switch (handling) {
+    case BoundHandling::Reflect: {
+        if (!(width > 0.0)) return lower;
+        // Position within a period of two widths, the second half mirrored
+        const double t = (x - lower) / (2.0 * width);
+        return lower + width - std::fabs(2.0 * width * (t - std::floor(t)) - width);
+    }
+    case BoundHandling::Wrap: {
+        if (!(width > 0.0)) return lower;
+        const double t = (x - lower) / width;
+        return std::fmin(upper, lower + width * (t - std::floor(t)));
+    }
+    case BoundHandling::Resample:
+        return lower + u * width;
+    case BoundHandling::MidpointToParent:
+        return 0.5 * ((x < lower ? lower : upper) + parent);
+    case BoundHandling::Clamp:
+    default:
+        return x < lower ? lower : upper;
+    }
+}
+
+// Repairs genes[0..n) in place against per-gene bounds. parent may be null
+// unless handling is MidpointToParent; Resample draws its uniforms from rng.
+void repairGenes(BoundHandling handling, double* genes, size_t n, const double* lower, const double* upper,
+                 const double* parent, std::mt19937& rng);
+
+} // namespace ga
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "ga/config.hpp"
+
+namespace ga {
+
+struct CmaesOptions {
+    enum class Covariance {
+        Full,     // full covariance matrix, O(n^2) memory and O(n^2) per sample
+        Separable // sep-CMA: diagonal covariance, O(n) per sample, for large n
+    };
+    Covariance covariance = Covariance::Full;
+
+    int lambda = 0;          // offspring per generation (0: 4 + 3 ln n)
+    double sigma0 = 0.0;     // initial step size (0: 0.3 * mean of upper - lower)
+    int restarts = 0;        // IPOP restarts, each doubling lambda
+    int eigenInterval = 0;   // generations between eigendecompositions (0: automatic)
+
+    // A run stops (and IPOP restarts) once the best fitness of the recent
+    // generations spans less than tolFun, or every coordinate's step size
+    // sigma * sqrt(C_ii) is below tolX
+    double tolFun = 1e-12;
+    double tolX = 1e-12;
+};
+
+// Covariance matrix adaptation evolution strategy (Hansen's (mu/mu_w,
+// lambda)-CMA-ES). Shares Config, Fitness and Result with GeneticAlgorithm:
+// dimension, bounds (or per-gene lower/upper), generations, maxEvaluations
+// and seed are used; populationSize is not, the strategy sizes its own
+// population (CmaesOptions::lambda). Samples are projected into the bounds
+// before evaluation, whatever Config::boundHandling says. `generations` is
+// the total budget over all restarts, and the histories hold one entry per
+// generation: best fitness found so far and mean fitness of that
+// generation's samples.
+//
+// The linear algebra is written out here rather than taken from BLAS: the
+// sampling product and the rank-mu update run over cache-sized blocks of
+// contiguous rows, and the eigendecomposition (Householder tridiagonalisation
+// followed by implicit QL) is only redone every eigenInterval generations.
+class CMAES {
+public:
+    explicit CMAES(const Config& cfg, const CmaesOptions& options = CmaesOptions());
+
+    Result run(const Fitness& fitness);
+
+    const Config& config() const { return cfg_; }
+    const CmaesOptions& options() const { return options_; }
+
+    // Statistics of the last run
+    size_t evaluations() const { return evaluations_; }
+    int restartsUsed() const { return restartsUsed_; }
+
+private:
+    Config cfg_;
+    CmaesOptions options_;
+    std::mt19937 rng_;
+
+    size_t evaluations_ = 0;
+    int restartsUsed_ = 0;
+
+    // Strategy state, all of dimension n unless noted
+    std::vector<double> mean_;
+    std::vector<double> pathSigma_;
+    std::vector<double> pathC_;
+    std::vector<double> cov_;          // n x n (Full) or n (Separable)
+    std::vector<double> eigenvectors_; // n x n, row j is eigenvector j (Full only)
+    std::vector<double> scale_;        // sqrt of the eigenvalues (or of the diagonal)
+    double sigma_ = 0.0;
+    std::vector<double> lower_; // per-gene bounds of the run
+    std::vector<double> upper_;
+
+    // Per-generation scratch
+    std::vector<double> z_;       // lambda x n standard normal samples
+    std::vector<double> y_;       // lambda x n steps, x = mean + sigma * y
+    std::vector<double> x_;       // candidate in bounds
+    std::vector<double> fitness_; // lambda
+    std::vector<size_t> order_;   // lambda
+    std::vector<double> weighted_; // mu x n, sqrt(w_i) * y_i:lambda
+    std::vector<double> step_;    // weighted mean step
+    std::vector<double> tmp_;
+    std::vector<double> diag_;    // eigensolver workspace
+    std::vector<double> offDiag_;
+
+    // Runs one CMA-ES instance with population lambda for at most
+    // `generations`; returns the generations used
+    int runOnce_(int lambda, int generations, const Fitness& fitness, Result& res);
+    void sample_(int lambda);
+    void updateEigensystem_();
+    bool budgetSpent_() const { return cfg_.maxEvaluations > 0 && evaluations_ >= cfg_.maxEvaluations; }
+};
+
+} // namespace ga
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 #include <string>
 #include <functional>
@@ -8,11 +9,32 @@ namespace ga {
 
 using Fitness = std::function<double(const std::vector<double>&)>; // higher is better
 
+// Objective of the form finish(sum_i term(i, x_i)), e.g. Rastrigin or
+// Schwefel. Engines that understand it keep each genome's terms and only
+// re-evaluate the terms of loci that variation changed.
+struct SeparableFitness {
+    std::function<double(size_t locus, double gene)> term;
+    std::function<double(double sum)> finish; // sum -> fitness (higher is better); identity when empty
+};
+
+// Scores `count` candidates stored row-major in genes (count x dimension)
+// into out[0..count); lets a caller evaluate a whole generation at once
+using BatchFitness = std::function<void(const double* genes, size_t count, size_t dimension, double* out)>;
+
 struct Bounds {
     double lower = -1.0;
     double upper = 1.0;
 };
 
+// How a gene that variation pushed outside its bounds is brought back
+enum class BoundHandling {
+    Clamp,            // onto the violated bound
+    Reflect,          // mirrored back off the bound, folding again past the far one
+    Wrap,             // periodic: re-enters from the opposite bound
+    Resample,         // drawn uniformly within the bounds
+    MidpointToParent  // halfway between the violated bound and the parent's gene
+};
+
 struct Config {
     int populationSize = 50;
     int generations = 100;
@@ -22,12 +44,26 @@ struct Config {
     double mutationRate = 0.1;
 
     Bounds bounds{ -5.12, 5.12 };
+    // Per-dimension bounds: when set, both hold `dimension` values and take
+    // the place of `bounds`. Engines resolve them once per run and their
+    // operators read that one copy (see ga/bounds.hpp).
+    std::vector<double> lower;
+    std::vector<double> upper;
+    BoundHandling boundHandling = BoundHandling::Clamp;
 
     // Elitism: fraction [0,1]
     double eliteRatio = 0.05;
 
     // Random seed (0 uses random_device)
     unsigned seed = 0;
+
+    // Workers for fitness evaluation (0: one per hardware thread). Values
+    // other than 1 call the fitness concurrently, so it must be thread-safe.
+    int threads = 1;
+
+    // Fitness evaluation budget (0: unlimited). Engines check it between
+    // generations, so a run can overshoot by at most one generation.
+    size_t maxEvaluations = 0;
 };
 
 struct Result {
@@ -35,6 +71,9 @@ struct Result {
     double bestFitness = -1e300;
     std::vector<double> bestHistory; // best per generation
     std::vector<double> avgHistory;  // average per generation
+    size_t evaluations = 0;          // fitness evaluations spent, local search included
+    size_t duplicates = 0;           // offspring that matched an existing genome
+    size_t evaluationsSaved = 0;     // duplicates scored by copying a twin's fitness
 };
 
 } // namespace ga
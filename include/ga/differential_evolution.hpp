@@ -0,0 +1,99 @@
+#pragma once
+
+#include <memory>
+#include <random>
+#include <vector>
+#include "ga/config.hpp"
+
+class DifferentialEvolutionCrossover;
+
+namespace ga {
+
+struct DeOptions {
+    enum class Strategy {
+        Rand1,          // v = x_r1 + F (x_r2 - x_r3)
+        Best1,          // v = x_best + F (x_r1 - x_r2)
+        CurrentToPBest1 // v = x_i + F (x_pbest - x_i) + F (x_r1 - x~_r2), x~ from population or archive
+    };
+    enum class Adaptation {
+        None,  // fixed F and CR (Config::crossoverRate)
+        JADE,  // Zhang & Sanderson 2009: running means of successful F and CR
+        SHADE  // Tanabe & Fukunaga 2013: success-history memory of F and CR
+    };
+
+    Strategy strategy = Strategy::CurrentToPBest1;
+    Adaptation adaptation = Adaptation::SHADE;
+
+    double F = 0.5;          // scale factor, or the initial mean when adaptive
+    double pBest = 0.1;      // fraction of the population pbest is drawn from
+    bool archive = true;     // keep replaced parents for x~_r2 (CurrentToPBest1)
+    double learningRate = 0.1; // JADE c
+    int memorySize = 6;      // SHADE H
+};
+
+// Differential evolution over a contiguous population matrix. Shares Config,
+// Fitness and Result with GeneticAlgorithm: populationSize is NP,
+// crossoverRate is CR (or its initial mean), mutationRate is unused. Each
+// generation builds every mutant into a row of the trial matrix, crosses it
+// in place with DifferentialEvolutionCrossover::binomialInto, then scores the
+// whole trial matrix in one batch, split over Config::threads workers.
+// Mutant genes outside the (per-gene) bounds are set midway between the
+// parent gene and the violated bound; Config::boundHandling is not used.
+// Histories have generations + 1 entries, like the GA, unless
+// Config::maxEvaluations stops the run first.
+class DifferentialEvolution {
+public:
+    explicit DifferentialEvolution(const Config& cfg, const DeOptions& options = DeOptions());
+    ~DifferentialEvolution();
+
+    Result run(const Fitness& fitness);
+    // Hands whole generations to the caller, e.g. for SIMD or GPU scoring
+    Result run(const BatchFitness& fitness);
+
+    void setCrossoverOperator(std::unique_ptr<DifferentialEvolutionCrossover> op);
+
+    const Config& config() const { return cfg_; }
+    const DeOptions& options() const { return options_; }
+    size_t evaluations() const { return evaluations_; }
+
+private:
+    Config cfg_;
+    DeOptions options_;
+    std::mt19937 rng_;
+    std::unique_ptr<DifferentialEvolutionCrossover> crossover_;
+    size_t evaluations_ = 0;
+
+    // Row-major NP x n matrices
+    std::vector<double> population_;
+    std::vector<double> trials_;
+    std::vector<double> archive_; // up to NP rows of replaced parents
+    size_t archiveSize_ = 0;
+    std::vector<double> fitness_;
+    std::vector<double> trialFitness_;
+    std::vector<double> lower_; // per-gene bounds of the run
+    std::vector<double> upper_;
+
+    // Per-individual control parameters of the current generation
+    std::vector<double> F_;
+    std::vector<double> CR_;
+
+    // Successful parameters of the current generation and their improvements
+    std::vector<double> goodF_;
+    std::vector<double> goodCR_;
+    std::vector<double> gains_;
+
+    // Adaptation state: JADE uses slot 0, SHADE the whole memory
+    std::vector<double> memoryF_;
+    std::vector<double> memoryCR_;
+    size_t memoryPos_ = 0;
+
+    std::vector<size_t> order_;
+    std::vector<std::vector<double>> scratch_; // one gene vector per worker
+
+    Result run_(const BatchFitness& fitness);
+    void sampleParameters_();
+    void makeTrials_(size_t best, size_t topCount);
+    void adapt_();
+};
+
+} // namespace ga
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+#include "ga/config.hpp"
+
+namespace ga {
+
+// Fitness of a bitstring of `length` bits packed 64 to a word: bit i is
+// (words[i / 64] >> (i % 64)) & 1, unused high bits of the last word are 0.
+// Higher is better; called concurrently when Config::threads is not 1.
+using BitFitness = std::function<double(const uint64_t* words, size_t length)>;
+
+struct EdaOptions {
+    enum class Algorithm {
+        UMDA,     // marginals set to the frequencies among the selected samples
+        PBIL,     // marginals moved towards those frequencies by learningRate
+        CompactGA // pairwise tournaments, the winner's differing bits shift p by 1/virtualPopulation
+    };
+    Algorithm algorithm = Algorithm::PBIL;
+
+    double selectionRatio = 0.5;  // UMDA/PBIL: share of each generation's samples selected
+    double learningRate = 0.1;    // PBIL
+    int virtualPopulation = 0;    // cGA population the update step stands for (0: Config::populationSize)
+
+    // Keep every marginal within [1/L, 1 - 1/L] so no bit fixes for good;
+    // ignored for L <= 2, where that range would leave nothing to learn
+    bool borders = true;
+};
+
+// Estimation-of-distribution algorithms over bitstrings. The model is one
+// probability per bit, so memory is O(L) plus the samples of a generation,
+// stored packed (O(N L / 64) words; two samples for the compact GA).
+//
+// Shares Config and Result with GeneticAlgorithm: dimension is the bit
+// count L, populationSize the samples drawn per generation (the compact GA
+// runs populationSize / 2 tournaments per generation), and generations,
+// maxEvaluations, seed and threads keep their meaning. Histories hold the
+// best and mean fitness of each generation's samples, generations + 1
+// entries unless the budget stops the run first; bestGenes are 0.0/1.0.
+//
+// Sampling draws counter-based 31-bit uniforms for a whole sample,
+// compares them against the marginals scaled to integer thresholds into a
+// byte mask, and packs eight mask bytes at a time into a word with one
+// multiply; each loop is branch-free over contiguous arrays so it
+// vectorises. UMDA and PBIL sample and evaluate a generation over
+// Config::threads workers, and the samples do not depend on the thread
+// count; the compact GA updates after every tournament, so it runs serially.
+class EDA {
+public:
+    explicit EDA(const Config& cfg, const EdaOptions& options = EdaOptions());
+
+    Result run(const BitFitness& fitness);
+    // Convenience: unpacks each sample into 0.0/1.0 genes
+    Result run(const Fitness& fitness);
+
+    const Config& config() const { return cfg_; }
+    const EdaOptions& options() const { return options_; }
+    // Marginal probabilities after the last run
+    const std::vector<double>& probabilities() const { return p_; }
+    size_t evaluations() const { return evaluations_; }
+
+private:
+    Config cfg_;
+    EdaOptions options_;
+    std::mt19937 rng_;
+
+    size_t length_ = 0;
+    size_t words_ = 0;
+    size_t evaluations_ = 0;
+
+    std::vector<double> p_;             // marginals
+    std::vector<uint32_t> threshold_;   // p scaled to [0, 2^31]
+    std::vector<uint64_t> samples_;     // N x words_
+    std::vector<double> fitness_;
+    std::vector<uint64_t> keys_;        // per-sample random stream keys
+    std::vector<std::vector<uint32_t>> uniforms_; // per worker, L draws
+    std::vector<std::vector<uint8_t>> masks_;      // per worker, L rounded up to 64 bytes
+    std::vector<uint32_t> counts_;      // ones per bit among the selected samples
+    std::vector<size_t> order_;
+    std::vector<uint64_t> best_;
+
+    void thresholds_();
+    void drawKeys_(size_t count);
+    void sample_(size_t index, size_t worker);
+    void update_(size_t selected);
+    void compete_(const uint64_t* winner, const uint64_t* loser, double step);
+    void clampMarginal_(double& p) const;
+};
+
+} // namespace ga
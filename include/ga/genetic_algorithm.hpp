@@ -5,6 +5,9 @@
 #include <utility>
 #include <vector>
 #include "ga/config.hpp"
+#include "ga/genome_hash.hpp"
+#include "ga/local_search.hpp"
+#include "selection-operator/elite_archive.h"
 
 // Forward declare operator base types from existing code
 class MutationOperator;
@@ -12,6 +15,8 @@ class CrossoverOperator;
 
 namespace ga {
 
+namespace detail { struct GeneMutation; }
+
 class GeneticAlgorithm {
 public:
     explicit GeneticAlgorithm(const Config& cfg);
@@ -19,10 +24,22 @@ public:
 
     // Run GA for provided fitness, return statistics
     Result run(const Fitness& fitness);
+    // Same loop for a sum of per-gene terms: each individual keeps its
+    // terms, and a child only evaluates the terms of loci where it differs
+    // from both parents (mutated or blended genes)
+    Result run(const SeparableFitness& fitness);
 
     // Access to operators for customization
     void setMutationOperator(std::unique_ptr<MutationOperator> op);
     void setCrossoverOperator(std::unique_ptr<CrossoverOperator> op);
+    // Refines the best individuals every options.interval generations with a
+    // bounded local search, in parallel over Config::threads. Its evaluations
+    // count towards Result::evaluations and Config::maxEvaluations.
+    void setLocalSearch(const LocalSearchOptions& options) { localSearch_ = options; }
+    // Looks every offspring up among the genomes of the current and the
+    // previous generation before scoring it; counts go to
+    // Result::duplicates and Result::evaluationsSaved
+    void setDuplicatePolicy(const DuplicateOptions& options);
 
     const Config& config() const { return cfg_; }
 
@@ -30,17 +47,43 @@ private:
     struct Individual {
         std::vector<double> genes;
         double fitness = 0.0;
+        std::vector<double> terms; // per-gene terms, separable runs only
+        double termSum = 0.0;
+        bool refined = false; // fitness from Baldwinian refinement, not from terms
     };
 
+    // Generations between exact re-summations of the separable terms
+    static constexpr int kResumInterval = 64;
+
     Config cfg_;
     std::mt19937 rng_;
 
     std::unique_ptr<MutationOperator> mutation_;
     std::unique_ptr<CrossoverOperator> crossover_;
+    LocalSearchOptions localSearch_;
+    DuplicateOptions duplicates_;
+    GenomeHashSet genomes_;
+    EliteArchive elites_;
+
+    // Per-gene bounds of the run (resolveBounds), read in place by the
+    // offspring pass, local search and a bounded crossover
+    std::vector<double> lower_;
+    std::vector<double> upper_;
 
-    std::vector<Individual> initPopulation_(const Fitness& f);
-    std::pair<Individual, Individual> crossoverPair_(const Individual& p1, const Individual& p2, const Fitness& f);
-    void mutate_(Individual& ind);
+    Result run_(const Fitness* fitness, const SeparableFitness* separable);
+    std::vector<Individual> initPopulation_(const Fitness* f, const SeparableFitness* sf);
+    void resumTerms_(Individual& ind, const SeparableFitness& f, bool evaluate);
+    void scoreSeparable_(Individual& child, const Individual& p1, const Individual& p2, const SeparableFitness& f);
+    // Fused offspring pass: writes clamp(mutate(source)) into child's genes,
+    // source being the crossover output already there or an uncrossed
+    // parent. With `terms` the same pass fills child's separable terms
+    // against p1/p2 and scores it.
+    void breed_(const detail::GeneMutation& mutation, const std::vector<double>& source, const Individual& p1,
+                const Individual& p2, Individual& child, const SeparableFitness* terms);
+    // Refines the top individuals of pop; returns the evaluations spent.
+    // Baldwinian runs record the best refined genes in `learned`.
+    size_t refineElites_(std::vector<Individual>& pop, std::vector<size_t>& idx, const Fitness& fitness,
+                         const SeparableFitness* separable, size_t remaining, Individual& learned);
 };
 
 // Convenience factories (implemented in .cpp using existing operators)
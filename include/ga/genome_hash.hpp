@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ga {
+
+// What an engine does with an offspring whose genome already exists in the
+// current or the previous generation
+struct DuplicateOptions {
+    enum class Policy {
+        Keep,     // evaluate it like any other child (no hashing)
+        Remutate, // mutate it again, up to `attempts` times, then Skip
+        Skip      // take the fitness of the existing copy without evaluating
+    };
+    Policy policy = Policy::Keep;
+
+    // Real genes match when they round to the same multiple of quantum;
+    // 0 compares them bitwise, which is exact for binary, integer and
+    // permutation genomes. With quantum > 0 a skipped duplicate inherits
+    // the fitness of a genome that may differ by up to quantum per gene.
+    double quantum = 0.0;
+    int attempts = 3;
+};
+
+// Set of genomes of a fixed dimension in a flat open-addressing table with
+// linear probing. It stores pointers to the caller's genes rather than
+// copies, so entries are only valid while those genes stay in place; the
+// engines rebuild it every generation. reset() keeps the table's storage.
+class GenomeHashSet {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    explicit GenomeHashSet(double quantum = 0.0) : quantum_(quantum) {}
+
+    // Empties the set and sizes it for `expected` genomes of `dimension` genes
+    void reset(size_t expected, size_t dimension);
+
+    uint64_t hash(const double* genes) const;
+    // Id of a stored genome equal to `genes`, or npos
+    size_t find(const double* genes, uint64_t hash) const;
+    void insert(const double* genes, uint64_t hash, size_t id);
+
+    size_t size() const { return size_; }
+    double quantum() const { return quantum_; }
+
+private:
+    struct Slot {
+        uint64_t hash = 0;
+        const double* genes = nullptr; // nullptr marks an empty slot
+        size_t id = 0;
+    };
+
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    size_t dimension_ = 0;
+    double quantum_;
+
+    uint64_t key_(double gene) const;
+    bool equal_(const double* a, const double* b) const;
+    void grow_();
+};
+
+} // namespace ga
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "crossover/linear_tree.h"
+#include "ga/gp_semantic_cache.hpp"
+
+namespace ga {
+
+// Column-major training data: columns[v][r] is variable v on row r
+struct GpDataset {
+    size_t rows = 0;
+    std::vector<std::vector<double>> columns;
+};
+
+// Stack-machine opcodes understood by the evaluator
+enum class GpOp : uint8_t {
+    Variable, Constant,
+    Add, Sub, Mul, Div,          // Div is protected: x / ~0 gives 1
+    Neg, Sin, Cos, Exp, Log, Sqrt // Log and Sqrt act on |x|, Log(~0) gives 0
+};
+
+struct GpInstruction {
+    GpOp op;
+    uint32_t variable = 0; // column for Variable
+    double value = 0.0;    // literal for Constant
+};
+
+// A tree compiled to postfix order
+struct GpProgram {
+    std::vector<GpInstruction> code;
+    size_t maxStack = 0;
+};
+
+// Evaluates GP trees over whole datasets.
+//
+// Trees are compiled to postfix programs; a program then runs over blocks of
+// kBlockRows rows, each instruction being one tight loop over a block held in
+// a reusable value stack. Loops over contiguous doubles let the compiler emit
+// SIMD code per opcode instead of interpreting the tree row by row.
+//
+// Symbols: "+", "-", "*", "/", "neg", "sin", "cos", "exp", "log", "sqrt",
+// variables "x0", "x1", ... (or names given to the constructor) and numeric
+// literals. Instances keep scratch buffers; use one per thread.
+class GpEvaluator {
+public:
+    static constexpr size_t kBlockRows = 256;
+
+    explicit GpEvaluator(const OpcodeTable& opcodes, std::vector<std::string> variableNames = {});
+
+    // Throws std::invalid_argument for unknown symbols or wrong arity
+    GpProgram compile(const LinearTree& tree);
+    void compileInto(const LinearTree& tree, GpProgram& program);
+
+    // Writes one output per dataset row into out
+    void evaluate(const GpProgram& program, const GpDataset& data, double* out);
+    void evaluate(const GpProgram& program, const GpDataset& data, std::vector<double>& out);
+
+    // Mean squared error against targets without materialising the outputs
+    double meanSquaredError(const GpProgram& program, const GpDataset& data, const std::vector<double>& targets);
+
+    // Evaluates a tree subtree by subtree, reusing any subtree output found in
+    // the cache and storing the ones it computes. For a crossover child whose
+    // parents were evaluated through the same cache, only the nodes between
+    // the crossover point and the root are recomputed.
+    void evaluate(const LinearTree& tree, const GpDataset& data, GpSemanticCache& cache,
+                  std::vector<double>& out);
+
+private:
+    struct Symbol {
+        bool resolved = false;
+        GpInstruction instruction{GpOp::Constant};
+        uint32_t arity = 0;
+    };
+
+    const OpcodeTable* opcodes_;
+    std::vector<std::string> variableNames_;
+    std::vector<Symbol> symbols_; // indexed by opcode, filled on first use
+    std::vector<double> stack_;   // maxStack * kBlockRows values
+    std::vector<uint64_t> hashes_; // per-node structural hashes for the cache
+
+    const Symbol& resolve_(Opcode opcode);
+    GpInstruction instructionFor_(const LinearNode& node);
+    const double* cachedNode_(const LinearTree& tree, const GpDataset& data, GpSemanticCache& cache, size_t index);
+    void runBlock_(const GpProgram& program, const GpDataset& data, size_t begin, size_t count);
+};
+
+} // namespace ga
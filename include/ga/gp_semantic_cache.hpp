@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace ga {
+
+// Bounded LRU cache of GP subtree outputs ("semantics") over one dataset.
+//
+// Keys are 64-bit structural hashes of subtrees, so identical subtrees in
+// different individuals share one entry. After subtree crossover nearly every
+// subtree of a child already exists in a parent, and only the nodes on the
+// path from the crossover point to the root have to be recomputed.
+//
+// The cache is bound to one dataset and one OpcodeTable; clear() it when
+// either changes. Entries handed out stay valid until the next trim(), so an
+// evaluation can hold several child outputs while inserting its own.
+class GpSemanticCache {
+public:
+    explicit GpSemanticCache(size_t maxBytes = size_t(256) << 20) : maxBytes_(maxBytes) {}
+
+    // Output vector for key, or nullptr; a hit marks the entry recently used
+    const double* find(uint64_t key);
+
+    // Storage for a new entry of `rows` values; the caller fills it
+    double* insert(uint64_t key, size_t rows);
+
+    // Evict least recently used entries until the byte budget is met
+    void trim();
+
+    void clear();
+
+    size_t bytes() const { return bytes_; }
+    size_t entries() const { return index_.size(); }
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+
+private:
+    struct Entry {
+        uint64_t key;
+        std::vector<double> values;
+    };
+
+    size_t maxBytes_;
+    size_t bytes_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+    std::list<Entry> lru_; // most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+};
+
+} // namespace ga
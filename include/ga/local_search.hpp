@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "ga/config.hpp"
+
+namespace ga {
+
+// Local refinement of real-valued genomes, used by GeneticAlgorithm to
+// polish its best individuals every few generations
+struct LocalSearchOptions {
+    enum class Method {
+        NelderMead, // simplex search with dimension-adapted coefficients; handles coupled variables
+        Coordinate  // adaptive coordinate search, O(1) work per evaluation; scales to large n
+    };
+    enum class Inheritance {
+        Lamarckian, // the refined genes replace the individual's genes
+        Baldwinian  // the individual keeps its genes but takes the refined fitness
+    };
+    Method method = Method::Coordinate;
+    Inheritance inheritance = Inheritance::Lamarckian;
+
+    int interval = 0;          // generations between refinements (0: disabled)
+    int elites = 1;            // best individuals refined each time
+    size_t evaluations = 100;  // budget per refined individual
+    double step = 0.05;        // initial step as a fraction of (upper - lower)
+};
+
+// Both searches maximise `fitness` starting from x (whose fitness is fx)
+// inside [lower, upper], leave the best point found in x and return its
+// fitness. Every fitness call takes one unit of `budget`; they stop when it
+// reaches zero or the steps shrink below 1e-12 of the range.
+double nelderMead(const Fitness& fitness, std::vector<double>& x, double fx,
+                  const std::vector<double>& lower, const std::vector<double>& upper,
+                  double step, size_t& budget);
+double coordinateSearch(const Fitness& fitness, std::vector<double>& x, double fx,
+                        const std::vector<double>& lower, const std::vector<double>& upper,
+                        double step, size_t& budget);
+
+// Runs the method selected in `options`. Nelder-Mead needs more than
+// x.size() evaluations to build its simplex; below that it falls back to
+// coordinate search.
+double refine(const LocalSearchOptions& options, const Fitness& fitness, std::vector<double>& x, double fx,
+              const std::vector<double>& lower, const std::vector<double>& upper, size_t& budget);
+
+} // namespace ga
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ga {
+
+// Niching turns raw fitnesses into niche-adjusted ones that any selection
+// operator can consume in their place, so a multimodal run keeps several
+// optima instead of converging on one
+struct NichingOptions {
+    enum class Method {
+        None,     // fitnesses pass through unchanged
+        Sharing,  // divide by the niche count sum_j sh(d_ij) (Goldberg & Richardson)
+        Clearing  // the best `capacity` of each niche keep their fitness, the rest are cleared (Petrowski)
+    };
+    Method method = Method::None;
+    double radius = 1.0;  // niche radius in genome units (Euclidean distance)
+    double alpha = 1.0;   // sharing kernel sh(d) = 1 - (d / radius)^alpha
+    int capacity = 1;     // clearing winners per niche
+    int threads = 1;      // 0: one per hardware thread
+    unsigned seed = 1;    // random projections used above three dimensions
+};
+
+// Computes shared fitness or clearing winners for a population stored
+// row-major (count x dimension). Genomes are projected onto at most three
+// axes: the coordinates themselves for small dimensions, otherwise random
+// unit vectors. A projection never lengthens a distance, so a grid with
+// cells of the niche radius over the projected points yields every pair
+// within the radius from the 3^k cells around a point; exact distances are
+// only computed for those candidates. Building the grid is O(N log N) and
+// the neighbour queries run in parallel. Storage is kept between calls.
+class NichingStage {
+public:
+    // Throws std::invalid_argument for a non-positive radius or alpha or a
+    // capacity below one
+    explicit NichingStage(const NichingOptions& options);
+
+    // Writes the adjusted fitnesses into out[0..count); out may not alias
+    // fitness. Sharing maps f to b + (f - b) / m with b = min(0, min f), which
+    // is the classic f / m for non-negative fitnesses. Cleared individuals
+    // get the lowest fitness of the population.
+    void apply(const double* genes, size_t count, size_t dimension, const double* fitness, double* out);
+
+    // Exact distance computations in the last apply(), for profiling
+    size_t distanceChecks() const { return checks_; }
+    const NichingOptions& options() const { return options_; }
+
+private:
+    static constexpr size_t kMaxAxes = 3;
+
+    NichingOptions options_;
+    size_t dimension_ = 0;
+    size_t axes_ = 0;
+    std::vector<double> directions_;  // axes_ x dimension_, empty when axes are coordinates
+    std::vector<double> projected_;   // count x axes_
+    std::vector<uint64_t> cells_;     // cell key per individual
+    std::vector<size_t> order_;       // individuals sorted by cell key
+    std::vector<uint64_t> sortedCells_;
+    size_t checks_ = 0;
+
+    // Clearing: neighbour lists in compressed rows, built per worker
+    std::vector<size_t> offsets_;
+    std::vector<size_t> neighbours_;
+    std::vector<std::vector<size_t>> workerNeighbours_;
+    std::vector<size_t> rank_;
+    std::vector<char> cleared_;
+
+    void project_(const double* genes, size_t count, size_t dimension);
+    template <class Visit>
+    size_t visitNeighbours_(const double* genes, size_t i, Visit&& visit) const;
+    void share_(const double* genes, size_t count, const double* fitness, double* out, int threads);
+    void clear_(const double* genes, size_t count, const double* fitness, double* out, int threads);
+};
+
+} // namespace ga
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+#include "ga/config.hpp"
+#include "ga/vp_tree.hpp"
+
+class MutationOperator;
+class CrossoverOperator;
+
+namespace ga {
+
+// Maps a genome to the behaviour novelty is measured in, e.g. the final
+// position of a simulated robot. Every call must return the same length.
+// With Config::threads other than 1 it is called concurrently.
+using BehaviourDescriptor = std::function<std::vector<double>(const std::vector<double>& genes)>;
+
+struct NoveltyOptions {
+    size_t neighbours = 15;       // k: novelty is the mean distance to the k nearest behaviours
+    size_t addPerGeneration = 4;  // most novel individuals copied into the archive each generation
+    int tournamentSize = 3;       // parents are drawn by tournaments on novelty
+
+    // Bounded archive: once it holds `capacity` behaviours every admission
+    // evicts one, the oldest or a random member (0: unbounded)
+    enum class Eviction { Oldest, Random };
+    size_t capacity = 0;
+    Eviction eviction = Eviction::Oldest;
+};
+
+// Novelty search (Lehman & Stanley) with the GeneticAlgorithm's Config,
+// operators and Result. Selection ignores the objective: an individual's
+// score is its mean distance in behaviour space to the k nearest of the
+// rest of the population and the archive. The population is indexed by a
+// VP-tree built each generation and the archive by an incremental
+// VpForest, so scoring costs O(N log(N + A)) distance computations rather
+// than O(N (N + A)); the queries run over Config::threads workers.
+//
+// The objective is still evaluated for every genome and drives Result:
+// bestGenes/bestFitness are the best objective found, the histories hold
+// the best and mean objective per generation, and maxEvaluations counts
+// objective calls. eliteRatio keeps the most novel individuals.
+class NoveltySearch {
+public:
+    explicit NoveltySearch(const Config& cfg, const NoveltyOptions& options = NoveltyOptions());
+    ~NoveltySearch();
+
+    Result run(const Fitness& objective, const BehaviourDescriptor& behaviour);
+
+    void setMutationOperator(std::unique_ptr<MutationOperator> op);
+    void setCrossoverOperator(std::unique_ptr<CrossoverOperator> op);
+
+    const Config& config() const { return cfg_; }
+    const NoveltyOptions& options() const { return options_; }
+
+    // Archive of the last run
+    const VpForest& archive() const { return archive_; }
+    // Novelty of the final population
+    const std::vector<double>& novelty() const { return novelty_; }
+
+private:
+    Config cfg_;
+    NoveltyOptions options_;
+    std::mt19937 rng_;
+
+    std::unique_ptr<MutationOperator> mutation_;
+    std::unique_ptr<CrossoverOperator> crossover_;
+
+    // Per-gene bounds of the run (resolveBounds)
+    std::vector<double> lower_;
+    std::vector<double> upper_;
+
+    size_t behaviourDimension_ = 0;
+    std::vector<double> behaviours_;      // N x behaviourDimension_, row i for individual i
+    std::vector<double> novelty_;
+    VpTree population_;
+    VpForest archive_;
+    std::vector<size_t> archiveIds_;      // archive members in admission order (ring)
+    size_t archiveNext_ = 0;
+    std::vector<std::vector<Neighbour>> heaps_; // one per worker
+    std::vector<size_t> ids_;
+
+    void score_();
+    void admit_();
+};
+
+} // namespace ga
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+#include "ga/config.hpp"
+#include "selection-operator/base_selection.h"
+
+class MutationOperator;
+class CrossoverOperator;
+
+namespace ga {
+
+// Vector-valued fitness; every objective is maximised, like ga::Fitness
+using MultiFitness = std::function<std::vector<double>(const std::vector<double>&)>;
+
+struct ParetoResult {
+    std::vector<MultiObjectiveIndividual> front; // non-dominated members of the final population
+    std::vector<size_t> frontSizeHistory;        // size of the first front per generation
+    size_t evaluations = 0;
+};
+
+// Non-dominated sorting of n points with m objectives stored row-major in
+// `objectives` (all maximised). Writes rank[i] (0 = non-dominated) and
+// returns the number of fronts. Two and three objectives use sweeps with a
+// binary search over fronts, O(n log n) and O(n log^2 n); more objectives
+// use Best Order Sort, which only compares a point against points already
+// ranked ahead of it in some objective ordering.
+int nonDominatedSort(const double* objectives, size_t n, size_t m, std::vector<int>& rank);
+
+// Convenience overload filling MultiObjectiveIndividual::rank
+int nonDominatedSort(std::vector<MultiObjectiveIndividual>& pop);
+
+// Crowding distance of the members of one front (boundary points get +inf)
+void crowdingDistance(const double* objectives, size_t m, const std::vector<size_t>& front,
+                      std::vector<double>& distance);
+
+// NSGA-II (Deb et al. 2002): elitist (mu + lambda) survival by front then
+// crowding distance, with crowded binary tournament for mating. Shares
+// ga::Config with GeneticAlgorithm; populationSize is the parent count.
+// Each generation's offspring are bred first and then scored in one batch
+// over Config::threads workers, so the fitness must be thread-safe when
+// threads is not 1; results do not depend on the thread count. The run
+// stops early once Config::maxEvaluations is spent.
+class NSGA2 {
+public:
+    explicit NSGA2(const Config& cfg);
+    ~NSGA2();
+
+    ParetoResult run(const MultiFitness& fitness);
+
+    void setMutationOperator(std::unique_ptr<MutationOperator> op);
+    void setCrossoverOperator(std::unique_ptr<CrossoverOperator> op);
+
+    const Config& config() const { return cfg_; }
+
+private:
+    Config cfg_;
+    std::mt19937 rng_;
+
+    std::unique_ptr<MutationOperator> mutation_;
+    std::unique_ptr<CrossoverOperator> crossover_;
+
+    std::vector<double> lower_;
+    std::vector<double> upper_;
+    size_t objectiveCount_ = 0;
+
+    // Parents occupy [0, N) and offspring [N, 2N) of every buffer below
+    std::vector<MultiObjectiveIndividual> pool_;
+    std::vector<double> objectives_; // row-major copy of pool_ objectives
+    std::vector<int> rank_;
+    std::vector<double> crowding_;
+    std::vector<size_t> order_;      // pool indices grouped by front
+    std::vector<size_t> front_;
+    std::vector<double> frontDistance_;
+    std::vector<char> selected_;
+    MultiObjectiveIndividual spare_;  // second child of an odd tail
+
+    size_t tournament_(size_t n);
+    // Scores pool_[first, first + count) and packs their objectives
+    void evaluate_(size_t first, size_t count, const MultiFitness& fitness, size_t& evaluations);
+    void rankAndCrowd_(size_t count);
+    void survive_(size_t n);
+};
+
+} // namespace ga
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace ga {
+
+// Worker count for a Config::threads value: 0 means one per hardware thread
+inline int resolveThreads(int threads) {
+    if (threads > 0) return threads;
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? static_cast<int>(hw) : 1;
+}
+
+// Splits [0, count) into one contiguous chunk per worker and calls
+// body(begin, end, worker) for each, the calling thread taking chunk 0.
+// Workers are started per call, so use it for batches that outweigh a
+// thread start (a generation of fitness evaluations, not a single one).
+// The first exception thrown by any chunk is rethrown after all joined.
+template <class Body>
+void parallelFor(size_t count, int threads, Body&& body) {
+    const size_t workers = std::min(count, static_cast<size_t>(std::max(1, threads)));
+    if (workers <= 1) {
+        if (count > 0) body(size_t{0}, count, size_t{0});
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(workers);
+    auto chunk = [&](size_t w) {
+        const size_t begin = count * w / workers;
+        const size_t end = count * (w + 1) / workers;
+        try {
+            body(begin, end, w);
+        } catch (...) {
+            errors[w] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w) pool.emplace_back(chunk, w);
+    chunk(0);
+    for (auto& t : pool) t.join();
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+} // namespace ga
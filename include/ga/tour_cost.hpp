@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "mutation/base_mutation.h"
+
+namespace ga {
+
+// Length of a closed tour over a cached distance matrix, with delta
+// evaluation of the edits reported by the permutation mutators. A mutated
+// child's cost is then parentCost + delta(child, edit): O(1) for swaps,
+// moves and (on symmetric matrices) reversals, instead of O(n).
+//
+// The matrix takes n^2 doubles; distances[a * n + b] is the cost of a -> b.
+class TourCost {
+public:
+    TourCost(std::vector<double> distances, size_t cities);
+
+    // Euclidean distances between points (x[i], y[i])
+    static TourCost euclidean(const std::vector<double>& x, const std::vector<double>& y);
+
+    size_t cities() const { return cities_; }
+    bool symmetric() const { return symmetric_; }
+    double distance(int from, int to) const { return distances_[static_cast<size_t>(from) * cities_ + to]; }
+
+    // Full O(n) length of the closed tour
+    double operator()(const std::vector<int>& tour) const;
+
+    // Cost change made by `edit`, given the tour after it. Reversals on an
+    // asymmetric matrix cost O(length of the range). A scramble cannot be
+    // undone from its result and throws std::invalid_argument; use the
+    // overload that also takes the tour before the edit.
+    double delta(const std::vector<int>& after, const PermutationEdit& edit) const;
+
+    // As above, reading the previous order from `before`, which also makes
+    // scrambles O(length of the range)
+    double delta(const std::vector<int>& before, const std::vector<int>& after, const PermutationEdit& edit) const;
+
+private:
+    std::vector<double> distances_;
+    size_t cities_ = 0;
+    bool symmetric_ = true;
+
+    double moveDelta_(const std::vector<int>& after, size_t from, size_t to) const;
+};
+
+} // namespace ga
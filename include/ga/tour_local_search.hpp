@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+#include "ga/tour_cost.hpp"
+
+namespace ga {
+
+// A tour improvement heuristic usable as a memetic stage. improve() must be
+// safe to call concurrently on different tours.
+class TourImprover {
+public:
+    virtual ~TourImprover() = default;
+
+    // Improves `tour` (whose current cost is `cost`) in place and returns the
+    // new cost. Each candidate move it prices takes one unit of `budget`;
+    // it stops when the budget reaches zero.
+    virtual double improve(std::vector<int>& tour, double cost, size_t& budget) const = 0;
+};
+
+// 2-opt and Or-opt local search on a symmetric TourCost. Candidate moves
+// only pair a city with its nearest neighbours (lists built once), and
+// don't-look bits keep cities whose surroundings have not changed out of
+// the work queue, so a pass over an already good tour is close to O(n).
+class TourLocalSearch : public TourImprover {
+public:
+    struct Options {
+        bool twoOpt = true;
+        bool orOpt = true;
+        size_t neighbours = 10;   // candidate list length per city
+        size_t maxSegment = 3;    // longest segment Or-opt moves
+    };
+
+    // `cost` must outlive the search; throws std::invalid_argument when the
+    // matrix is asymmetric
+    explicit TourLocalSearch(const TourCost& cost);
+    TourLocalSearch(const TourCost& cost, const Options& options);
+
+    double improve(std::vector<int>& tour, double cost, size_t& budget) const override;
+
+    const Options& options() const { return options_; }
+
+private:
+    const TourCost* cost_;
+    Options options_;
+    size_t k_ = 0;
+    std::vector<int> neighbours_; // cities x k_, nearest first
+};
+
+// Memetic pipeline stage: after variation, improves a random fraction of
+// the offspring with a TourImprover, in parallel, under an evaluation
+// budget. Budgets are split before the workers start, so a seeded run does
+// not depend on the thread count.
+class MemeticStage {
+public:
+    struct Options {
+        double fraction = 0.2;   // share of the offspring improved per apply()
+        size_t movesPerTour = 0; // move evaluations per tour (0: run to a local optimum)
+        size_t totalBudget = 0;  // move evaluations over the stage's lifetime (0: unlimited)
+        int threads = 1;         // 0: one per hardware thread
+    };
+
+    MemeticStage(std::unique_ptr<TourImprover> improver, const Options& options);
+
+    // Improves a random subset of tours in place and updates their costs;
+    // returns how many got cheaper
+    size_t apply(std::vector<std::vector<int>>& tours, std::vector<double>& costs, std::mt19937& rng);
+
+    size_t evaluationsUsed() const { return used_; }
+    bool exhausted() const { return options_.totalBudget > 0 && used_ >= options_.totalBudget; }
+    const Options& options() const { return options_; }
+
+private:
+    std::unique_ptr<TourImprover> improver_;
+    Options options_;
+    size_t used_ = 0;
+    std::vector<size_t> chosen_;
+    std::vector<size_t> spent_;
+    std::vector<char> improved_;
+};
+
+} // namespace ga
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ga {
+
+struct Neighbour {
+    double distance;
+    size_t id;
+};
+
+// Vantage-point tree over rows of a caller-owned point matrix (Euclidean
+// distance), passed to every call so the matrix may move between them.
+// The tree is laid out implicitly in one id array: the range [lo, hi) has
+// its vantage point at lo, the points no further than radius[lo] in the
+// lower half of the rest and the others in the upper half, so it needs no
+// node structure and builds in O(n log n).
+class VpTree {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Indexes the given rows of points (row-major, `dimension` columns)
+    void build(const double* points, size_t dimension, const size_t* ids, size_t count);
+    void clear();
+
+    // Offers the tree's points to `heap`, a max-heap on distance holding at
+    // most k entries (std::push_heap order), skipping `exclude` and ids
+    // flagged in `removed`. Results are exact.
+    void search(const double* points, const double* query, size_t k, std::vector<Neighbour>& heap,
+                size_t exclude = npos, const std::vector<char>* removed = nullptr) const;
+
+    size_t size() const { return ids_.size(); }
+    const std::vector<size_t>& ids() const { return ids_; }
+
+private:
+    size_t dimension_ = 0;
+    std::vector<size_t> ids_;
+    std::vector<double> radius_;
+    std::vector<Neighbour> work_; // build scratch
+
+    double distance_(const double* points, const double* a, size_t id) const;
+    void build_(const double* points, size_t lo, size_t hi, uint64_t& state);
+    void search_(const double* points, size_t lo, size_t hi, const double* query, size_t k,
+                 std::vector<Neighbour>& heap, size_t exclude, const std::vector<char>* removed) const;
+};
+
+// Incremental exact nearest-neighbour index built from static VP-trees
+// (Bentley & Saxe's logarithmic method): new points wait in a small buffer
+// that is scanned linearly, a full buffer is merged with the trees of
+// equal size into one tree of twice the size, so an insertion costs
+// O(log^2 n) amortised and a query visits O(log n) trees. Erased points are
+// skipped until they make up half the index, which triggers a rebuild that
+// also frees their ids for reuse, so a bounded archive keeps bounded
+// storage.
+class VpForest {
+public:
+    explicit VpForest(size_t dimension = 0) : dimension_(dimension) {}
+
+    // Empties the index and sets the point dimension
+    void reset(size_t dimension);
+
+    // Copies the point in and returns its id
+    size_t insert(const double* point);
+    void erase(size_t id);
+
+    // Appends the k nearest live points to `heap` as VpTree::search does
+    void search(const double* query, size_t k, std::vector<Neighbour>& heap) const;
+
+    size_t size() const { return live_; }
+    size_t dimension() const { return dimension_; }
+    const double* point(size_t id) const { return &points_[id * dimension_]; }
+
+private:
+    // Points buffered before they are put into a tree
+    static constexpr size_t kBuffer = 32;
+
+    size_t dimension_;
+    std::vector<double> points_;  // id x dimension_
+    std::vector<char> removed_;
+    std::vector<size_t> free_;    // ids of erased points no tree refers to
+    size_t live_ = 0;
+    size_t erased_ = 0;           // erased ids still held by trees or the buffer
+    std::vector<size_t> buffer_;
+    std::vector<VpTree> trees_;   // trees_[l] is empty or holds kBuffer * 2^l ids
+    std::vector<size_t> carry_;
+
+    void addToTrees_(std::vector<size_t>& ids);
+    void rebuild_();
+};
+
+} // namespace ga
@@ -4,9 +4,9 @@ MutationOperator::MutationOperator(const std::string& name, unsigned seed)
     : rng(seed), uniform_dist(0.0, 1.0), normal_dist(0.0, 1.0), operator_name(name) {
 }
 
-void MutationOperator::validateProbability(double pm, const std::string& methodName) const {
+void MutationOperator::validateProbability(double pm, const char* methodName) const {
     if (pm < 0.0 || pm > 1.0) {
-        throw InvalidParameterException(methodName + " - probability must be in [0,1], got: " + std::to_string(pm));
+        throw InvalidParameterException(std::string(methodName) + " - probability must be in [0,1], got: " + std::to_string(pm));
     }
 }
 
@@ -1,6 +1,7 @@
 #ifndef BASE_MUTATION_H
 #define BASE_MUTATION_H
 
+#include <cstdint>
 #include <vector>
 #include <random>
 #include <string>
@@ -12,6 +13,23 @@ using RealVector = std::vector<double>;
 using IntVector = std::vector<int>;
 using Permutation = std::vector<int>;
 
+/**
+ * @brief The edit a permutation mutator applied, so an objective can update
+ * a cached cost from the few positions involved instead of re-evaluating
+ */
+struct PermutationEdit {
+    enum class Kind {
+        None,     ///< Permutation unchanged
+        Swap,     ///< Elements at first and second exchanged
+        Reverse,  ///< Positions first..second (inclusive) reversed
+        Move,     ///< Element at first removed and reinserted at second
+        Scramble  ///< Positions first..second (inclusive) shuffled
+    };
+    Kind kind = Kind::None;
+    size_t first = 0;
+    size_t second = 0;
+};
+
 // Base mutation operator class
 class MutationOperator {
 public:
@@ -48,9 +66,17 @@ protected:
     std::string operator_name;
     
     // Helper methods
-    void validateProbability(double pm, const std::string& methodName) const;
+    void validateProbability(double pm, const char* methodName) const;
     void validateBounds(const std::vector<double>& lower, const std::vector<double>& upper) const;
     
+    // Draws the two stream keys of one population-level (mutateBatch) call
+    void batchKeys(uint32_t& key1, uint32_t& key2) const {
+        key1 = static_cast<uint32_t>(rng());
+        key2 = static_cast<uint32_t>(rng());
+    }
+    
+    std::vector<double> batch_uniforms_; // per-row uniforms of mutateBatch()
+    
 public:
     explicit MutationOperator(const std::string& name = "MutationOperator", unsigned seed = std::random_device{}());
     virtual ~MutationOperator() = default;
@@ -1,4 +1,5 @@
 #include "gaussian_mutation.h"
+#include "common/recombination_kernels.h"
 #include <algorithm>
 
 // ============================================================================
@@ -36,3 +37,79 @@ void GaussianMutation::mutate(std::vector<double>& chromosome, double pm, double
         }
     }
 }
+
+// ============================================================================
+// POPULATION-LEVEL GAUSSIAN MUTATION
+// ============================================================================
+
+using recombination_kernels::blend;
+using recombination_kernels::lessThan;
+
+namespace {
+
+// z[0..2 half) from the uniform halves u1 and u2
+void fillNormals(const double* u1, const double* u2, double* __restrict z, size_t half) {
+    for (size_t k = 0; k < half; ++k) {
+        recombination_kernels::normalPair(u1[k], u2[k], z[k], z[half + k]);
+    }
+}
+
+// Genes whose mask uniform is below rate move by sigma z and are clamped;
+// the others are blended back unchanged
+void perturbRow(double* __restrict genes, const double* u, const double* z, const double* lower,
+                const double* upper, size_t n, double rate, double sigma) {
+    for (size_t i = 0; i < n; ++i) {
+        const double moved = std::min(upper[i], std::max(lower[i], genes[i] + sigma * z[i]));
+        genes[i] = blend(lessThan(u[i], rate), moved, genes[i]);
+    }
+}
+
+} // namespace
+
+void GaussianMutation::prepareBatch(double pm, double sigma, const std::vector<double>& lowerBounds,
+                                    const std::vector<double>& upperBounds) {
+    validateProbability(pm, "gaussianMutation");
+    validateBounds(lowerBounds, upperBounds);
+    if (sigma <= 0.0) {
+        throw InvalidParameterException("Sigma must be positive, got: " + std::to_string(sigma));
+    }
+    
+    batch_rate_ = pm;
+    batch_sigma_ = sigma;
+    batch_lower_ = lowerBounds.data();
+    batch_upper_ = upperBounds.data();
+    batch_dimension_ = lowerBounds.size();
+    batch_ready_ = true;
+}
+
+void GaussianMutation::mutateBatch(double* population, size_t rows, size_t dimension) {
+    if (!batch_ready_ || dimension != batch_dimension_) {
+        throw InvalidParameterException("mutateBatch needs prepareBatch() with bounds of length " +
+                                        std::to_string(dimension));
+    }
+    
+    // Per row, from its own sub-stream: dimension mask uniforms, then two
+    // halves feeding Box-Muller
+    const size_t half = (dimension + 1) / 2;
+    const size_t stride = dimension + 2 * half;
+    batch_uniforms_.resize(stride);
+    batch_normals_.resize(2 * half);
+    double* u = batch_uniforms_.data();
+    double* z = batch_normals_.data();
+    
+    uint32_t key1, key2;
+    batchKeys(key1, key2);
+    const double rate = batch_rate_;
+    size_t hits = 0;
+    for (size_t r = 0; r < rows; ++r) {
+        recombination_kernels::fillUniform(u, stride, 0, key1, recombination_kernels::streamKey(key2, r));
+        fillNormals(u + dimension, u + dimension + half, z, half);
+        // Mutated genes counted from the sign bit of u - rate; a bool sum would stay scalar
+        for (size_t i = 0; i < dimension; ++i) hits += recombination_kernels::bitsOf(u[i] - rate) >> 63;
+        perturbRow(population + r * dimension, u, z, batch_lower_, batch_upper_, dimension, rate,
+                   batch_sigma_);
+    }
+    
+    stats.totalMutations += rows;
+    stats.successfulMutations += hits;
+}
@@ -20,6 +20,43 @@ public:
     void mutate(std::vector<double>& chromosome, double pm, double sigma,
                const std::vector<double>& lowerBounds,
                const std::vector<double>& upperBounds) const;
+    
+    /**
+     * @brief Validate the parameters of mutateBatch() once, at setup time
+     * @param pm Mutation probability per gene
+     * @param sigma Standard deviation for Gaussian perturbation
+     * @param lowerBounds Lower bounds for each gene
+     * @param upperBounds Upper bounds for each gene
+     * @throws InvalidParameterException if parameters are invalid
+     *
+     * The bounds are kept as views and must stay alive and unchanged until
+     * the next prepareBatch().
+     */
+    void prepareBatch(double pm, double sigma, const std::vector<double>& lowerBounds,
+                      const std::vector<double>& upperBounds);
+    
+    /**
+     * @brief Gaussian mutation of every row of a row-major population matrix
+     * @param population rows x dimension genes, mutated in place
+     * @param rows Number of chromosomes
+     * @param dimension Genes per chromosome; must match prepareBatch()
+     * @throws InvalidParameterException if prepareBatch() was not called for this dimension
+     *
+     * One streaming pass over the matrix: each row's mask and normal uniforms
+     * come from one counter-based hash fill, the normals from branch-free
+     * Box-Muller, and genes are perturbed, clamped and blended in under the
+     * mask, so every gene loop vectorises. Mutated genes are clamped like mutate().
+     */
+    void mutateBatch(double* population, size_t rows, size_t dimension);
+
+private:
+    double batch_rate_ = 0.0;
+    double batch_sigma_ = 0.0;
+    const double* batch_lower_ = nullptr;
+    const double* batch_upper_ = nullptr;
+    size_t batch_dimension_ = 0;
+    bool batch_ready_ = false;
+    std::vector<double> batch_normals_;
 };
 
 #endif // GAUSSIAN_MUTATION_H
@@ -6,7 +6,13 @@ InsertMutation::InsertMutation(unsigned int seed) : MutationOperator("InsertMuta
 }
 
 void InsertMutation::mutate(std::vector<int>& permutation, double pm) const {
+    PermutationEdit edit;
+    mutate(permutation, pm, edit);
+}
+
+void InsertMutation::mutate(std::vector<int>& permutation, double pm, PermutationEdit& edit) const {
     validateProbability(pm, "InsertMutation::mutate");
+    edit = PermutationEdit();
     
     if (permutation.size() < 2) {
         // Cannot perform insert mutation on permutations with less than 2 elements
@@ -18,7 +24,7 @@ void InsertMutation::mutate(std::vector<int>& permutation, double pm) const {
     try {
         // Apply mutation based on probability
         if (uniform_dist(rng) < pm) {
-            performInsert(permutation);
+            edit = performInsert(permutation);
             stats.successfulMutations++;
         }
     } catch (const std::exception& e) {
@@ -27,7 +33,7 @@ void InsertMutation::mutate(std::vector<int>& permutation, double pm) const {
     }
 }
 
-void InsertMutation::performInsert(std::vector<int>& permutation) const {
+PermutationEdit InsertMutation::performInsert(std::vector<int>& permutation) const {
     size_t size = permutation.size();
     
     // Select random element to move
@@ -39,7 +45,7 @@ void InsertMutation::performInsert(std::vector<int>& permutation) const {
     
     // If same position, no mutation occurs
     if (fromIndex == toIndex) {
-        return;
+        return PermutationEdit();
     }
     
     // Store the element to move
@@ -59,4 +65,5 @@ void InsertMutation::performInsert(std::vector<int>& permutation) const {
         }
         permutation[toIndex] = element;
     }
+    return {PermutationEdit::Kind::Move, fromIndex, toIndex};
 }
@@ -27,6 +27,12 @@ public:
      */
     void mutate(std::vector<int>& permutation, double pm) const;
 
+    /**
+     * @brief Insert mutation reporting the move
+     * @param edit Set to Move(from, to), or None when nothing changed
+     */
+    void mutate(std::vector<int>& permutation, double pm, PermutationEdit& edit) const;
+
     /**
      * @brief Get the name of this mutation operator
      * @return String name of the operator
@@ -46,7 +52,7 @@ private:
      * @brief Perform single insert operation
      * @param permutation The permutation to modify
      */
-    void performInsert(std::vector<int>& permutation) const;
+    PermutationEdit performInsert(std::vector<int>& permutation) const;
 };
 
 #endif // INSERT_MUTATION_H
@@ -6,7 +6,13 @@
 // ============================================================================
 
 void InversionMutation::mutate(std::vector<int>& permutation, double pm) const {
+    PermutationEdit edit;
+    mutate(permutation, pm, edit);
+}
+
+void InversionMutation::mutate(std::vector<int>& permutation, double pm, PermutationEdit& edit) const {
     validateProbability(pm, "inversionMutation");
+    edit = PermutationEdit();
     
     stats.totalMutations++;
     
@@ -22,6 +28,9 @@ void InversionMutation::mutate(std::vector<int>& permutation, double pm) const {
         // Reverse the subsequence
         std::reverse(permutation.begin() + start, 
                     permutation.begin() + end + 1);
+        if (start < end) {
+            edit = {PermutationEdit::Kind::Reverse, start, end};
+        }
         
         stats.successfulMutations++;
     }
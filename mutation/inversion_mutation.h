@@ -14,6 +14,12 @@ public:
      * @param pm Mutation probability
      */
     void mutate(std::vector<int>& permutation, double pm) const;
+
+    /**
+     * @brief Inversion mutation reporting the reversed range
+     * @param edit Set to Reverse(start, end), or None when nothing changed
+     */
+    void mutate(std::vector<int>& permutation, double pm, PermutationEdit& edit) const;
 };
 
 #endif // INVERSION_MUTATION_H
@@ -6,7 +6,13 @@ ScrambleMutation::ScrambleMutation(unsigned int seed) : MutationOperator("Scramb
 }
 
 void ScrambleMutation::mutate(std::vector<int>& permutation, double pm) const {
+    PermutationEdit edit;
+    mutate(permutation, pm, edit);
+}
+
+void ScrambleMutation::mutate(std::vector<int>& permutation, double pm, PermutationEdit& edit) const {
     validateProbability(pm, "ScrambleMutation::mutate");
+    edit = PermutationEdit();
     
     if (permutation.size() < 2) {
         // Cannot perform scramble mutation on permutations with less than 2 elements
@@ -18,7 +24,7 @@ void ScrambleMutation::mutate(std::vector<int>& permutation, double pm) const {
     try {
         // Apply mutation based on probability
         if (uniform_dist(rng) < pm) {
-            performScramble(permutation);
+            edit = performScramble(permutation);
             stats.successfulMutations++;
         }
     } catch (const std::exception& e) {
@@ -27,7 +33,7 @@ void ScrambleMutation::mutate(std::vector<int>& permutation, double pm) const {
     }
 }
 
-void ScrambleMutation::performScramble(std::vector<int>& permutation) const {
+PermutationEdit ScrambleMutation::performScramble(std::vector<int>& permutation) const {
     size_t size = permutation.size();
     
     // Select two random points to define the scramble region
@@ -48,7 +54,7 @@ void ScrambleMutation::performScramble(std::vector<int>& permutation) const {
             point1--;
         } else {
             // Single element, no scrambling possible
-            return;
+            return PermutationEdit();
         }
     }
     
@@ -56,4 +62,5 @@ void ScrambleMutation::performScramble(std::vector<int>& permutation) const {
     std::shuffle(permutation.begin() + point1, 
                  permutation.begin() + point2 + 1, 
                  rng);
+    return {PermutationEdit::Kind::Scramble, point1, point2};
 }
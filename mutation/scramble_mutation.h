@@ -27,6 +27,12 @@ public:
      */
     void mutate(std::vector<int>& permutation, double pm) const;
 
+    /**
+     * @brief Scramble mutation reporting the shuffled range
+     * @param edit Set to Scramble(start, end), or None when nothing changed
+     */
+    void mutate(std::vector<int>& permutation, double pm, PermutationEdit& edit) const;
+
     /**
      * @brief Get the name of this mutation operator
      * @return String name of the operator
@@ -44,7 +50,7 @@ private:
      * @brief Perform single scramble operation
      * @param permutation The permutation to modify
      */
-    void performScramble(std::vector<int>& permutation) const;
+    PermutationEdit performScramble(std::vector<int>& permutation) const;
 };
 
 #endif // SCRAMBLE_MUTATION_H
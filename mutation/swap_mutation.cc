@@ -6,7 +6,13 @@
 // ============================================================================
 
 void SwapMutation::mutate(std::vector<int>& permutation, double pm) const {
+    PermutationEdit edit;
+    mutate(permutation, pm, edit);
+}
+
+void SwapMutation::mutate(std::vector<int>& permutation, double pm, PermutationEdit& edit) const {
     validateProbability(pm, "swapMutation");
+    edit = PermutationEdit();
     
     if (permutation.empty()) {
         return;
@@ -28,6 +34,7 @@ void SwapMutation::mutate(std::vector<int>& permutation, double pm) const {
         
         if (pos1 != pos2) {
             std::swap(permutation[pos1], permutation[pos2]);
+            edit = {PermutationEdit::Kind::Swap, std::min(pos1, pos2), std::max(pos1, pos2)};
             stats.successfulMutations++;
         }
     }
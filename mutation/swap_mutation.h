@@ -14,6 +14,12 @@ public:
      * @param pm Mutation probability
      */
     void mutate(std::vector<int>& permutation, double pm) const;
+
+    /**
+     * @brief Swap mutation reporting the swapped positions
+     * @param edit Set to Swap(i, j), or None when nothing changed
+     */
+    void mutate(std::vector<int>& permutation, double pm, PermutationEdit& edit) const;
 };
 
 #endif // SWAP_MUTATION_H
@@ -1,4 +1,5 @@
 #include "uniform_mutation.h"
+#include "common/recombination_kernels.h"
 
 // ============================================================================
 // UNIFORM MUTATION IMPLEMENTATION
@@ -25,3 +26,63 @@ void UniformMutation::mutate(std::vector<double>& chromosome, double pm,
         }
     }
 }
+
+// ============================================================================
+// POPULATION-LEVEL UNIFORM MUTATION
+// ============================================================================
+
+using recombination_kernels::blend;
+using recombination_kernels::lessThan;
+
+namespace {
+
+// Genes whose mask uniform is below rate are redrawn from their interval
+void resampleRow(double* __restrict genes, const double* mask, const double* draw, const double* lower,
+                 const double* upper, size_t n, double rate) {
+    for (size_t i = 0; i < n; ++i) {
+        const double fresh = lower[i] + draw[i] * (upper[i] - lower[i]);
+        genes[i] = blend(lessThan(mask[i], rate), fresh, genes[i]);
+    }
+}
+
+} // namespace
+
+void UniformMutation::prepareBatch(double pm, const std::vector<double>& lowerBounds,
+                                   const std::vector<double>& upperBounds) {
+    validateProbability(pm, "uniformMutation");
+    validateBounds(lowerBounds, upperBounds);
+    
+    batch_rate_ = pm;
+    batch_lower_ = lowerBounds.data();
+    batch_upper_ = upperBounds.data();
+    batch_dimension_ = lowerBounds.size();
+    batch_ready_ = true;
+}
+
+void UniformMutation::mutateBatch(double* population, size_t rows, size_t dimension) {
+    if (!batch_ready_ || dimension != batch_dimension_) {
+        throw InvalidParameterException("mutateBatch needs prepareBatch() with bounds of length " +
+                                        std::to_string(dimension));
+    }
+    
+    // Per row, from its own sub-stream: dimension mask uniforms, then
+    // dimension resampling uniforms
+    const size_t stride = 2 * dimension;
+    batch_uniforms_.resize(stride);
+    double* u = batch_uniforms_.data();
+    
+    uint32_t key1, key2;
+    batchKeys(key1, key2);
+    const double rate = batch_rate_;
+    size_t hits = 0;
+    for (size_t r = 0; r < rows; ++r) {
+        recombination_kernels::fillUniform(u, stride, 0, key1, recombination_kernels::streamKey(key2, r));
+        // Mutated genes counted from the sign bit of u - rate; a bool sum would stay scalar
+        for (size_t i = 0; i < dimension; ++i) hits += recombination_kernels::bitsOf(u[i] - rate) >> 63;
+        resampleRow(population + r * dimension, u, u + dimension, batch_lower_, batch_upper_, dimension,
+                    rate);
+    }
+    
+    stats.totalMutations += rows;
+    stats.successfulMutations += hits;
+}
@@ -19,6 +19,39 @@ public:
     void mutate(std::vector<double>& chromosome, double pm,
                const std::vector<double>& lowerBounds,
                const std::vector<double>& upperBounds) const;
+    
+    /**
+     * @brief Validate the parameters of mutateBatch() once, at setup time
+     * @param pm Mutation probability per gene
+     * @param lowerBounds Lower bounds for each gene
+     * @param upperBounds Upper bounds for each gene
+     * @throws InvalidParameterException if bounds are inconsistent
+     *
+     * The bounds are kept as views and must stay alive and unchanged until
+     * the next prepareBatch().
+     */
+    void prepareBatch(double pm, const std::vector<double>& lowerBounds,
+                      const std::vector<double>& upperBounds);
+    
+    /**
+     * @brief Uniform mutation of every row of a row-major population matrix
+     * @param population rows x dimension genes, mutated in place
+     * @param rows Number of chromosomes
+     * @param dimension Genes per chromosome; must match prepareBatch()
+     * @throws InvalidParameterException if prepareBatch() was not called for this dimension
+     *
+     * One streaming pass over the matrix: each row's mask and resampling
+     * uniforms come from one counter-based hash fill and the new values are
+     * blended in under the mask, so the gene loop vectorises.
+     */
+    void mutateBatch(double* population, size_t rows, size_t dimension);
+
+private:
+    double batch_rate_ = 0.0;
+    const double* batch_lower_ = nullptr;
+    const double* batch_upper_ = nullptr;
+    size_t batch_dimension_ = 0;
+    bool batch_ready_ = false;
 };
 
 #endif // UNIFORM_MUTATION_H
@@ -0,0 +1,69 @@
+#include "elite_archive.h"
+#include <algorithm>
+#include <limits>
+
+// ============================================================================
+// ELITE ARCHIVE IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+// Heap order: the root holds the lowest fitness
+bool worse(const EliteArchive::Entry& a, const EliteArchive::Entry& b) {
+    return a.fitness > b.fitness;
+}
+
+} // namespace
+
+EliteArchive::EliteArchive(size_t capacity) : capacity_(capacity) {
+    heap_.reserve(capacity);
+}
+
+void EliteArchive::reset(size_t capacity) {
+    capacity_ = capacity;
+    heap_.clear();
+    heap_.reserve(capacity);
+}
+
+bool EliteArchive::offer(size_t id, double fitness) {
+    if (capacity_ == 0) return false;
+    if (heap_.size() < capacity_) {
+        heap_.push_back(Entry{fitness, id});
+        std::push_heap(heap_.begin(), heap_.end(), worse);
+        return true;
+    }
+    if (!(fitness > heap_.front().fitness)) return false;
+
+    // Replace the root and sift it down
+    const Entry entry{fitness, id};
+    const size_t n = heap_.size();
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && heap_[child + 1].fitness < heap_[child].fitness) ++child;
+        if (!(heap_[child].fitness < entry.fitness)) break;
+        heap_[i] = heap_[child];
+        i = child;
+    }
+    heap_[i] = entry;
+    return true;
+}
+
+void EliteArchive::merge(const EliteArchive& other) {
+    for (const Entry& e : other.heap_) offer(e.id, e.fitness);
+}
+
+double EliteArchive::threshold() const {
+    if (!full() || heap_.empty()) return -std::numeric_limits<double>::infinity();
+    return heap_.front().fitness;
+}
+
+void EliteArchive::sortedIds(std::vector<size_t>& out) const {
+    scratch_.assign(heap_.begin(), heap_.end());
+    std::sort(scratch_.begin(), scratch_.end(), [](const Entry& a, const Entry& b) {
+        return a.fitness != b.fitness ? a.fitness > b.fitness : a.id < b.id;
+    });
+    out.resize(scratch_.size());
+    for (size_t i = 0; i < scratch_.size(); ++i) out[i] = scratch_[i].id;
+}
@@ -0,0 +1,74 @@
+#ifndef ELITE_ARCHIVE_H
+#define ELITE_ARCHIVE_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Incremental top-k tracker for elitism
+ *
+ * Keeps the k best (id, fitness) pairs offered so far in a bounded binary
+ * min-heap whose root is the worst member. An offer that does not beat the
+ * root is rejected in O(1); one that does replaces it in O(log k). Feeding
+ * it offspring fitnesses as they are computed makes elitism O(N log k)
+ * without sorting or copying the population.
+ *
+ * Ties keep the member offered first. For parallel producers, give each
+ * worker its own archive and merge() them afterwards.
+ */
+class EliteArchive {
+public:
+    struct Entry {
+        double fitness;
+        size_t id;
+    };
+
+    /**
+     * @brief Construct an archive holding at most capacity members
+     */
+    explicit EliteArchive(size_t capacity = 0);
+
+    /**
+     * @brief Empty the archive and set a new capacity (storage is kept)
+     */
+    void reset(size_t capacity);
+
+    /**
+     * @brief Offer a candidate
+     * @param id Caller's identifier, e.g. a population index
+     * @param fitness Candidate fitness (higher is better)
+     * @return true if the candidate entered the archive
+     */
+    bool offer(size_t id, double fitness);
+
+    /**
+     * @brief Offer every member of another archive
+     */
+    void merge(const EliteArchive& other);
+
+    /**
+     * @brief Fitness a candidate has to beat to enter (-inf until full)
+     */
+    double threshold() const;
+
+    size_t size() const { return heap_.size(); }
+    size_t capacity() const { return capacity_; }
+    bool full() const { return heap_.size() >= capacity_; }
+
+    /**
+     * @brief Members in heap order (unsorted, worst first)
+     */
+    const std::vector<Entry>& entries() const { return heap_; }
+
+    /**
+     * @brief Write the member ids best first into out, O(k log k)
+     */
+    void sortedIds(std::vector<size_t>& out) const;
+
+private:
+    size_t capacity_;
+    std::vector<Entry> heap_;
+    mutable std::vector<Entry> scratch_;
+};
+
+#endif // ELITE_ARCHIVE_H
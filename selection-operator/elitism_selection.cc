@@ -1,4 +1,5 @@
 #include "elitism_selection.h"
+#include "elite_archive.h"
 #include <algorithm>
 #include <iostream>
 
@@ -14,19 +15,17 @@ std::vector<Individual> ElitismSelection::select(const std::vector<Individual>&
     
     operation_count++;
     
-    // Create a copy and sort by fitness in descending order (best first)
-    std::vector<Individual> sorted_population = population;
-    std::sort(sorted_population.begin(), sorted_population.end(),
-        [](const Individual& a, const Individual& b) {
-            return a.fitness > b.fitness;
-        });
-    
-    // Select the top 'count' individuals
-    size_t num_to_select = std::min(count, sorted_population.size());
-    selected.reserve(num_to_select);
+    // Track the top 'count' in a bounded heap, then copy only those (best first)
+    EliteArchive archive(std::min(count, population.size()));
+    for (size_t i = 0; i < population.size(); ++i) {
+        archive.offer(i, population[i].fitness);
+    }
+    std::vector<size_t> best;
+    archive.sortedIds(best);
     
-    for (size_t i = 0; i < num_to_select; ++i) {
-        selected.push_back(sorted_population[i]);
+    selected.reserve(best.size());
+    for (size_t i : best) {
+        selected.push_back(population[i]);
     }
     
     return selected;
@@ -41,24 +40,15 @@ std::vector<unsigned int> ElitismSelection::selectIndices(std::vector<Individual
         return SelectedIndices;
     }
 
-    // Sort individuals based on fitness in descending order
-    std::vector<unsigned int> Indices(PopulationSize);
+    // Bounded heap of the NumElites best, O(N log NumElites)
+    EliteArchive archive(std::min(NumElites, PopulationSize));
     for (unsigned int i = 0; i < PopulationSize; ++i) {
-        Indices[i] = i;
-    }
-
-    std::sort(Indices.begin(), Indices.end(), [&](unsigned int a, unsigned int b) {
-        return Population[a].fitness > Population[b].fitness;
-    });
-
-    // Select the top NumElites individuals
-    unsigned int numToSelect = std::min(NumElites, PopulationSize);
-    SelectedIndices.reserve(numToSelect);
-    
-    for (unsigned int i = 0; i < numToSelect; ++i) {
-        SelectedIndices.push_back(Indices[i]);
+        archive.offer(i, Population[i].fitness);
     }
+    std::vector<size_t> best;
+    archive.sortedIds(best);
 
+    SelectedIndices.assign(best.begin(), best.end());
     return SelectedIndices;
 }
 
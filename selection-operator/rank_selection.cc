@@ -1,5 +1,6 @@
 #include "rank_selection.h"
 #include <algorithm>
+#include <cstring>
 #include <random>
 #include <stdexcept>
 #include <iostream>
@@ -18,63 +19,140 @@ void RankSelection::setSelectionPressure(double pressure) {
     selection_pressure = pressure;
 }
 
-std::vector<Individual> RankSelection::select(const std::vector<Individual>& population, size_t count) {
-    std::vector<Individual> selected;
-    selected.reserve(count);
-    
-    if (population.empty()) {
-        return selected;
+void RankSelection::setScheme(Scheme scheme, double base) {
+    if (!(base > 0.0 && base <= 1.0)) {
+        throw std::invalid_argument("Exponential rank base must be in (0, 1]");
     }
-    
+    scheme_ = scheme;
+    exponential_base_ = base;
+}
+
+uint64_t RankSelection::orderedKey(double fitness) {
+    if (fitness == 0.0) fitness = 0.0; // -0 ranks with +0
+    uint64_t bits;
+    std::memcpy(&bits, &fitness, sizeof bits);
+    // Negative numbers: flip everything (larger magnitude sorts lower);
+    // non-negative: set the sign bit so they sort above all negatives
+    return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+void RankSelection::prepare(const std::vector<Individual>& population) {
+    cdf_.resize(population.size());
+    for (size_t i = 0; i < population.size(); ++i) cdf_[i] = population[i].fitness;
+    // cdf_ doubles as the fitness buffer until the ranking is done
+    prepare(cdf_.data(), population.size());
+}
+
+void RankSelection::prepare(const double* fitness, size_t n) {
     operation_count++;
-    
-    // Create a copy and sort by fitness (ascending order, worst to best)
-    std::vector<Individual> sorted_population = population;
-    std::sort(sorted_population.begin(), sorted_population.end(),
-        [](const Individual& a, const Individual& b) {
-            return a.fitness < b.fitness;
-        });
-    
-    // Calculate selection probabilities based on rank
-    std::vector<double> probabilities;
-    probabilities.reserve(sorted_population.size());
-    
-    size_t n = sorted_population.size();
+    keys_.resize(n);
+    keys_tmp_.resize(n);
+    order_.resize(n);
+    order_tmp_.resize(n);
     for (size_t i = 0; i < n; ++i) {
-        // Rank i goes from 0 (worst) to n-1 (best)
-        // Probability formula: P(i) = (2-SP + 2*(SP-1)*i/(n-1)) / n
-        // where SP is selection pressure
-        double prob;
-        if (n == 1) {
-            prob = 1.0;
-        } else {
-            prob = (2.0 - selection_pressure + 2.0 * (selection_pressure - 1.0) * i / (n - 1)) / n;
+        keys_[i] = orderedKey(fitness[i]);
+        order_[i] = i;
+    }
+
+    // LSD radix sort, one byte per pass; a pass whose byte is the same for
+    // every key is skipped. Stable, so equal fitnesses keep index order.
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t counts[257] = {0};
+        for (size_t i = 0; i < n; ++i) ++counts[((keys_[i] >> shift) & 0xFF) + 1];
+        bool trivial = false;
+        for (int d = 1; d <= 256 && !trivial; ++d) trivial = counts[d] == n;
+        if (trivial) continue;
+        for (int d = 1; d <= 256; ++d) counts[d] += counts[d - 1];
+        for (size_t i = 0; i < n; ++i) {
+            const size_t slot = counts[(keys_[i] >> shift) & 0xFF]++;
+            keys_tmp_[slot] = keys_[i];
+            order_tmp_[slot] = order_[i];
         }
-        probabilities.push_back(prob);
+        keys_.swap(keys_tmp_);
+        order_.swap(order_tmp_);
     }
-    
-    // Calculate cumulative probabilities
-    std::vector<double> cumulative_probs;
-    cumulative_probs.reserve(n);
-    double sum = 0.0;
-    for (double prob : probabilities) {
-        sum += prob;
-        cumulative_probs.push_back(sum);
+
+    // Rank probabilities (alias_prob_ holds them for now), then the CDF
+    alias_prob_.resize(n);
+    cdf_.resize(n);
+    if (n == 0) return;
+    double total = 0.0;
+    if (scheme_ == Scheme::Linear) {
+        const double sp = selection_pressure;
+        for (size_t i = 0; i < n; ++i) {
+            // Pressures above 2 would give the worst ranks negative weight
+            const double w = n == 1 ? 1.0 : 2.0 - sp + 2.0 * (sp - 1.0) * i / (n - 1);
+            alias_prob_[i] = std::max(0.0, w);
+            total += alias_prob_[i];
+        }
+    } else {
+        double w = 1.0;
+        for (size_t i = n; i-- > 0;) {
+            alias_prob_[i] = w;
+            total += w;
+            w *= exponential_base_;
+        }
+    }
+    double running = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        alias_prob_[i] /= total;
+        running += alias_prob_[i];
+        cdf_[i] = running;
+    }
+    cdf_[n - 1] = 1.0;
+
+    // Vose's alias method over ranks
+    alias_.resize(n);
+    small_.clear();
+    large_.clear();
+    for (size_t i = 0; i < n; ++i) {
+        alias_prob_[i] *= static_cast<double>(n);
+        alias_[i] = i;
+        (alias_prob_[i] < 1.0 ? small_ : large_).push_back(i);
     }
+    while (!small_.empty() && !large_.empty()) {
+        const size_t s = small_.back();
+        small_.pop_back();
+        const size_t l = large_.back();
+        alias_[s] = l;
+        alias_prob_[l] -= 1.0 - alias_prob_[s];
+        if (alias_prob_[l] < 1.0) {
+            large_.pop_back();
+            small_.push_back(l);
+        }
+    }
+    // Leftovers are 1 up to rounding
+    for (size_t i : small_) alias_prob_[i] = 1.0;
+    for (size_t i : large_) alias_prob_[i] = 1.0;
+}
+
+size_t RankSelection::sample() {
+    if (order_.empty()) {
+        throw std::logic_error("RankSelection::sample needs a prepared, non-empty population");
+    }
+    std::uniform_int_distribution<size_t> column(0, order_.size() - 1);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    const size_t rank = column(rng);
+    return order_[coin(rng) < alias_prob_[rank] ? rank : alias_[rank]];
+}
+
+void RankSelection::sampleIndices(size_t count, std::vector<size_t>& out) {
+    out.resize(count);
+    for (size_t i = 0; i < count; ++i) out[i] = sample();
+}
+
+std::vector<Individual> RankSelection::select(const std::vector<Individual>& population, size_t count) {
+    std::vector<Individual> selected;
+    selected.reserve(count);
     
-    std::uniform_real_distribution<> dis(0.0, 1.0);
+    if (population.empty()) {
+        return selected;
+    }
     
+    // Rank once, then copy only the picks
+    prepare(population);
     for (size_t i = 0; i < count; ++i) {
-        double random_value = dis(rng);
-        
-        auto it = std::lower_bound(cumulative_probs.begin(), cumulative_probs.end(), random_value);
-        size_t index = std::distance(cumulative_probs.begin(), it);
-        
-        if (index < sorted_population.size()) {
-            selected.push_back(sorted_population[index]);
-        } else {
-            selected.push_back(sorted_population.back());
-        }
+        selected.push_back(population[sample()]);
     }
     
     return selected;
@@ -82,20 +160,16 @@ std::vector<Individual> RankSelection::select(const std::vector<Individual>& pop
 
 std::vector<unsigned int> RankSelection::selectIndices(std::vector<Individual>& Population, 
                                                       unsigned int NumSelections) {
-    RankSelection selector;
-    std::vector<Individual> selected = selector.select(Population, NumSelections);
-    
-    // Convert back to indices (this is a simplified approach)
     std::vector<unsigned int> indices;
-    indices.reserve(NumSelections);
+    if (Population.empty()) {
+        return indices;
+    }
     
-    for (const auto& sel : selected) {
-        for (size_t i = 0; i < Population.size(); ++i) {
-            if (&Population[i] == &sel) {
-                indices.push_back(i);
-                break;
-            }
-        }
+    RankSelection selector;
+    selector.prepare(Population);
+    indices.reserve(NumSelections);
+    for (unsigned int i = 0; i < NumSelections; ++i) {
+        indices.push_back(static_cast<unsigned int>(selector.sample()));
     }
     
     return indices;
@@ -2,6 +2,7 @@
 #define RANK_SELECTION_H
 
 #include "base_selection.h"
+#include <cstdint>
 
 /**
  * @brief Rank Selection Operator
@@ -14,10 +15,36 @@
  * - pressure = 1.0: uniform selection (no pressure)
  * - pressure = 2.0: moderate pressure (default)
  * - pressure > 2.0: high pressure (strong bias toward best individuals)
+ *
+ * For many picks from one generation, call prepare() once: it ranks the
+ * fitness array with an LSD radix sort on order-preserving bit patterns
+ * (O(N), no comparisons), builds the linear or exponential rank CDF and a
+ * Walker/Vose alias table, after which sample() costs O(1). All buffers are
+ * members, so later generations of the same size do not allocate.
  */
 class RankSelection : public SelectionOperator {
+public:
+    /**
+     * @brief Rank-to-probability schemes
+     * - Linear: P(rank i) = (2 - SP + 2 (SP - 1) i / (n - 1)) / n, i = 0 for the worst
+     * - Exponential: P(rank i) proportional to base^(n - 1 - i), base in (0, 1]
+     */
+    enum class Scheme { Linear, Exponential };
+
 private:
     double selection_pressure;
+    Scheme scheme_ = Scheme::Linear;
+    double exponential_base_ = 0.95;
+
+    // Cached ranking of the last prepare() call
+    std::vector<size_t> order_;        // population indices, worst first
+    std::vector<double> cdf_;          // cdf_[i] = P(rank <= i)
+    std::vector<double> alias_prob_;   // alias table over ranks
+    std::vector<size_t> alias_;
+    // Radix sort and alias construction scratch
+    std::vector<uint64_t> keys_, keys_tmp_;
+    std::vector<size_t> order_tmp_;
+    std::vector<size_t> small_, large_;
     
 public:
     /**
@@ -46,6 +73,47 @@ public:
      */
     void setSelectionPressure(double pressure);
     
+    /**
+     * @brief Choose the rank scheme used by prepare()
+     * @param scheme Linear (uses the selection pressure) or Exponential
+     * @param base Ratio between consecutive ranks' weights, in (0, 1]
+     */
+    void setScheme(Scheme scheme, double base = 0.95);
+    Scheme getScheme() const { return scheme_; }
+    
+    /**
+     * @brief Rank one generation: radix sort, rank CDF and alias table
+     * @param fitness Fitness per individual (higher is better)
+     * @param n Number of individuals
+     */
+    void prepare(const double* fitness, size_t n);
+    void prepare(const std::vector<Individual>& population);
+    
+    /**
+     * @brief Draw one population index from the prepared ranking in O(1)
+     */
+    size_t sample();
+    
+    /**
+     * @brief Draw count indices into out (resized, storage reused)
+     */
+    void sampleIndices(size_t count, std::vector<size_t>& out);
+    
+    /**
+     * @brief Population indices of the prepared ranking, worst first
+     */
+    const std::vector<size_t>& rankedIndices() const { return order_; }
+    
+    /**
+     * @brief Cumulative rank probabilities of the prepared ranking
+     */
+    const std::vector<double>& rankCdf() const { return cdf_; }
+    
+    /**
+     * @brief Map a fitness to an unsigned key with the same order
+     */
+    static uint64_t orderedKey(double fitness);
+    
     /**
      * @brief Legacy function for backward compatibility
      * @param Population Population to select from
@@ -1,5 +1,6 @@
 #include "stochastic_universal_sampling.h"
 #include <algorithm>
+#include <cmath>
 #include <random>
 #include <iostream>
 
@@ -14,73 +15,84 @@ std::vector<Individual> StochasticUniversalSampling::select(const std::vector<In
         return selected;
     }
     
+    fitness_buffer_.resize(population.size());
+    for (size_t i = 0; i < population.size(); ++i) {
+        fitness_buffer_[i] = population[i].fitness;
+    }
+    index_buffer_.resize(count);
+    sampleIndices(fitness_buffer_.data(), fitness_buffer_.size(), index_buffer_.data(), count);
+    
+    for (size_t i : index_buffer_) {
+        selected.push_back(population[i]);
+    }
+    
+    return selected;
+}
+
+void StochasticUniversalSampling::sampleIndices(const double* fitness, size_t n, size_t* out, size_t count) {
+    if (n == 0 || count == 0) {
+        return;
+    }
+    
     operation_count++;
     
-    // Calculate the total fitness
     double total_fitness = 0.0;
-    for (const auto& individual : population) {
-        total_fitness += individual.fitness;
+    for (size_t i = 0; i < n; ++i) {
+        total_fitness += std::max(0.0, fitness[i]);
     }
     
-    if (total_fitness <= 0.0) {
-        // If no positive fitness, select randomly
-        std::uniform_int_distribution<> dis(0, population.size() - 1);
+    if (!(total_fitness > 0.0) || !std::isfinite(total_fitness)) {
+        // No usable weights: select uniformly
+        std::uniform_int_distribution<size_t> dis(0, n - 1);
         for (size_t i = 0; i < count; ++i) {
-            selected.push_back(population[dis(rng)]);
+            out[i] = dis(rng);
         }
-        return selected;
+        std::sort(out, out + count);
+        return;
     }
     
-    // Calculate the distance between selection points
-    double distance = total_fitness / count;
-    
-    // Random starting point
-    std::uniform_real_distribution<> start_dis(0.0, distance);
-    double start_point = start_dis(rng);
-    
-    // Select individuals using evenly spaced pointers
-    double cumulative_fitness = 0.0;
-    size_t pop_index = 0;
+    // Evenly spaced pointers from one random start, merged with the running
+    // sum: individual j takes the pointers in [sum before j, sum through j)
+    const double distance = total_fitness / count;
+    std::uniform_real_distribution<double> start_dis(0.0, distance);
+    const double start_point = start_dis(rng);
     
+    size_t j = 0;
+    double cumulative_fitness = std::max(0.0, fitness[0]);
     for (size_t i = 0; i < count; ++i) {
-        double selection_point = start_point + i * distance;
-        
-        // Find the individual at this selection point
-        while (pop_index < population.size() && cumulative_fitness < selection_point) {
-            cumulative_fitness += population[pop_index].fitness;
-            if (cumulative_fitness < selection_point) {
-                pop_index++;
-            }
-        }
-        
-        if (pop_index < population.size()) {
-            selected.push_back(population[pop_index]);
-        } else if (!population.empty()) {
-            selected.push_back(population.back());
+        const double pointer = start_point + i * distance;
+        while (j + 1 < n && cumulative_fitness <= pointer) {
+            ++j;
+            cumulative_fitness += std::max(0.0, fitness[j]);
         }
+        out[i] = j;
+    }
+}
+
+void StochasticUniversalSampling::sampleIndicesShuffled(const double* fitness, size_t n, size_t* out, size_t count) {
+    sampleIndices(fitness, n, out, count);
+    for (size_t i = count; i > 1; --i) {
+        std::uniform_int_distribution<size_t> pick(0, i - 1);
+        std::swap(out[i - 1], out[pick(rng)]);
     }
-    
-    return selected;
 }
 
 std::vector<unsigned int> StochasticUniversalSampling::selectIndices(std::vector<Individual>& Population, 
                                                                     unsigned int NumSelections) {
-    StochasticUniversalSampling selector;
-    std::vector<Individual> selected = selector.select(Population, NumSelections);
-    
-    // Convert back to indices
     std::vector<unsigned int> indices;
-    indices.reserve(NumSelections);
+    if (Population.empty() || NumSelections == 0) {
+        return indices;
+    }
     
-    for (const auto& sel : selected) {
-        for (size_t i = 0; i < Population.size(); ++i) {
-            if (&Population[i] == &sel) {
-                indices.push_back(i);
-                break;
-            }
-        }
+    StochasticUniversalSampling selector;
+    std::vector<double> fitness(Population.size());
+    for (size_t i = 0; i < Population.size(); ++i) {
+        fitness[i] = Population[i].fitness;
     }
+    std::vector<size_t> picks(NumSelections);
+    selector.sampleIndices(fitness.data(), fitness.size(), picks.data(), picks.size());
     
+    indices.assign(picks.begin(), picks.end());
     return indices;
 }
 
@@ -13,8 +13,16 @@
  * The algorithm uses a single random starting point and then selects individuals
  * at regular intervals, which reduces the variance in selection compared to
  * multiple independent selections.
+ *
+ * sampleIndices() works on a fitness array and emits population indices in
+ * a single merge of the pointers with the running fitness sum, O(N + count),
+ * without touching genomes.
  */
 class StochasticUniversalSampling : public SelectionOperator {
+private:
+    std::vector<double> fitness_buffer_;
+    std::vector<size_t> index_buffer_;
+    
 public:
     /**
      * @brief Construct a new Stochastic Universal Sampling object
@@ -29,6 +37,23 @@ public:
      */
     std::vector<Individual> select(const std::vector<Individual>& population, size_t count) override;
     
+    /**
+     * @brief SUS over a fitness array, writing indices only
+     * @param fitness n weights; negative ones count as 0, and a population
+     *        without positive weight is sampled uniformly
+     * @param n Population size
+     * @param out Output, count indices in ascending order (an individual's
+     *        copies are adjacent)
+     * @param count Number of selections
+     */
+    void sampleIndices(const double* fitness, size_t n, size_t* out, size_t count);
+    
+    /**
+     * @brief Same selection, then an in-place Fisher-Yates shuffle of out,
+     *        so consecutive entries can be paired as mates directly
+     */
+    void sampleIndicesShuffled(const double* fitness, size_t n, size_t* out, size_t count);
+    
     /**
      * @brief Legacy function for backward compatibility
      * @param Population Population to select from
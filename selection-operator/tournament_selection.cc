@@ -1,4 +1,5 @@
 #include "tournament_selection.h"
+#include "common/recombination_kernels.h"
 #include <algorithm>
 #include <stdexcept>
 
@@ -6,39 +7,126 @@
 // TOURNAMENT SELECTION IMPLEMENTATION
 // ============================================================================
 
+namespace {
+
+using recombination_kernels::hash32;
+
+// Uniform number counter of the stream of key. Every output depends only on
+// its counter, so filling a block is a data-parallel loop; the key goes
+// through the hash, so the streams of different calls do not overlap
+inline uint32_t draw(uint32_t counter, uint32_t key) {
+    return hash32(hash32(counter) ^ key);
+}
+
+// Maps a uniform 32-bit value to [0, n) by multiply-shift
+inline uint32_t below(uint32_t r, uint32_t n) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(r) * n) >> 32);
+}
+
+} // namespace
+
 std::vector<Individual> TournamentSelection::select(const std::vector<Individual>& population, size_t count) {
     if (population.empty()) {
         throw std::invalid_argument("Population cannot be empty");
     }
     
-    operation_count++;
+    fitness_buffer_.resize(population.size());
+    for (size_t i = 0; i < population.size(); ++i) {
+        fitness_buffer_[i] = population[i].fitness;
+    }
+    winners_buffer_.resize(count);
+    selectBatch(fitness_buffer_.data(), fitness_buffer_.size(), winners_buffer_.data(), count);
     
     std::vector<Individual> selected;
     selected.reserve(count);
+    for (size_t w : winners_buffer_) {
+        selected.push_back(population[w]);
+    }
     
-    std::uniform_int_distribution<size_t> dist(0, population.size() - 1);
+    return selected;
+}
+
+void TournamentSelection::selectBatch(const double* fitness, size_t n, size_t* winners, size_t count,
+                                      bool with_replacement) {
+    if (n == 0) {
+        throw std::invalid_argument("Population cannot be empty");
+    }
+    if (n > INT32_MAX) {
+        throw std::invalid_argument("Batched tournaments support at most 2^31 - 1 individuals");
+    }
+    if (tournament_size == 0) {
+        throw std::invalid_argument("Tournament size must be greater than 0");
+    }
+    
+    operation_count++;
+    
+    const uint32_t n32 = static_cast<uint32_t>(n);
+    const size_t k = std::min(tournament_size, n);
+    batch_candidates_.resize(k * kBatch);
+    batch_fitness_.resize(k * kBatch);
+    uint32_t* cand = batch_candidates_.data();
+    double* fit = batch_fitness_.data();
+    
+    size_t next = n; // position in the permutation; n forces the first shuffle
+    if (!with_replacement) {
+        permutation_.resize(n);
+        for (uint32_t i = 0; i < n32; ++i) permutation_[i] = i;
+    }
+    uint32_t counter = 0;
+    const uint32_t key = static_cast<uint32_t>(rng());
+    
+    double best[kBatch];
+    double best_index[kBatch]; // indices as doubles keep every lane the same width
     
-    for (size_t i = 0; i < count; ++i) {
-        // Select tournament_size random individuals
-        std::vector<size_t> tournament_indices;
-        tournament_indices.reserve(tournament_size);
+    for (size_t start = 0; start < count; start += kBatch) {
+        const size_t m = std::min(kBatch, count - start);
         
-        for (size_t j = 0; j < tournament_size && j < population.size(); ++j) {
-            tournament_indices.push_back(dist(rng));
+        if (with_replacement) {
+            // One fill for the whole block
+            for (size_t j = 0; j < k * kBatch; ++j) {
+                cand[j] = below(draw(counter + static_cast<uint32_t>(j), key), n32);
+            }
+            counter += static_cast<uint32_t>(k * kBatch);
+        } else {
+            for (size_t t = 0; t < m; ++t) {
+                if (next + k > n) {
+                    // Fisher-Yates reshuffle from the same counter stream
+                    for (uint32_t i = n32 - 1; i > 0; --i) {
+                        const uint32_t j = below(draw(counter++, key), i + 1);
+                        std::swap(permutation_[i], permutation_[j]);
+                    }
+                    next = 0;
+                }
+                for (size_t r = 0; r < k; ++r) cand[r * kBatch + t] = permutation_[next + r];
+                next += k;
+            }
         }
         
-        // Find the best individual in the tournament
-        size_t best_index = tournament_indices[0];
-        for (size_t j = 1; j < tournament_indices.size(); ++j) {
-            if (population[tournament_indices[j]].fitness > population[best_index].fitness) {
-                best_index = tournament_indices[j];
+        // Gather, then reduce across tournaments: candidate r of every
+        // tournament at once, keeping the first of equal maxima
+        for (size_t r = 0; r < k; ++r) {
+            for (size_t t = 0; t < m; ++t) fit[r * kBatch + t] = fitness[cand[r * kBatch + t]];
+        }
+        for (size_t t = 0; t < m; ++t) {
+            best[t] = fit[t];
+            best_index[t] = static_cast<double>(static_cast<int32_t>(cand[t]));
+        }
+        for (size_t r = 1; r < k; ++r) {
+            const double* fr = fit + r * kBatch;
+            const uint32_t* cr = cand + r * kBatch;
+            for (size_t t = 0; t < m; ++t) {
+                const double v = fr[t];
+                const double b = best[t];
+                // The index moves by a 0/1 factor rather than a second select,
+                // which GCC will not if-convert; exact for integers below 2^31
+                const double better = static_cast<double>(v > b);
+                const double i = static_cast<double>(static_cast<int32_t>(cr[t]));
+                best[t] = v > b ? v : b;
+                best_index[t] += better * (i - best_index[t]);
             }
         }
-        
-        selected.push_back(population[best_index]);
+        for (size_t t = 0; t < m; ++t) winners[start + t] = static_cast<size_t>(best_index[t]);
     }
-    
-    return selected;
 }
 
 // Standalone function for compatibility
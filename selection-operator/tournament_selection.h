@@ -2,18 +2,61 @@
 #define TOURNAMENT_SELECTION_H
 
 #include "base_selection.h"
+#include <cstdint>
 
+/**
+ * @brief Tournament Selection Operator
+ *
+ * Each pick is the fittest of tournament_size candidates, at most the
+ * population size of them. selectBatch()
+ * runs many tournaments over a contiguous fitness array at once: candidate
+ * indices for a block of tournaments come from one fill of a counter-based
+ * hash stream (independent lanes, so the loop vectorises), fitnesses are
+ * gathered into a candidate-major block, and the per-tournament maximum is
+ * a branch-free compare/blend across tournaments. Scratch lives in the
+ * operator, so repeated batches do not allocate.
+ */
 class TournamentSelection : public SelectionOperator {
 private:
     size_t tournament_size;
     
+    // Batch scratch: candidate r of tournament t sits at [r * kBatch + t]
+    std::vector<uint32_t> batch_candidates_;
+    std::vector<double> batch_fitness_;
+    std::vector<uint32_t> permutation_; // shuffled population, without replacement
+    std::vector<double> fitness_buffer_;
+    std::vector<size_t> winners_buffer_;
+    
 public:
+    /** @brief Tournaments resolved per block of selectBatch() */
+    static constexpr size_t kBatch = 256;
+    
     TournamentSelection(size_t size = 3, unsigned seed = std::random_device{}()) 
         : SelectionOperator("Tournament", seed), tournament_size(size) {}
     
     std::vector<Individual> select(const std::vector<Individual>& population, 
                                  size_t count) override;
     
+    /**
+     * @brief Run count tournaments over a fitness array
+     * @param fitness Fitness per individual (higher is better), n entries
+     * @param n Population size (at most 2^31 - 1)
+     * @param winners Output, count population indices
+     * @param count Number of tournaments
+     * @param with_replacement true: candidates drawn independently (an
+     *        individual may meet itself); false: candidates are consecutive
+     *        entries of shuffled copies of the population, reshuffled when
+     *        fewer than tournament_size remain, so every individual enters
+     *        about count * tournament_size / n tournaments and never twice
+     *        the same one
+     *
+     * Either way tournaments have min(tournament_size, n) candidates.
+     */
+    void selectBatch(const double* fitness, size_t n, size_t* winners, size_t count,
+                     bool with_replacement = true);
+    
+    size_t getTournamentSize() const { return tournament_size; }
+    
     // Standalone function for compatibility
     static std::vector<unsigned int> selectIndices(std::vector<Individual>& Population, 
                                                   unsigned int TournamentSize);
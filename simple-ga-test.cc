@@ -8,6 +8,7 @@
 #include <chrono>
 #include <cmath>
 #include <memory>
+#include <numeric>
 
 
 // Base crossover functionality
@@ -83,6 +84,15 @@
 // Include our custom headers
 #include "simple-GA-Test/fitness-function.h"
 
+// Routing objective and memetic local search for permutations
+#include "ga/tour_local_search.hpp"
+// Duplicate-genome detection
+#include "ga/genome_hash.hpp"
+// Fitness sharing / clearing
+#include "ga/niching.hpp"
+// Per-gene bounds and repair strategies
+#include "ga/bounds.hpp"
+
 // Simple GA configuration structure
 struct GAConfig {
     int populationSize = 50;
@@ -95,9 +105,11 @@ struct GAConfig {
     // Function bounds
     double lowerBound = -5.12;
     double upperBound = 5.12;
+    // How real-valued crossover children outside the bounds are repaired
+    ga::BoundHandling boundHandling = ga::BoundHandling::Clamp;
     
     // Function selection
-    enum FunctionType { RASTRIGIN, ACKLEY, SCHWEFEL } function = RASTRIGIN;
+    enum FunctionType { RASTRIGIN, ACKLEY, SCHWEFEL, TOUR } function = RASTRIGIN;
     
     // Representation type
     enum RepresentationType { BINARY, REAL_VALUED, INTEGER, PERMUTATION } representation = REAL_VALUED;
@@ -107,6 +119,21 @@ struct GAConfig {
     std::string mutationType = "gaussian";
     std::string selectionType = "tournament";
     
+    // Memetic stage for permutations (TOUR): 2-opt/Or-opt on a fraction of
+    // the offspring after mutation; budgets count priced moves, 0 = unlimited
+    double localSearchRate = 0.2;
+    size_t localSearchMovesPerTour = 0;
+    size_t localSearchBudget = 0;
+    int threads = 1;
+    
+    // Offspring identical to a genome of the current or previous generation;
+    // the quantum applies to real-valued genes, other representations compare exactly
+    ga::DuplicateOptions duplicates;
+    
+    // Niching: parents are selected on shared fitness or clearing winners;
+    // elitism and the reported statistics keep the raw fitness
+    ga::NichingOptions niching;
+    
     // Output settings
     bool verbose = true;
     std::string outputFile = "ga_results.txt";
@@ -367,12 +394,40 @@ private:
     std::unique_ptr<MutationOperator> mutationOp;
     std::unique_ptr<CrossoverOperator> crossoverOp;
     
+    // Routing instance and local search used by the TOUR function
+    std::unique_ptr<ga::TourCost> tourCost;
+    std::unique_ptr<ga::MemeticStage> localSearch;
+    
+    // Duplicate detection and evaluation counts
+    ga::GenomeHashSet genomes;
+    size_t evaluations = 0;
+    size_t duplicatesFound = 0;
+    size_t evaluationsSaved = 0;
+    
+    // Rank selection ranks each generation once and serves every pick from it;
+    // tournaments are run for the whole generation in one batch
+    RankSelection rankSelector;
+    TournamentSelection tournamentSelector{3};
+    std::vector<double> fitnessBuffer;
+    std::vector<size_t> matingPool;
+    size_t matingNext = 0;
+    
+    // Niching stage; selection reads the adjusted fitness from fitnessBuffer
+    std::unique_ptr<ga::NichingStage> niching;
+    std::vector<double> genomeBuffer;
+    std::vector<double> rawFitness;
+    
+    // Per-gene bounds, built once and shared by every repair and mutation
+    std::vector<double> geneLower;
+    std::vector<double> geneUpper;
+    
 public:
     SimpleGA(const GAConfig& cfg) : config(cfg), 
                                    rng(std::random_device{}()),
                                    realDist(cfg.lowerBound, cfg.upperBound),
                                    intDist(0, cfg.populationSize - 1),
-                                   bestIndividual(cfg.chromosomeLength) {
+                                   bestIndividual(cfg.chromosomeLength),
+                                   genomes(cfg.representation == GAConfig::REAL_VALUED ? cfg.duplicates.quantum : 0.0) {
         
         // Initialize operators based on config
         mutationOp = createMutationOperator(config.mutationType);
@@ -392,9 +447,32 @@ public:
                 config.lowerBound = -500.0;
                 config.upperBound = 500.0;
                 break;
+            case GAConfig::TOUR:
+                // Genes are city indices; build a fixed random instance so runs compare
+                config.lowerBound = 0.0;
+                config.upperBound = config.chromosomeLength - 1;
+                tourCost = std::make_unique<ga::TourCost>(makeTourInstance(config.chromosomeLength));
+                if (config.representation == GAConfig::PERMUTATION && config.localSearchRate > 0.0) {
+                    ga::MemeticStage::Options options;
+                    options.fraction = config.localSearchRate;
+                    options.movesPerTour = config.localSearchMovesPerTour;
+                    options.totalBudget = config.localSearchBudget;
+                    options.threads = config.threads;
+                    localSearch = std::make_unique<ga::MemeticStage>(
+                        std::make_unique<ga::TourLocalSearch>(*tourCost), options);
+                }
+                break;
         }
         
         realDist = std::uniform_real_distribution<double>(config.lowerBound, config.upperBound);
+        geneLower.assign(config.chromosomeLength, config.lowerBound);
+        geneUpper.assign(config.chromosomeLength, config.upperBound);
+        
+        if (config.niching.method != ga::NichingOptions::Method::None) {
+            ga::NichingOptions options = config.niching;
+            options.threads = config.threads;
+            niching = std::make_unique<ga::NichingStage>(options);
+        }
         
         if (config.verbose) {
             std::cout << "GA initialized with:" << std::endl;
@@ -412,9 +490,18 @@ public:
         for (int i = 0; i < config.populationSize; ++i) {
             GAIndividual individual(config.chromosomeLength);
             
-            // Use the new randomInitialize method
-            individual.randomInitialize(rng, config);
+            if (config.representation == GAConfig::PERMUTATION) {
+                // Permutation operators expect a shuffled 0..n-1 sequence
+                std::vector<int> perm(config.chromosomeLength);
+                std::iota(perm.begin(), perm.end(), 0);
+                std::shuffle(perm.begin(), perm.end(), rng);
+                individual.chromosome.assign(perm.begin(), perm.end());
+            } else {
+                // Use the new randomInitialize method
+                individual.randomInitialize(rng, config);
+            }
             individual.fitness = evaluateFitness(individual.chromosome);
+            ++evaluations;
             population.push_back(individual);
         }
         
@@ -434,11 +521,49 @@ public:
                 return ackleyFitness(chromosome);
             case GAConfig::SCHWEFEL:
                 return schwefelFitness(chromosome);
+            case GAConfig::TOUR:
+                return 1000.0 / (1.0 + tourLength(chromosome));
             default:
                 return rastriginFitness(chromosome);
         }
     }
     
+    // Euclidean cities uniformly placed in a 100 x 100 square
+    static ga::TourCost makeTourInstance(int cities) {
+        std::mt19937 cityRng(42);
+        std::uniform_real_distribution<double> coord(0.0, 100.0);
+        std::vector<double> x(cities), y(cities);
+        for (int i = 0; i < cities; ++i) {
+            x[i] = coord(cityRng);
+            y[i] = coord(cityRng);
+        }
+        return ga::TourCost::euclidean(x, y);
+    }
+    
+    double tourLength(const std::vector<double>& chromosome) const {
+        std::vector<int> tour(chromosome.begin(), chromosome.end());
+        return (*tourCost)(tour);
+    }
+    
+    // Memetic stage: improve a fraction of the offspring in [first, end)
+    void improveOffspring(std::vector<GAIndividual>& individuals, size_t first) {
+        if (!localSearch || first >= individuals.size()) return;
+        std::vector<std::vector<int>> tours;
+        std::vector<double> costs;
+        tours.reserve(individuals.size() - first);
+        costs.reserve(individuals.size() - first);
+        for (size_t i = first; i < individuals.size(); ++i) {
+            tours.emplace_back(individuals[i].chromosome.begin(), individuals[i].chromosome.end());
+            costs.push_back((*tourCost)(tours.back()));
+        }
+        localSearch->apply(tours, costs, rng);
+        for (size_t i = first; i < individuals.size(); ++i) {
+            const auto& tour = tours[i - first];
+            individuals[i].chromosome.assign(tour.begin(), tour.end());
+            individuals[i].fitness = 1000.0 / (1.0 + costs[i - first]);
+        }
+    }
+    
     // Crossover operation using dynamic operator
     std::pair<GAIndividual, GAIndividual> crossover(const GAIndividual& parent1, 
                                                    const GAIndividual& parent2) {
@@ -498,13 +623,19 @@ public:
                 child2.chromosome = result.second;
             }
             
-            // Use the new clampToBounds method
-            child1.clampToBounds(config);
-            child2.clampToBounds(config);
-            
-            child1.fitness = evaluateFitness(child1.chromosome);
-            child2.fitness = evaluateFitness(child2.chromosome);
+            // Real-valued children are repaired as configured; permutation genes
+            // are indices, not bounded values
+            if (config.representation == GAConfig::REAL_VALUED) {
+                ga::repairGenes(config.boundHandling, child1.chromosome.data(), child1.chromosome.size(),
+                                geneLower.data(), geneUpper.data(), parent1.chromosome.data(), rng);
+                ga::repairGenes(config.boundHandling, child2.chromosome.data(), child2.chromosome.size(),
+                                geneLower.data(), geneUpper.data(), parent2.chromosome.data(), rng);
+            } else if (config.representation != GAConfig::PERMUTATION) {
+                child1.clampToBounds(config);
+                child2.clampToBounds(config);
+            }
             
+            // Children are scored after mutation (see scoreOffspring)
             return {child1, child2};
         } else {
             return {parent1, parent2};
@@ -514,12 +645,10 @@ public:
     // Mutation operation using dynamic operator
     void mutate(GAIndividual& individual) {
         if (config.representation == GAConfig::REAL_VALUED) {
-            std::vector<double> bounds_lower(individual.chromosome.size(), config.lowerBound);
-            std::vector<double> bounds_upper(individual.chromosome.size(), config.upperBound);
             if (config.mutationType == "gaussian") {
-                static_cast<GaussianMutation*>(mutationOp.get())->mutate(individual.chromosome, config.mutationRate, 0.1, bounds_lower, bounds_upper);
+                static_cast<GaussianMutation*>(mutationOp.get())->mutate(individual.chromosome, config.mutationRate, 0.1, geneLower, geneUpper);
             } else if (config.mutationType == "uniform") {
-                static_cast<UniformMutation*>(mutationOp.get())->mutate(individual.chromosome, config.mutationRate, bounds_lower, bounds_upper);
+                static_cast<UniformMutation*>(mutationOp.get())->mutate(individual.chromosome, config.mutationRate, geneLower, geneUpper);
             }
         } else if (config.representation == GAConfig::BINARY) {
             std::vector<bool> binaryChrom(individual.chromosome.size());
@@ -561,7 +690,37 @@ public:
                 individual.chromosome[i] = static_cast<double>(permChrom[i]);
             }
         }
-        individual.fitness = evaluateFitness(individual.chromosome);
+    }
+    
+    // Scores a mutated child, first looking it up among the current
+    // population and the offspring already in newPopulation
+    void scoreOffspring(GAIndividual& child, const std::vector<GAIndividual>& newPopulation) {
+        const bool dedup = config.duplicates.policy != ga::DuplicateOptions::Policy::Keep;
+        if (dedup) {
+            size_t twin = genomes.find(child.chromosome.data(), genomes.hash(child.chromosome.data()));
+            if (twin != ga::GenomeHashSet::npos) ++duplicatesFound;
+            if (config.duplicates.policy == ga::DuplicateOptions::Policy::Remutate) {
+                for (int a = 0; a < config.duplicates.attempts && twin != ga::GenomeHashSet::npos; ++a) {
+                    mutate(child);
+                    twin = genomes.find(child.chromosome.data(), genomes.hash(child.chromosome.data()));
+                }
+            }
+            if (twin != ga::GenomeHashSet::npos) {
+                child.fitness = twin < population.size() ? population[twin].fitness
+                                                         : newPopulation[twin - population.size()].fitness;
+                ++evaluationsSaved;
+                return;
+            }
+        }
+        child.fitness = evaluateFitness(child.chromosome);
+        ++evaluations;
+    }
+    
+    // Registers newPopulation.back() for later duplicate lookups
+    void rememberOffspring(const std::vector<GAIndividual>& newPopulation) {
+        if (config.duplicates.policy == ga::DuplicateOptions::Policy::Keep) return;
+        const double* genes = newPopulation.back().chromosome.data();
+        genomes.insert(genes, genomes.hash(genes), population.size() + newPopulation.size() - 1);
     }
     
     // Tournament selection or roulette wheel selection
@@ -578,10 +737,18 @@ public:
     
     // Use selection operators from the selection-operator module
     GAIndividual selectParentUsingOperators() {
+        if (config.selectionType == "rank") {
+            return population[rankSelector.sample()];
+        }
+        if (matingNext < matingPool.size()) {
+            return population[matingPool[matingNext++]];
+        }
+        
         // Convert population to Individual format
         std::vector<Individual> individuals;
-        for (const auto& ind : population) {
-            individuals.push_back(ind.toIndividual());
+        for (size_t i = 0; i < population.size(); ++i) {
+            individuals.push_back(population[i].toIndividual());
+            individuals.back().fitness = fitnessBuffer[i];
         }
         
         std::vector<unsigned int> selectedIndices;
@@ -613,6 +780,7 @@ public:
                 case GAConfig::RASTRIGIN: std::cout << "Rastrigin"; break;
                 case GAConfig::ACKLEY: std::cout << "Ackley"; break;
                 case GAConfig::SCHWEFEL: std::cout << "Schwefel"; break;
+                case GAConfig::TOUR: std::cout << "Tour length (" << config.chromosomeLength << " cities)"; break;
             }
             std::cout << std::endl << std::endl;
         }
@@ -636,6 +804,37 @@ public:
                 }
             }
             
+            if (config.duplicates.policy != ga::DuplicateOptions::Policy::Keep) {
+                genomes.reset(2 * population.size(), config.chromosomeLength);
+                for (size_t i = 0; i < population.size(); ++i) {
+                    const double* genes = population[i].chromosome.data();
+                    genomes.insert(genes, genomes.hash(genes), i);
+                }
+                // Elites are copies of population members, which are already in the set
+            }
+            
+            fitnessBuffer.resize(population.size());
+            for (size_t i = 0; i < population.size(); ++i) fitnessBuffer[i] = population[i].fitness;
+            if (niching) {
+                const size_t dimension = config.chromosomeLength;
+                genomeBuffer.resize(population.size() * dimension);
+                for (size_t i = 0; i < population.size(); ++i) {
+                    std::copy(population[i].chromosome.begin(), population[i].chromosome.end(),
+                              genomeBuffer.begin() + i * dimension);
+                }
+                rawFitness = fitnessBuffer;
+                niching->apply(genomeBuffer.data(), population.size(), dimension, rawFitness.data(), fitnessBuffer.data());
+            }
+            if (config.selectionType == "rank") {
+                rankSelector.prepare(fitnessBuffer.data(), fitnessBuffer.size());
+            } else if (config.selectionType != "roulette") {
+                // Two parents per pair of offspring
+                const size_t pairs = (config.populationSize - newPopulation.size() + 1) / 2;
+                matingPool.resize(2 * pairs);
+                tournamentSelector.selectBatch(fitnessBuffer.data(), fitnessBuffer.size(), matingPool.data(), matingPool.size());
+                matingNext = 0;
+            }
+            
             // Generate offspring using selected operators
             while (newPopulation.size() < static_cast<size_t>(config.populationSize)) {
                 GAIndividual parent1 = selectParent();
@@ -646,12 +845,19 @@ public:
                 mutate(children.first);
                 mutate(children.second);
                 
+                scoreOffspring(children.first, newPopulation);
                 newPopulation.push_back(children.first);
+                rememberOffspring(newPopulation);
                 if (newPopulation.size() < static_cast<size_t>(config.populationSize)) {
+                    scoreOffspring(children.second, newPopulation);
                     newPopulation.push_back(children.second);
+                    rememberOffspring(newPopulation);
                 }
             }
             
+            // Local search on a fraction of the offspring (elites are left as they are)
+            improveOffspring(newPopulation, static_cast<size_t>(numElites));
+            
             population = newPopulation;
             
             // Update statistics
@@ -718,8 +924,17 @@ public:
             case GAConfig::SCHWEFEL:
                 actualValue = schwefelFunction(bestIndividual.chromosome);
                 break;
+            case GAConfig::TOUR:
+                actualValue = tourLength(bestIndividual.chromosome);
+                break;
         }
         std::cout << "Actual function value: " << actualValue << std::endl;
+        std::cout << "Fitness evaluations: " << evaluations;
+        if (config.duplicates.policy != ga::DuplicateOptions::Policy::Keep) {
+            std::cout << " (" << duplicatesFound << " duplicate offspring, "
+                      << evaluationsSaved << " evaluations saved)";
+        }
+        std::cout << std::endl;
         
         // Save results to file
         saveResults();
@@ -747,7 +962,8 @@ void runGATests(const std::string& crossoverType, const std::string& mutationTyp
                const std::string& selectionType, GAConfig::RepresentationType repType = GAConfig::REAL_VALUED) {
     std::cout << "=== GENETIC ALGORITHM TEST SUITE ===" << std::endl;
     std::cout << "Testing GA on benchmark optimization functions" << std::endl;
-    std::cout << "Population: 50, Generations: 50, Variables: 10" << std::endl;
+    std::cout << "Population: 50, Generations: 50, Variables: "
+              << (repType == GAConfig::PERMUTATION ? "50 cities" : "10") << std::endl;
     
     std::string repTypeStr;
     switch(repType) {
@@ -766,6 +982,10 @@ void runGATests(const std::string& crossoverType, const std::string& mutationTyp
         {GAConfig::ACKLEY, "ackley"},
         {GAConfig::SCHWEFEL, "schwefel"}
     };
+    // Permutations encode tours, so they run the routing objective instead
+    if (repType == GAConfig::PERMUTATION) {
+        functions = {{GAConfig::TOUR, "tour"}};
+    }
     
     for (auto& [funcType, funcName] : functions) {
         std::cout << "\n" << std::string(50, '=') << std::endl;
@@ -778,6 +998,15 @@ void runGATests(const std::string& crossoverType, const std::string& mutationTyp
         config.crossoverType = crossoverType;
         config.mutationType = mutationType;
         config.selectionType = selectionType;
+        if (funcType == GAConfig::TOUR) config.chromosomeLength = 50;
+        // Exact matches only, so skipping their evaluation cannot change a run
+        config.duplicates.policy = ga::DuplicateOptions::Policy::Skip;
+        // Clearing keeps several basins of the multimodal functions populated
+        if (repType == GAConfig::REAL_VALUED && (funcType == GAConfig::RASTRIGIN || funcType == GAConfig::SCHWEFEL)) {
+            config.niching.method = ga::NichingOptions::Method::Clearing;
+            config.niching.radius = funcType == GAConfig::RASTRIGIN ? 1.0 : 100.0;
+            config.niching.capacity = 2;
+        }
         config.outputFile = "ga_" + funcName + "_" + repTypeStr + "_" + crossoverType + "_" + mutationType + "_" + selectionType + "_results.txt";
         config.verbose = true;
         
@@ -906,10 +1135,10 @@ int main() {
     std::cout << "Using " << mutationType << " Mutation" << std::endl;
     
     // input selection type
-    std::cout << "Enter Selection (tournament, roulette) type: ";
+    std::cout << "Enter Selection (tournament, roulette, rank) type: ";
     std::getline(std::cin, selectionType);
     
-    if (selectionType == "tournament" || selectionType == "roulette") {
+    if (selectionType == "tournament" || selectionType == "roulette" || selectionType == "rank") {
         std::cout << "Using " << selectionType << " Selection" << std::endl;
     } else {
         std::cerr << "Invalid selection type. Defaulting to Tournament Selection." << std::endl;
@@ -0,0 +1,40 @@
+#include "ga/bounds.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ga {
+
+void resolveBounds(const Config& cfg, std::vector<double>& lower, std::vector<double>& upper) {
+    const size_t n = static_cast<size_t>(std::max(0, cfg.dimension));
+    if (cfg.lower.empty() && cfg.upper.empty()) {
+        if (!(cfg.bounds.lower <= cfg.bounds.upper)) throw std::invalid_argument("Lower bound exceeds upper bound");
+        lower.assign(n, cfg.bounds.lower);
+        upper.assign(n, cfg.bounds.upper);
+        return;
+    }
+    if (cfg.lower.size() != n || cfg.upper.size() != n) {
+        throw std::invalid_argument("Per-dimension bounds must both hold dimension values");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (!(cfg.lower[i] <= cfg.upper[i])) throw std::invalid_argument("Lower bound exceeds upper bound");
+    }
+    lower = cfg.lower;
+    upper = cfg.upper;
+}
+
+void repairGenes(BoundHandling handling, double* genes, size_t n, const double* lower, const double* upper,
+                 const double* parent, std::mt19937& rng) {
+    if (handling == BoundHandling::MidpointToParent && !parent) {
+        throw std::invalid_argument("Midpoint-to-parent repair needs the parent's genes");
+    }
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (size_t i = 0; i < n; ++i) {
+        const double x = genes[i];
+        if (x >= lower[i] && x <= upper[i]) continue;
+        const double u = handling == BoundHandling::Resample ? unit(rng) : 0.0;
+        genes[i] = repairGene(handling, x, lower[i], upper[i], parent ? parent[i] : 0.0, u);
+    }
+}
+
+} // namespace ga
@@ -0,0 +1,496 @@
+#include "ga/cmaes.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "ga/bounds.hpp"
+
+namespace ga {
+
+namespace {
+
+// Block edges chosen so a block of rows of both operands stays in L1/L2
+constexpr size_t kRowBlock = 32;
+constexpr size_t kInnerBlock = 64;
+constexpr size_t kColBlock = 256;
+
+// out (rows x n) = a (rows x n) * b (n x n), all row-major. The innermost
+// loop is an axpy over a contiguous row of b, which vectorises.
+void multiplyBlocked(const double* a, const double* b, double* out, size_t rows, size_t n) {
+    std::fill(out, out + rows * n, 0.0);
+    for (size_t k0 = 0; k0 < rows; k0 += kRowBlock) {
+        const size_t k1 = std::min(rows, k0 + kRowBlock);
+        for (size_t j0 = 0; j0 < n; j0 += kInnerBlock) {
+            const size_t j1 = std::min(n, j0 + kInnerBlock);
+            for (size_t i0 = 0; i0 < n; i0 += kColBlock) {
+                const size_t i1 = std::min(n, i0 + kColBlock);
+                for (size_t k = k0; k < k1; ++k) {
+                    double* row = out + k * n;
+                    for (size_t j = j0; j < j1; ++j) {
+                        const double s = a[k * n + j];
+                        const double* brow = b + j * n;
+                        for (size_t i = i0; i < i1; ++i) row[i] += s * brow[i];
+                    }
+                }
+            }
+        }
+    }
+}
+
+// c = decay * c + alpha * v v^T + beta * W^T W for symmetric c (n x n) and
+// W (rows x n). Only blocks on or above the diagonal are computed; each is
+// mirrored into its transposed position.
+void covarianceUpdateBlocked(double* c, size_t n, double decay,
+                             double alpha, const double* v,
+                             double beta, const double* w, size_t rows) {
+    for (size_t i0 = 0; i0 < n; i0 += kInnerBlock) {
+        const size_t i1 = std::min(n, i0 + kInnerBlock);
+        for (size_t j0 = i0; j0 < n; j0 += kColBlock) {
+            const size_t j1 = std::min(n, j0 + kColBlock);
+            for (size_t i = i0; i < i1; ++i) {
+                double* row = c + i * n;
+                const double vi = alpha * v[i];
+                for (size_t j = j0; j < j1; ++j) row[j] = decay * row[j] + vi * v[j];
+            }
+            for (size_t l = 0; l < rows; ++l) {
+                const double* wrow = w + l * n;
+                for (size_t i = i0; i < i1; ++i) {
+                    double* row = c + i * n;
+                    const double wi = beta * wrow[i];
+                    for (size_t j = j0; j < j1; ++j) row[j] += wi * wrow[j];
+                }
+            }
+            for (size_t i = i0; i < i1; ++i) {
+                for (size_t j = std::max(j0, i + 1); j < j1; ++j) c[j * n + i] = c[i * n + j];
+            }
+        }
+    }
+}
+
+// Householder reduction of the symmetric matrix v (n x n, row-major) to
+// tridiagonal form (d diagonal, e subdiagonal in e[1..n-1]); v is replaced by
+// the transpose of the accumulated orthogonal transform. After the
+// EISPACK/JAMA routine tred2, with the indices of v swapped so the inner
+// loops, which walk down columns there, run along contiguous rows here.
+void tridiagonalise(double* v, double* d, double* e, size_t n) {
+    for (size_t j = 0; j < n; ++j) d[j] = v[j * n + (n - 1)];
+
+    for (size_t i = n - 1; i > 0; --i) {
+        double scale = 0.0;
+        double h = 0.0;
+        for (size_t k = 0; k < i; ++k) scale += std::fabs(d[k]);
+        if (scale == 0.0) {
+            e[i] = d[i - 1];
+            for (size_t j = 0; j < i; ++j) {
+                d[j] = v[j * n + (i - 1)];
+                v[j * n + i] = 0.0;
+                v[i * n + j] = 0.0;
+            }
+        } else {
+            for (size_t k = 0; k < i; ++k) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            double f = d[i - 1];
+            double g = std::sqrt(h);
+            if (f > 0) g = -g;
+            e[i] = scale * g;
+            h -= f * g;
+            d[i - 1] = f - g;
+            for (size_t j = 0; j < i; ++j) e[j] = 0.0;
+
+            for (size_t j = 0; j < i; ++j) {
+                f = d[j];
+                v[i * n + j] = f;
+                g = e[j] + v[j * n + j] * f;
+                for (size_t k = j + 1; k < i; ++k) {
+                    g += v[j * n + k] * d[k];
+                    e[k] += v[j * n + k] * f;
+                }
+                e[j] = g;
+            }
+            f = 0.0;
+            for (size_t j = 0; j < i; ++j) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            const double hh = f / (h + h);
+            for (size_t j = 0; j < i; ++j) e[j] -= hh * d[j];
+            for (size_t j = 0; j < i; ++j) {
+                f = d[j];
+                g = e[j];
+                for (size_t k = j; k < i; ++k) v[j * n + k] -= (f * e[k] + g * d[k]);
+                d[j] = v[j * n + (i - 1)];
+                v[j * n + i] = 0.0;
+            }
+        }
+        d[i] = h;
+    }
+
+    // Accumulate the transformations
+    for (size_t i = 0; i + 1 < n; ++i) {
+        v[i * n + (n - 1)] = v[i * n + i];
+        v[i * n + i] = 1.0;
+        const double h = d[i + 1];
+        if (h != 0.0) {
+            for (size_t k = 0; k <= i; ++k) d[k] = v[(i + 1) * n + k] / h;
+            for (size_t j = 0; j <= i; ++j) {
+                double g = 0.0;
+                for (size_t k = 0; k <= i; ++k) g += v[(i + 1) * n + k] * v[j * n + k];
+                for (size_t k = 0; k <= i; ++k) v[j * n + k] -= g * d[k];
+            }
+        }
+        for (size_t k = 0; k <= i; ++k) v[(i + 1) * n + k] = 0.0;
+    }
+    for (size_t j = 0; j < n; ++j) {
+        d[j] = v[j * n + (n - 1)];
+        v[j * n + (n - 1)] = 0.0;
+    }
+    v[(n - 1) * n + (n - 1)] = 1.0;
+    e[0] = 0.0;
+}
+
+// Implicit QL iterations on the tridiagonal matrix (d, e). w holds the
+// transposed transform from tridiagonalise(), so every Givens rotation
+// combines two contiguous rows; on return row j of w is the eigenvector of
+// eigenvalue d[j]. After the EISPACK/JAMA routine tql2.
+void diagonalise(double* d, double* e, double* w, size_t n) {
+    for (size_t i = 1; i < n; ++i) e[i - 1] = e[i];
+    e[n - 1] = 0.0;
+
+    const double eps = std::numeric_limits<double>::epsilon();
+    double f = 0.0;
+    double tst1 = 0.0;
+    for (size_t l = 0; l < n; ++l) {
+        tst1 = std::max(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+        size_t m = l;
+        while (m < n && std::fabs(e[m]) > eps * tst1) ++m;
+        if (m == n) m = n - 1; // e[n-1] is zero, so only reached through rounding
+
+        if (m > l) {
+            for (int iter = 0; iter < 64; ++iter) {
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0) r = -r;
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                const double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (size_t i = l + 2; i < n; ++i) d[i] -= h;
+                f += h;
+
+                p = d[m];
+                double c = 1.0, c2 = 1.0, c3 = 1.0;
+                const double el1 = e[l + 1];
+                double s = 0.0, s2 = 0.0;
+                for (size_t i = m; i-- > l;) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+
+                    double* lo = w + i * n;
+                    double* hi = w + (i + 1) * n;
+                    for (size_t k = 0; k < n; ++k) {
+                        const double t = hi[k];
+                        hi[k] = s * lo[k] + c * t;
+                        lo[k] = c * lo[k] - s * t;
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+                if (std::fabs(e[l]) <= eps * tst1) break;
+            }
+        }
+        d[l] += f;
+        e[l] = 0.0;
+    }
+}
+
+} // namespace
+
+static std::mt19937 make_rng(unsigned seed) {
+    if (seed == 0) {
+        std::random_device rd;
+        return std::mt19937{rd()};
+    }
+    return std::mt19937{seed};
+}
+
+CMAES::CMAES(const Config& cfg, const CmaesOptions& options)
+    : cfg_(cfg), options_(options), rng_(make_rng(cfg.seed)) {}
+
+void CMAES::updateEigensystem_() {
+    const size_t n = mean_.size();
+    eigenvectors_ = cov_;
+    diag_.resize(n);
+    offDiag_.resize(n);
+    tridiagonalise(eigenvectors_.data(), diag_.data(), offDiag_.data(), n);
+    diagonalise(diag_.data(), offDiag_.data(), eigenvectors_.data(), n);
+
+    // Rounding can leave tiny negative eigenvalues; floor them relative to
+    // the largest so the scale stays usable for C^-1/2
+    const double largest = *std::max_element(diag_.begin(), diag_.end());
+    const double floor = std::max(largest, 1e-300) * 1e-20;
+    for (size_t j = 0; j < n; ++j) scale_[j] = std::sqrt(std::max(diag_[j], floor));
+}
+
+void CMAES::sample_(int lambda) {
+    const size_t n = mean_.size();
+    std::normal_distribution<double> normal(0.0, 1.0);
+    for (int k = 0; k < lambda; ++k) {
+        double* z = &z_[k * n];
+        for (size_t j = 0; j < n; ++j) z[j] = normal(rng_) * scale_[j];
+    }
+    if (options_.covariance == CmaesOptions::Covariance::Full) {
+        // y_k = B D z_k for all k at once: Y = (Z D) B^T, with B^T stored row-major
+        multiplyBlocked(z_.data(), eigenvectors_.data(), y_.data(), lambda, n);
+    } else {
+        std::copy(z_.begin(), z_.begin() + lambda * n, y_.begin());
+    }
+}
+
+int CMAES::runOnce_(int lambda, int generations, const Fitness& fitness, Result& res) {
+    const size_t n = cfg_.dimension;
+    const bool full = options_.covariance == CmaesOptions::Covariance::Full;
+    const double* lo = lower_.data();
+    const double* hi = upper_.data();
+
+    // Strategy parameters, Hansen (2016) "The CMA Evolution Strategy: A Tutorial"
+    const int mu = lambda / 2;
+    std::vector<double> weights(mu);
+    for (int i = 0; i < mu; ++i) weights[i] = std::log(mu + 0.5) - std::log(i + 1.0);
+    const double wsum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    double wsq = 0.0;
+    for (double& w : weights) {
+        w /= wsum;
+        wsq += w * w;
+    }
+    const double mueff = 1.0 / wsq;
+    const double dn = static_cast<double>(n);
+
+    const double cs = (mueff + 2.0) / (dn + mueff + 5.0);
+    const double ds = 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff - 1.0) / (dn + 1.0)) - 1.0) + cs;
+    const double cc = (4.0 + mueff / dn) / (dn + 4.0 + 2.0 * mueff / dn);
+    double c1 = 2.0 / ((dn + 1.3) * (dn + 1.3) + mueff);
+    double cmu = std::min(1.0 - c1, 2.0 * (mueff - 2.0 + 1.0 / mueff) / ((dn + 2.0) * (dn + 2.0) + mueff));
+    if (!full) {
+        // sep-CMA (Ros & Hansen 2008): a diagonal has only n free parameters,
+        // so it can learn (n + 2) / 3 times faster
+        c1 = std::min(1.0, c1 * (dn + 2.0) / 3.0);
+        cmu = std::min(1.0 - c1, cmu * (dn + 2.0) / 3.0);
+    }
+    const double chiN = std::sqrt(dn) * (1.0 - 1.0 / (4.0 * dn) + 1.0 / (21.0 * dn * dn));
+    const int eigenInterval = options_.eigenInterval > 0
+        ? options_.eigenInterval
+        : std::max(1, static_cast<int>(1.0 / (10.0 * dn * (c1 + cmu))));
+
+    // Initial state: uniform mean in the bounds, isotropic covariance
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    mean_.resize(n);
+    double width = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+        mean_[j] = lo[j] + unit(rng_) * (hi[j] - lo[j]);
+        width += hi[j] - lo[j];
+    }
+    sigma_ = options_.sigma0 > 0 ? options_.sigma0 : 0.3 * width / dn;
+    pathSigma_.assign(n, 0.0);
+    pathC_.assign(n, 0.0);
+    scale_.assign(n, 1.0);
+    if (full) {
+        cov_.assign(n * n, 0.0);
+        eigenvectors_.assign(n * n, 0.0);
+        for (size_t i = 0; i < n; ++i) cov_[i * n + i] = eigenvectors_[i * n + i] = 1.0;
+    } else {
+        cov_.assign(n, 1.0);
+        eigenvectors_.clear();
+    }
+
+    z_.resize(lambda * n);
+    y_.resize(lambda * n);
+    x_.resize(n);
+    fitness_.resize(lambda);
+    order_.resize(lambda);
+    weighted_.resize(mu * n);
+    step_.resize(n);
+    tmp_.resize(n);
+
+    // Best fitness of the most recent generations, for the tolFun criterion
+    const size_t historyLength = 10 + static_cast<size_t>(std::ceil(30.0 * dn / lambda));
+    std::vector<double> recentBest;
+    recentBest.reserve(historyLength);
+    size_t recentPos = 0;
+
+    int lastEigen = 0;
+    int gen = 0;
+    while (gen < generations) {
+        if (budgetSpent_()) break;
+        sample_(lambda);
+
+        double sum = 0.0;
+        for (int k = 0; k < lambda; ++k) {
+            double* y = &y_[k * n];
+            for (size_t j = 0; j < n; ++j) {
+                const double v = std::min(hi[j], std::max(lo[j], mean_[j] + sigma_ * y[j]));
+                x_[j] = v;
+                y[j] = (v - mean_[j]) / sigma_; // adapt on the projected step
+            }
+            const double f = fitness(x_);
+            ++evaluations_;
+            fitness_[k] = f;
+            sum += f;
+            if (f > res.bestFitness) {
+                res.bestFitness = f;
+                res.bestGenes = x_;
+            }
+        }
+        ++gen;
+        res.bestHistory.push_back(res.bestFitness);
+        res.avgHistory.push_back(sum / lambda);
+
+        std::iota(order_.begin(), order_.end(), 0);
+        std::partial_sort(order_.begin(), order_.begin() + mu, order_.end(),
+                          [&](size_t a, size_t b) { return fitness_[a] > fitness_[b]; });
+
+        // Recombination: weighted mean step of the mu best
+        std::fill(step_.begin(), step_.end(), 0.0);
+        for (int i = 0; i < mu; ++i) {
+            const double* y = &y_[order_[i] * n];
+            double* wrow = &weighted_[i * n];
+            const double w = weights[i];
+            const double root = std::sqrt(w);
+            for (size_t j = 0; j < n; ++j) {
+                step_[j] += w * y[j];
+                wrow[j] = root * y[j];
+            }
+        }
+        for (size_t j = 0; j < n; ++j) mean_[j] += sigma_ * step_[j];
+
+        // tmp = C^-1/2 step
+        if (full) {
+            for (size_t j = 0; j < n; ++j) {
+                const double* b = &eigenvectors_[j * n];
+                double dot = 0.0;
+                for (size_t i = 0; i < n; ++i) dot += b[i] * step_[i];
+                x_[j] = dot / scale_[j];
+            }
+            std::fill(tmp_.begin(), tmp_.end(), 0.0);
+            for (size_t j = 0; j < n; ++j) {
+                const double* b = &eigenvectors_[j * n];
+                const double s = x_[j];
+                for (size_t i = 0; i < n; ++i) tmp_[i] += s * b[i];
+            }
+        } else {
+            for (size_t j = 0; j < n; ++j) tmp_[j] = step_[j] / scale_[j];
+        }
+
+        const double csn = std::sqrt(cs * (2.0 - cs) * mueff);
+        double normSigma = 0.0;
+        for (size_t j = 0; j < n; ++j) {
+            pathSigma_[j] = (1.0 - cs) * pathSigma_[j] + csn * tmp_[j];
+            normSigma += pathSigma_[j] * pathSigma_[j];
+        }
+        normSigma = std::sqrt(normSigma);
+        const double correction = std::sqrt(1.0 - std::pow(1.0 - cs, 2.0 * gen));
+        const bool hsig = normSigma / correction / chiN < 1.4 + 2.0 / (dn + 1.0);
+
+        const double ccn = hsig ? std::sqrt(cc * (2.0 - cc) * mueff) : 0.0;
+        for (size_t j = 0; j < n; ++j) pathC_[j] = (1.0 - cc) * pathC_[j] + ccn * step_[j];
+
+        const double decay = 1.0 - c1 - cmu + (hsig ? 0.0 : c1 * cc * (2.0 - cc));
+        if (full) {
+            covarianceUpdateBlocked(cov_.data(), n, decay, c1, pathC_.data(), cmu, weighted_.data(), mu);
+        } else {
+            for (size_t j = 0; j < n; ++j) {
+                double rankMu = 0.0;
+                for (int i = 0; i < mu; ++i) {
+                    const double v = weighted_[i * n + j];
+                    rankMu += v * v;
+                }
+                cov_[j] = decay * cov_[j] + c1 * pathC_[j] * pathC_[j] + cmu * rankMu;
+                scale_[j] = std::sqrt(cov_[j]);
+            }
+        }
+
+        sigma_ *= std::exp(std::min(1.0, (cs / ds) * (normSigma / chiN - 1.0)));
+
+        if (full && gen - lastEigen >= eigenInterval) {
+            updateEigensystem_();
+            lastEigen = gen;
+        }
+
+        // Stopping criteria
+        if (!std::isfinite(sigma_) || sigma_ <= 0.0) break;
+
+        const double genBest = fitness_[order_[0]];
+        if (recentBest.size() < historyLength) {
+            recentBest.push_back(genBest);
+        } else {
+            recentBest[recentPos] = genBest;
+            recentPos = (recentPos + 1) % historyLength;
+        }
+        if (recentBest.size() == historyLength) {
+            const auto mm = std::minmax_element(recentBest.begin(), recentBest.end());
+            const double genRange = genBest - fitness_[order_[lambda - 1]];
+            if (*mm.second - *mm.first < options_.tolFun && genRange < options_.tolFun) break;
+        }
+
+        bool small = true;
+        for (size_t j = 0; j < n && small; ++j) {
+            const double cjj = full ? cov_[j * n + j] : cov_[j];
+            small = sigma_ * std::sqrt(cjj) < options_.tolX && sigma_ * std::fabs(pathC_[j]) < options_.tolX;
+        }
+        if (small) break;
+
+        const auto se = std::minmax_element(scale_.begin(), scale_.end());
+        if (*se.second > 1e7 * *se.first) break; // condition number of C above 1e14
+    }
+    return gen;
+}
+
+Result CMAES::run(const Fitness& fitness) {
+    if (cfg_.dimension <= 0) throw std::invalid_argument("CMA-ES needs a positive dimension");
+    resolveBounds(cfg_, lower_, upper_);
+    for (size_t j = 0; j < lower_.size(); ++j) {
+        if (!(lower_[j] < upper_[j])) throw std::invalid_argument("CMA-ES needs lower < upper bounds");
+    }
+    if (options_.lambda == 1) throw std::invalid_argument("CMA-ES needs lambda >= 2");
+
+    const size_t n = cfg_.dimension;
+    int lambda = options_.lambda > 0
+        ? options_.lambda
+        : 4 + static_cast<int>(std::floor(3.0 * std::log(static_cast<double>(n))));
+
+    evaluations_ = 0;
+    restartsUsed_ = 0;
+
+    Result res;
+    res.bestGenes.resize(n);
+    res.bestHistory.reserve(cfg_.generations);
+    res.avgHistory.reserve(cfg_.generations);
+
+    int remaining = cfg_.generations;
+    while (remaining > 0) {
+        remaining -= runOnce_(lambda, remaining, fitness, res);
+        if (remaining <= 0 || budgetSpent_() || restartsUsed_ >= options_.restarts) break;
+        // IPOP: restart from a fresh random mean with twice the population
+        ++restartsUsed_;
+        lambda *= 2;
+    }
+    res.evaluations = evaluations_;
+    return res;
+}
+
+} // namespace ga
@@ -0,0 +1,270 @@
+#include "ga/differential_evolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "crossover/differential_evolution_crossover.h"
+#include "ga/bounds.hpp"
+#include "ga/parallel.hpp"
+
+namespace ga {
+
+static std::mt19937 make_rng(unsigned seed) {
+    if (seed == 0) {
+        std::random_device rd;
+        return std::mt19937{rd()};
+    }
+    return std::mt19937{seed};
+}
+
+DifferentialEvolution::DifferentialEvolution(const Config& cfg, const DeOptions& options)
+    : cfg_(cfg), options_(options), rng_(make_rng(cfg.seed)) {
+    crossover_ = cfg.seed == 0
+        ? std::make_unique<DifferentialEvolutionCrossover>(cfg.crossoverRate)
+        : std::make_unique<DifferentialEvolutionCrossover>(cfg.crossoverRate, cfg.seed);
+}
+
+DifferentialEvolution::~DifferentialEvolution() = default;
+
+void DifferentialEvolution::setCrossoverOperator(std::unique_ptr<DifferentialEvolutionCrossover> op) {
+    crossover_ = std::move(op);
+}
+
+Result DifferentialEvolution::run(const Fitness& fitness) {
+    const int workers = resolveThreads(cfg_.threads);
+    scratch_.resize(workers);
+    for (auto& genes : scratch_) genes.resize(cfg_.dimension);
+
+    return run_([&](const double* genes, size_t count, size_t dimension, double* out) {
+        parallelFor(count, workers, [&](size_t begin, size_t end, size_t worker) {
+            std::vector<double>& x = scratch_[worker];
+            for (size_t i = begin; i < end; ++i) {
+                std::copy(genes + i * dimension, genes + (i + 1) * dimension, x.begin());
+                out[i] = fitness(x);
+            }
+        });
+    });
+}
+
+Result DifferentialEvolution::run(const BatchFitness& fitness) {
+    return run_(fitness);
+}
+
+void DifferentialEvolution::sampleParameters_() {
+    const size_t np = F_.size();
+    if (options_.adaptation == DeOptions::Adaptation::None) {
+        std::fill(F_.begin(), F_.end(), options_.F);
+        std::fill(CR_.begin(), CR_.end(), crossover_->getCrossoverRate());
+        return;
+    }
+
+    std::uniform_int_distribution<size_t> slot(0, memoryF_.size() - 1);
+    for (size_t i = 0; i < np; ++i) {
+        const size_t r = slot(rng_);
+        std::normal_distribution<double> cr(memoryCR_[r], 0.1);
+        std::cauchy_distribution<double> f(memoryF_[r], 0.1);
+        CR_[i] = std::min(1.0, std::max(0.0, cr(rng_)));
+        double F;
+        do { F = f(rng_); } while (F <= 0.0);
+        F_[i] = std::min(1.0, F);
+    }
+}
+
+void DifferentialEvolution::makeTrials_(size_t best, size_t topCount) {
+    const size_t np = cfg_.populationSize;
+    const size_t n = cfg_.dimension;
+    const double* lo = lower_.data();
+    const double* hi = upper_.data();
+    std::uniform_int_distribution<size_t> pick(0, np - 1);
+    std::uniform_int_distribution<size_t> pickTop(0, topCount - 1);
+    std::uniform_int_distribution<size_t> pickUnion(0, np + archiveSize_ - 1);
+
+    auto distinct = [&](std::initializer_list<size_t> taken) {
+        size_t r;
+        do { r = pick(rng_); } while (std::find(taken.begin(), taken.end(), r) != taken.end());
+        return r;
+    };
+
+    for (size_t i = 0; i < np; ++i) {
+        const double* x = &population_[i * n];
+        double* v = &trials_[i * n];
+        const double F = F_[i];
+
+        switch (options_.strategy) {
+        case DeOptions::Strategy::Rand1: {
+            const size_t r1 = distinct({i});
+            const size_t r2 = distinct({i, r1});
+            const size_t r3 = distinct({i, r1, r2});
+            const double* a = &population_[r1 * n];
+            const double* b = &population_[r2 * n];
+            const double* c = &population_[r3 * n];
+            for (size_t j = 0; j < n; ++j) v[j] = a[j] + F * (b[j] - c[j]);
+            break;
+        }
+        case DeOptions::Strategy::Best1: {
+            const size_t r1 = distinct({i});
+            const size_t r2 = distinct({i, r1});
+            const double* a = &population_[best * n];
+            const double* b = &population_[r1 * n];
+            const double* c = &population_[r2 * n];
+            for (size_t j = 0; j < n; ++j) v[j] = a[j] + F * (b[j] - c[j]);
+            break;
+        }
+        case DeOptions::Strategy::CurrentToPBest1: {
+            const size_t pb = order_[pickTop(rng_)];
+            const size_t r1 = distinct({i});
+            size_t r2;
+            do { r2 = pickUnion(rng_); } while (r2 == i || r2 == r1);
+            const double* p = &population_[pb * n];
+            const double* b = &population_[r1 * n];
+            const double* c = r2 < np ? &population_[r2 * n] : &archive_[(r2 - np) * n];
+            for (size_t j = 0; j < n; ++j) v[j] = x[j] + F * (p[j] - x[j]) + F * (b[j] - c[j]);
+            break;
+        }
+        }
+
+        for (size_t j = 0; j < n; ++j) {
+            v[j] = repairGene(BoundHandling::MidpointToParent, v[j], lo[j], hi[j], x[j], 0.0);
+        }
+        crossover_->binomialInto(ConstRealSpan(x, n), ConstRealSpan(v, n), RealSpan(v, n), CR_[i]);
+    }
+}
+
+void DifferentialEvolution::adapt_() {
+    if (options_.adaptation == DeOptions::Adaptation::None || goodF_.empty()) return;
+
+    double sumW = 0.0, sumF = 0.0, sumF2 = 0.0, sumCR = 0.0;
+    for (size_t k = 0; k < goodF_.size(); ++k) {
+        // JADE weighs successes equally, SHADE by fitness improvement
+        const double w = options_.adaptation == DeOptions::Adaptation::SHADE ? gains_[k] : 1.0;
+        sumW += w;
+        sumF += w * goodF_[k];
+        sumF2 += w * goodF_[k] * goodF_[k];
+        sumCR += w * goodCR_[k];
+    }
+    if (sumW > 0.0 && sumF > 0.0) {
+        const double lehmerF = sumF2 / sumF;
+        const double meanCR = sumCR / sumW;
+        if (options_.adaptation == DeOptions::Adaptation::JADE) {
+            const double c = options_.learningRate;
+            memoryF_[0] = (1.0 - c) * memoryF_[0] + c * lehmerF;
+            memoryCR_[0] = (1.0 - c) * memoryCR_[0] + c * meanCR;
+        } else {
+            memoryF_[memoryPos_] = lehmerF;
+            memoryCR_[memoryPos_] = meanCR;
+            memoryPos_ = (memoryPos_ + 1) % memoryF_.size();
+        }
+    }
+    goodF_.clear();
+    goodCR_.clear();
+    gains_.clear();
+}
+
+Result DifferentialEvolution::run_(const BatchFitness& fitness) {
+    if (!crossover_) throw std::runtime_error("Operators not set");
+    if (cfg_.populationSize < 4) throw std::invalid_argument("Differential evolution needs populationSize >= 4");
+    if (cfg_.dimension <= 0) throw std::invalid_argument("Differential evolution needs a positive dimension");
+    resolveBounds(cfg_, lower_, upper_);
+    for (size_t j = 0; j < lower_.size(); ++j) {
+        if (!(lower_[j] < upper_[j])) throw std::invalid_argument("Differential evolution needs lower < upper bounds");
+    }
+
+    const size_t np = cfg_.populationSize;
+    const size_t n = cfg_.dimension;
+    const bool pbest = options_.strategy == DeOptions::Strategy::CurrentToPBest1;
+    const bool useArchive = pbest && options_.archive;
+
+    population_.resize(np * n);
+    trials_.resize(np * n);
+    archive_.resize(useArchive ? np * n : 0);
+    archiveSize_ = 0;
+    fitness_.resize(np);
+    trialFitness_.resize(np);
+    F_.resize(np);
+    CR_.resize(np);
+    goodF_.clear();
+    goodCR_.clear();
+    gains_.clear();
+    goodF_.reserve(np);
+    goodCR_.reserve(np);
+    gains_.reserve(np);
+    order_.resize(np);
+
+    const size_t slots = options_.adaptation == DeOptions::Adaptation::SHADE
+        ? static_cast<size_t>(std::max(1, options_.memorySize)) : 1;
+    memoryF_.assign(slots, options_.F);
+    memoryCR_.assign(slots, crossover_->getCrossoverRate());
+    memoryPos_ = 0;
+
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (size_t i = 0; i < np * n; ++i) population_[i] = lower_[i % n] + unit(rng_) * (upper_[i % n] - lower_[i % n]);
+    fitness(population_.data(), np, n, fitness_.data());
+    evaluations_ = np;
+
+    Result res;
+    res.bestGenes.resize(n);
+    res.bestHistory.reserve(cfg_.generations + 1);
+    res.avgHistory.reserve(cfg_.generations + 1);
+
+    size_t best = 0;
+    auto record = [&]() {
+        double sum = 0.0;
+        best = 0;
+        for (size_t i = 0; i < np; ++i) {
+            sum += fitness_[i];
+            if (fitness_[i] > fitness_[best]) best = i;
+        }
+        if (fitness_[best] > res.bestFitness) {
+            res.bestFitness = fitness_[best];
+            std::copy(&population_[best * n], &population_[best * n] + n, res.bestGenes.begin());
+        }
+        res.bestHistory.push_back(fitness_[best]);
+        res.avgHistory.push_back(sum / np);
+    };
+    record();
+
+    const size_t topCount = std::max<size_t>(1, static_cast<size_t>(std::round(options_.pBest * np)));
+    std::uniform_int_distribution<size_t> pickArchive(0, np - 1);
+
+    for (int gen = 0; gen < cfg_.generations; ++gen) {
+        if (cfg_.maxEvaluations > 0 && evaluations_ >= cfg_.maxEvaluations) break;
+        if (pbest) {
+            std::iota(order_.begin(), order_.end(), 0);
+            std::nth_element(order_.begin(), order_.begin() + (topCount - 1), order_.end(),
+                             [&](size_t a, size_t b) { return fitness_[a] > fitness_[b]; });
+        }
+        sampleParameters_();
+        makeTrials_(best, topCount);
+
+        fitness(trials_.data(), np, n, trialFitness_.data());
+        evaluations_ += np;
+
+        // One-to-one survivor selection; ties go to the trial so the
+        // population can drift across plateaus
+        for (size_t i = 0; i < np; ++i) {
+            if (trialFitness_[i] < fitness_[i]) continue;
+            double* x = &population_[i * n];
+            if (trialFitness_[i] > fitness_[i]) {
+                goodF_.push_back(F_[i]);
+                goodCR_.push_back(CR_[i]);
+                gains_.push_back(trialFitness_[i] - fitness_[i]);
+                if (useArchive) {
+                    // Full archive: a random member makes room
+                    const size_t slot = archiveSize_ < np ? archiveSize_++ : pickArchive(rng_);
+                    std::copy(x, x + n, &archive_[slot * n]);
+                }
+            }
+            std::copy(&trials_[i * n], &trials_[i * n] + n, x);
+            fitness_[i] = trialFitness_[i];
+        }
+
+        adapt_();
+        record();
+    }
+    res.evaluations = evaluations_;
+    return res;
+}
+
+} // namespace ga
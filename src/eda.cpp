@@ -0,0 +1,230 @@
+#include "ga/eda.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "common/recombination_kernels.h"
+#include "ga/parallel.hpp"
+
+namespace ga {
+
+namespace {
+
+// A sample's uniforms depend only on its key and the bit index, so drawing
+// them is a data-parallel loop
+using recombination_kernels::hash32;
+
+// Gathers the low bits of eight 0/1 bytes (little-endian) into bits 0..7
+constexpr uint64_t kPackBytes = 0x0102040810204080ULL;
+
+constexpr double kThresholdScale = 2147483648.0; // 2^31
+
+} // namespace
+
+static std::mt19937 make_rng(unsigned seed) {
+    if (seed == 0) {
+        std::random_device rd;
+        return std::mt19937{rd()};
+    }
+    return std::mt19937{seed};
+}
+
+EDA::EDA(const Config& cfg, const EdaOptions& options)
+    : cfg_(cfg), options_(options), rng_(make_rng(cfg.seed)) {
+    if (cfg.dimension <= 0) throw std::invalid_argument("EDA needs at least one bit");
+    if (cfg.populationSize < 2) throw std::invalid_argument("EDA needs at least two samples per generation");
+    if (!(options.selectionRatio > 0.0 && options.selectionRatio <= 1.0)) {
+        throw std::invalid_argument("Selection ratio must be in (0, 1]");
+    }
+    if (!(options.learningRate > 0.0 && options.learningRate <= 1.0)) {
+        throw std::invalid_argument("Learning rate must be in (0, 1]");
+    }
+    if (options.virtualPopulation < 0) throw std::invalid_argument("Virtual population must be non-negative");
+}
+
+void EDA::clampMarginal_(double& p) const {
+    // For L <= 2 the borders [1/L, 1 - 1/L] would pin p at 0.5 or invert it
+    const double lo = options_.borders && length_ > 2 ? 1.0 / length_ : 0.0;
+    p = std::min(1.0 - lo, std::max(lo, p));
+}
+
+void EDA::thresholds_() {
+    for (size_t i = 0; i < length_; ++i) {
+        threshold_[i] = static_cast<uint32_t>(std::llround(p_[i] * kThresholdScale));
+    }
+}
+
+void EDA::drawKeys_(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        keys_[i] = (static_cast<uint64_t>(rng_()) << 32) | rng_();
+    }
+}
+
+void EDA::sample_(size_t index, size_t worker) {
+    const uint32_t k1 = static_cast<uint32_t>(keys_[index]);
+    const uint32_t k2 = static_cast<uint32_t>(keys_[index] >> 32);
+    uint32_t* r = uniforms_[worker].data();
+    uint8_t* mask = masks_[worker].data();
+    const uint32_t* t = threshold_.data();
+    // Locals: byte stores may alias any member, which would stop vectorisation
+    const size_t length = length_;
+    const size_t words = words_;
+
+    // Two keyed rounds, so streams of different samples do not overlap
+    for (size_t i = 0; i < length; ++i) r[i] = hash32(hash32(static_cast<uint32_t>(i) + k1) ^ k2) >> 1;
+    for (size_t i = 0; i < length; ++i) mask[i] = static_cast<uint8_t>(r[i] < t[i]);
+
+    // The mask's tail past length_ stays zero, so whole groups can be packed
+    uint64_t* out = &samples_[index * words];
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t word = 0;
+        for (size_t g = 0; g < 8; ++g) {
+            uint64_t bytes;
+            std::memcpy(&bytes, mask + w * 64 + g * 8, sizeof bytes);
+            word |= ((bytes * kPackBytes) >> 56) << (g * 8);
+        }
+        out[w] = word;
+    }
+}
+
+void EDA::update_(size_t selected) {
+    // One pass over the selected samples' words counts the ones per bit
+    std::fill(counts_.begin(), counts_.end(), 0u);
+    for (size_t s = 0; s < selected; ++s) {
+        const uint64_t* row = &samples_[order_[s] * words_];
+        for (size_t w = 0; w < words_; ++w) {
+            const uint64_t word = row[w];
+            uint32_t* c = &counts_[w * 64];
+            const size_t bits = std::min<size_t>(64, length_ - w * 64);
+            for (size_t b = 0; b < bits; ++b) c[b] += static_cast<uint32_t>((word >> b) & 1u);
+        }
+    }
+
+    const double inv = 1.0 / selected;
+    const bool umda = options_.algorithm == EdaOptions::Algorithm::UMDA;
+    const double rate = umda ? 1.0 : options_.learningRate;
+    for (size_t i = 0; i < length_; ++i) {
+        p_[i] += rate * (counts_[i] * inv - p_[i]);
+        clampMarginal_(p_[i]);
+    }
+    thresholds_();
+}
+
+void EDA::compete_(const uint64_t* winner, const uint64_t* loser, double step) {
+    // Only bits where the two samples differ move
+    for (size_t w = 0; w < words_; ++w) {
+        const uint64_t diff = winner[w] ^ loser[w];
+        if (diff == 0) continue;
+        for (size_t b = 0; b < 64; ++b) {
+            if (!((diff >> b) & 1u)) continue;
+            const size_t i = w * 64 + b;
+            p_[i] += ((winner[w] >> b) & 1u) ? step : -step;
+            clampMarginal_(p_[i]);
+            threshold_[i] = static_cast<uint32_t>(std::llround(p_[i] * kThresholdScale));
+        }
+    }
+}
+
+Result EDA::run(const Fitness& fitness) {
+    return run([&](const uint64_t* words, size_t length) {
+        std::vector<double> genes(length);
+        for (size_t i = 0; i < length; ++i) genes[i] = static_cast<double>((words[i / 64] >> (i % 64)) & 1u);
+        return fitness(genes);
+    });
+}
+
+Result EDA::run(const BitFitness& fitness) {
+    length_ = static_cast<size_t>(cfg_.dimension);
+    words_ = (length_ + 63) / 64;
+    const size_t n = static_cast<size_t>(cfg_.populationSize);
+    const bool compact = options_.algorithm == EdaOptions::Algorithm::CompactGA;
+    const size_t rows = compact ? 2 : n;
+    const int threads = compact ? 1 : resolveThreads(cfg_.threads);
+    const size_t workers = std::min(rows, static_cast<size_t>(threads));
+
+    // Everything is sized once; generations only overwrite
+    p_.assign(length_, 0.5);
+    threshold_.assign(length_, 0);
+    thresholds_();
+    samples_.assign(rows * words_, 0);
+    fitness_.assign(rows, 0.0);
+    keys_.assign(rows, 0);
+    uniforms_.assign(workers, std::vector<uint32_t>(length_));
+    masks_.assign(workers, std::vector<uint8_t>(words_ * 64, 0));
+    counts_.assign(words_ * 64, 0);
+    order_.resize(rows);
+    best_.assign(words_, 0);
+    evaluations_ = 0;
+
+    const size_t selected = std::max<size_t>(1, static_cast<size_t>(std::round(options_.selectionRatio * n)));
+    const size_t tournaments = std::max<size_t>(1, n / 2);
+    const double step = 1.0 / (options_.virtualPopulation > 0 ? options_.virtualPopulation : cfg_.populationSize);
+
+    Result res;
+    res.bestHistory.reserve(cfg_.generations + 1);
+    res.avgHistory.reserve(cfg_.generations + 1);
+
+    auto keepBest = [&](size_t row) {
+        if (fitness_[row] > res.bestFitness) {
+            res.bestFitness = fitness_[row];
+            std::copy(&samples_[row * words_], &samples_[row * words_] + words_, best_.begin());
+        }
+    };
+
+    for (int gen = 0; gen <= cfg_.generations; ++gen) {
+        if (gen > 0 && cfg_.maxEvaluations > 0 && evaluations_ >= cfg_.maxEvaluations) break;
+
+        double genBest = -std::numeric_limits<double>::infinity();
+        double genSum = 0.0;
+        if (compact) {
+            for (size_t t = 0; t < tournaments; ++t) {
+                drawKeys_(2);
+                for (size_t s = 0; s < 2; ++s) {
+                    sample_(s, 0);
+                    fitness_[s] = fitness(&samples_[s * words_], length_);
+                    genBest = std::max(genBest, fitness_[s]);
+                    genSum += fitness_[s];
+                    keepBest(s);
+                }
+                evaluations_ += 2;
+                const size_t win = fitness_[1] > fitness_[0] ? 1 : 0;
+                compete_(&samples_[win * words_], &samples_[(1 - win) * words_], step);
+            }
+            res.avgHistory.push_back(genSum / (2 * tournaments));
+        } else {
+            if (gen > 0) {
+                std::iota(order_.begin(), order_.end(), size_t{0});
+                std::partial_sort(order_.begin(), order_.begin() + selected, order_.end(), [&](size_t a, size_t b) {
+                    return fitness_[a] != fitness_[b] ? fitness_[a] > fitness_[b] : a < b;
+                });
+                update_(selected);
+            }
+            drawKeys_(n);
+            parallelFor(n, threads, [&](size_t begin, size_t end, size_t worker) {
+                for (size_t i = begin; i < end; ++i) {
+                    sample_(i, worker);
+                    fitness_[i] = fitness(&samples_[i * words_], length_);
+                }
+            });
+            evaluations_ += n;
+            for (size_t i = 0; i < n; ++i) {
+                genBest = std::max(genBest, fitness_[i]);
+                genSum += fitness_[i];
+                keepBest(i);
+            }
+            res.avgHistory.push_back(genSum / n);
+        }
+        res.bestHistory.push_back(genBest);
+    }
+
+    res.bestGenes.resize(length_);
+    for (size_t i = 0; i < length_; ++i) res.bestGenes[i] = static_cast<double>((best_[i / 64] >> (i % 64)) & 1u);
+    res.evaluations = evaluations_;
+    return res;
+}
+
+} // namespace ga
@@ -2,9 +2,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <numeric>
 #include <stdexcept>
 
+#include "ga/parallel.hpp"
+#include "variation.hpp"
+
 // Use existing operators
 #include "mutation/gaussian_mutation.h"
 #include "mutation/uniform_mutation.h"
@@ -40,56 +44,188 @@ void GeneticAlgorithm::setCrossoverOperator(std::unique_ptr<CrossoverOperator> o
     crossover_ = std::move(op);
 }
 
-std::vector<GeneticAlgorithm::Individual> GeneticAlgorithm::initPopulation_(const Fitness& f) {
-    std::uniform_real_distribution<double> dist(cfg_.bounds.lower, cfg_.bounds.upper);
+void GeneticAlgorithm::setDuplicatePolicy(const DuplicateOptions& options) {
+    if (options.quantum < 0.0) throw std::invalid_argument("Duplicate quantum must be non-negative");
+    duplicates_ = options;
+    genomes_ = GenomeHashSet(options.quantum);
+}
+
+std::vector<GeneticAlgorithm::Individual> GeneticAlgorithm::initPopulation_(const Fitness* f, const SeparableFitness* sf) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
     std::vector<Individual> pop;
     pop.reserve(cfg_.populationSize);
     for (int i = 0; i < cfg_.populationSize; ++i) {
         Individual ind;
         ind.genes.resize(cfg_.dimension);
-        for (double& g : ind.genes) g = dist(rng_);
-        ind.fitness = f(ind.genes);
+        for (size_t j = 0; j < ind.genes.size(); ++j) ind.genes[j] = lower_[j] + unit(rng_) * (upper_[j] - lower_[j]);
+        if (sf) {
+            ind.terms.resize(cfg_.dimension);
+            resumTerms_(ind, *sf, true);
+        } else {
+            ind.fitness = (*f)(ind.genes);
+        }
         pop.push_back(std::move(ind));
     }
     return pop;
 }
 
-pair<GeneticAlgorithm::Individual, GeneticAlgorithm::Individual>
-GeneticAlgorithm::crossoverPair_(const Individual& p1, const Individual& p2, const Fitness& f) {
-    std::uniform_real_distribution<double> prob(0.0, 1.0);
-    if (prob(rng_) < cfg_.crossoverRate) {
-        auto children = crossover_->crossover(p1.genes, p2.genes);
-        Individual c1{children.first, f(children.first)};
-        Individual c2{children.second, f(children.second)};
-        return {std::move(c1), std::move(c2)};
+void GeneticAlgorithm::resumTerms_(Individual& ind, const SeparableFitness& f, bool evaluate) {
+    double sum = 0.0;
+    for (size_t i = 0; i < ind.genes.size(); ++i) {
+        if (evaluate) ind.terms[i] = f.term(i, ind.genes[i]);
+        sum += ind.terms[i];
     }
-    return {p1, p2};
+    ind.termSum = sum;
+    ind.fitness = f.finish ? f.finish(sum) : sum;
 }
 
-void GeneticAlgorithm::mutate_(Individual& ind) {
-    std::vector<double> lows(cfg_.dimension, cfg_.bounds.lower);
-    std::vector<double> highs(cfg_.dimension, cfg_.bounds.upper);
-    if (auto* g = dynamic_cast<GaussianMutation*>(mutation_.get())) {
-        g->mutate(ind.genes, cfg_.mutationRate, 0.1, lows, highs);
-    } else if (auto* u = dynamic_cast<UniformMutation*>(mutation_.get())) {
-        u->mutate(ind.genes, cfg_.mutationRate, lows, highs);
+void GeneticAlgorithm::scoreSeparable_(Individual& child, const Individual& p1, const Individual& p2,
+                                       const SeparableFitness& f) {
+    // A gene equal to p1's keeps p1's term, one equal to p2's (taken over by
+    // crossover) reuses p2's term; only blended or mutated genes call term().
+    // The sum is p1's plus the changed terms' deltas.
+    double sum = p1.termSum;
+    for (size_t i = 0; i < child.genes.size(); ++i) {
+        const double g = child.genes[i];
+        if (g == p1.genes[i]) {
+            child.terms[i] = p1.terms[i];
+            continue;
+        }
+        const double t = g == p2.genes[i] ? p2.terms[i] : f.term(i, g);
+        sum += t - p1.terms[i];
+        child.terms[i] = t;
+    }
+    child.termSum = sum;
+    child.fitness = f.finish ? f.finish(sum) : sum;
+}
+
+void GeneticAlgorithm::breed_(const detail::GeneMutation& mutation, const std::vector<double>& source,
+                              const Individual& p1, const Individual& p2, Individual& child,
+                              const SeparableFitness* terms) {
+    const uint32_t key1 = static_cast<uint32_t>(rng_());
+    const uint32_t key2 = static_cast<uint32_t>(rng_());
+    const size_t n = child.genes.size();
+    const double* in = source.data();
+    double* out = child.genes.data();
+    if (!terms) {
+        detail::breedReal(mutation, in, p1.genes.data(), out, n, lower_.data(), upper_.data(), key1, key2);
+        return;
+    }
+    // As scoreSeparable_, folded into the gene loop
+    double sum = p1.termSum;
+    for (size_t i = 0; i < n; ++i) {
+        const double g = mutation.apply(in[i], i, lower_[i], upper_[i], p1.genes[i], key1, key2);
+        out[i] = g;
+        if (g == p1.genes[i]) {
+            child.terms[i] = p1.terms[i];
+            continue;
+        }
+        const double t = g == p2.genes[i] ? p2.terms[i] : terms->term(i, g);
+        sum += t - p1.terms[i];
+        child.terms[i] = t;
     }
-    for (double& x : ind.genes) {
-        if (x < cfg_.bounds.lower) x = cfg_.bounds.lower;
-        if (x > cfg_.bounds.upper) x = cfg_.bounds.upper;
+    child.termSum = sum;
+    child.fitness = terms->finish ? terms->finish(sum) : sum;
+}
+
+size_t GeneticAlgorithm::refineElites_(std::vector<Individual>& pop, std::vector<size_t>& idx, const Fitness& fitness,
+                                       const SeparableFitness* separable, size_t remaining, Individual& learned) {
+    const size_t count = std::min(pop.size(), static_cast<size_t>(std::max(0, localSearch_.elites)));
+    if (count == 0) return 0;
+    // Split the budget before the workers start so results do not depend
+    // on the thread count
+    const size_t perIndividual = std::min(localSearch_.evaluations, remaining / count);
+    if (perIndividual == 0) return 0;
+
+    std::iota(idx.begin(), idx.end(), 0);
+    std::nth_element(idx.begin(), idx.begin() + (count - 1), idx.end(),
+                     [&](size_t i, size_t j) { return pop[i].fitness > pop[j].fitness; });
+
+    const bool lamarckian = localSearch_.inheritance == LocalSearchOptions::Inheritance::Lamarckian;
+    std::vector<std::vector<double>> learnedGenes(lamarckian ? 0 : count);
+    std::vector<size_t> spent(count);
+    parallelFor(count, resolveThreads(cfg_.threads), [&](size_t begin, size_t end, size_t) {
+        for (size_t t = begin; t < end; ++t) {
+            Individual& ind = pop[idx[t]];
+            size_t budget = perIndividual;
+            if (lamarckian) {
+                const double before = ind.fitness;
+                ind.fitness = refine(localSearch_, fitness, ind.genes, ind.fitness, lower_, upper_, budget);
+                // Moved genes need fresh terms; the sum is rebuilt with them
+                if (separable && ind.fitness != before) resumTerms_(ind, *separable, true);
+            } else {
+                learnedGenes[t] = ind.genes;
+                ind.fitness = refine(localSearch_, fitness, learnedGenes[t], ind.fitness, lower_, upper_, budget);
+                ind.refined = true;
+            }
+            spent[t] = perIndividual - budget;
+        }
+    });
+
+    size_t total = 0;
+    for (size_t t = 0; t < count; ++t) {
+        total += spent[t];
+        if (!lamarckian && pop[idx[t]].fitness > learned.fitness) {
+            learned.genes.swap(learnedGenes[t]);
+            learned.fitness = pop[idx[t]].fitness;
+        }
     }
+    return total;
 }
 
 Result GeneticAlgorithm::run(const Fitness& fitness) {
+    return run_(&fitness, nullptr);
+}
+
+Result GeneticAlgorithm::run(const SeparableFitness& fitness) {
+    if (!fitness.term) throw std::invalid_argument("SeparableFitness needs a term function");
+    return run_(nullptr, &fitness);
+}
+
+Result GeneticAlgorithm::run_(const Fitness* fitness, const SeparableFitness* separable) {
     if (!crossover_ || !mutation_) throw std::runtime_error("Operators not set");
 
-    auto pop = initPopulation_(fitness);
+    resolveBounds(cfg_, lower_, upper_);
+    const detail::GeneMutation mutation = detail::resolveMutation(*mutation_, cfg_.mutationRate, cfg_.boundHandling);
+    detail::shareBounds(*crossover_, lower_, upper_);
+
+    auto pop = initPopulation_(fitness, separable);
+
+    // Everything the generation loop touches is sized here once; the loop
+    // itself only overwrites existing storage, so steady state performs no
+    // heap allocation (beyond whatever the fitness function and the
+    // periodic local search do).
+    std::vector<Individual> next(pop.size());
+    for (auto& ind : next) ind.genes.resize(cfg_.dimension);
+    Individual spare;
+    spare.genes.resize(cfg_.dimension);
+    if (separable) {
+        for (auto& ind : next) ind.terms.resize(cfg_.dimension);
+        spare.terms.resize(cfg_.dimension);
+    }
+    std::vector<size_t> idx(pop.size());
 
     Result res;
-    res.bestHistory.reserve(cfg_.generations);
-    res.avgHistory.reserve(cfg_.generations);
+    res.bestGenes.resize(cfg_.dimension);
+    res.bestHistory.reserve(cfg_.generations + 1);
+    res.avgHistory.reserve(cfg_.generations + 1);
+    res.evaluations = pop.size();
+
+    // Local search sees a separable objective as a plain one
+    Fitness separableWhole;
+    if (separable && localSearch_.interval > 0) {
+        separableWhole = [separable](const std::vector<double>& genes) {
+            double sum = 0.0;
+            for (size_t i = 0; i < genes.size(); ++i) sum += separable->term(i, genes[i]);
+            return separable->finish ? separable->finish(sum) : sum;
+        };
+    }
+    const bool lamarckian = localSearch_.inheritance == LocalSearchOptions::Inheritance::Lamarckian;
+    Individual learned; // best Baldwinian refinement, whose genes pop does not hold
+    learned.fitness = -std::numeric_limits<double>::infinity();
 
     std::uniform_int_distribution<int> pick(0, (int)pop.size() - 1);
+    std::uniform_real_distribution<double> prob(0.0, 1.0);
 
     auto compute_stats = [&](const std::vector<Individual>& P){
         double sum = 0.0;
@@ -107,36 +243,133 @@ Result GeneticAlgorithm::run(const Fitness& fitness) {
 
     compute_stats(pop);
 
+    const size_t n = pop.size();
+    const size_t elites = std::min(n, (size_t)std::max(0, (int)std::round(cfg_.eliteRatio * n)));
+    // The archive tracks the best `elites` of the generation being built, fed
+    // as fitnesses arrive; ids are slots of next, i.e. of pop after the swap
+    auto archivePopulation = [&]() {
+        elites_.reset(elites);
+        for (size_t i = 0; i < n; ++i) elites_.offer(i, pop[i].fitness);
+    };
+    archivePopulation();
+
+    const bool dedup = duplicates_.policy != DuplicateOptions::Policy::Keep;
+    // Genome ids: [0, n) are pop members, [n, 2n) are slots of next
+    auto twinOf = [&](size_t id) -> const Individual& { return id < n ? pop[id] : next[id - n]; };
+    // Without duplicate detection every child is scored, so breed_ computes
+    // separable terms in its gene pass; otherwise only children without a
+    // twin pay for them, after the lookup
+    const SeparableFitness* fusedTerms = dedup ? nullptr : separable;
+    // `scored`: breed_ already filled the child's terms and fitness
+    auto score = [&](Individual& child, size_t slot, const Individual& p1, const Individual& p2, bool scored) {
+        uint64_t h = 0;
+        size_t twin = GenomeHashSet::npos;
+        child.refined = false;
+        if (dedup) {
+            h = genomes_.hash(child.genes.data());
+            twin = genomes_.find(child.genes.data(), h);
+            if (twin != GenomeHashSet::npos) ++res.duplicates;
+            if (duplicates_.policy == DuplicateOptions::Policy::Remutate) {
+                for (int a = 0; a < duplicates_.attempts && twin != GenomeHashSet::npos; ++a) {
+                    breed_(mutation, child.genes, p1, p2, child, nullptr);
+                    h = genomes_.hash(child.genes.data());
+                    twin = genomes_.find(child.genes.data(), h);
+                }
+            }
+        }
+        if (twin != GenomeHashSet::npos) {
+            const Individual& t = twinOf(twin);
+            child.fitness = t.fitness;
+            child.refined = t.refined;
+            if (separable) {
+                child.terms = t.terms;
+                child.termSum = t.termSum;
+            }
+            ++res.evaluationsSaved;
+        } else {
+            if (!scored) {
+                if (separable) scoreSeparable_(child, p1, p2, *separable);
+                else child.fitness = (*fitness)(child.genes);
+            }
+            ++res.evaluations;
+        }
+        if (dedup) genomes_.insert(child.genes.data(), h, n + slot);
+        elites_.offer(slot, child.fitness);
+    };
+
     for (int gen = 0; gen < cfg_.generations; ++gen) {
-        // Elitism count
-        int elites = std::max(0, (int)std::round(cfg_.eliteRatio * pop.size()));
-        // Keep top elites
-        std::vector<Individual> next;
-        next.reserve(pop.size());
-        if (elites > 0) {
-            std::vector<size_t> idx(pop.size());
-            std::iota(idx.begin(), idx.end(), 0);
-            std::nth_element(idx.begin(), idx.begin()+elites, idx.end(), [&](size_t i, size_t j){ return pop[i].fitness > pop[j].fitness; });
-            for (int i = 0; i < elites; ++i) next.push_back(pop[idx[i]]);
+        if (cfg_.maxEvaluations > 0 && res.evaluations >= cfg_.maxEvaluations) break;
+
+        // Keep the archived elites, then start archiving the next generation with them
+        for (size_t i = 0; i < elites; ++i) {
+            const Individual& elite = pop[elites_.entries()[i].id];
+            next[i].genes = elite.genes;
+            next[i].fitness = elite.fitness;
+            next[i].refined = elite.refined;
+            if (separable) {
+                next[i].terms = elite.terms;
+                next[i].termSum = elite.termSum;
+            }
+        }
+        elites_.reset(elites);
+        for (size_t i = 0; i < elites; ++i) elites_.offer(i, next[i].fitness);
+        if (dedup) {
+            genomes_.reset(2 * n, cfg_.dimension);
+            for (size_t i = 0; i < n; ++i) genomes_.insert(pop[i].genes.data(), genomes_.hash(pop[i].genes.data()), i);
         }
 
-        // Fill the rest
-        while ((int)next.size() < cfg_.populationSize) {
+        // Fill the rest; an odd tail writes its second child into the spare slot.
+        // Crossover writes straight into the next generation's genes, and one
+        // fused pass per child then mutates, clamps and (separable runs
+        // without duplicate detection) scores it in place.
+        for (size_t i = elites; i < n; i += 2) {
             const auto& p1 = pop[pick(rng_)];
             const auto& p2 = pop[pick(rng_)];
-            auto [c1, c2] = crossoverPair_(p1, p2, fitness);
-            mutate_(c1);
-            mutate_(c2);
-            c1.fitness = fitness(c1.genes);
-            c2.fitness = fitness(c2.genes);
-            next.push_back(std::move(c1));
-            if ((int)next.size() < cfg_.populationSize) next.push_back(std::move(c2));
+            Individual& c1 = next[i];
+            Individual& c2 = (i + 1 < n) ? next[i + 1] : spare;
+            const bool crossed = prob(rng_) < cfg_.crossoverRate;
+            if (crossed) crossover_->crossoverInto(p1.genes, p2.genes, c1.genes, c2.genes);
+            breed_(mutation, crossed ? c1.genes : p1.genes, p1, p2, c1, fusedTerms);
+            score(c1, i, p1, p2, fusedTerms != nullptr);
+            if (&c2 != &spare) {
+                breed_(mutation, crossed ? c2.genes : p2.genes, p2, p1, c2, fusedTerms);
+                score(c2, i + 1, p2, p1, fusedTerms != nullptr);
+            }
         }
 
         pop.swap(next);
+
+        // Both passes below change fitnesses the archive has already seen
+        bool rearchive = false;
+        if (localSearch_.interval > 0 && (gen + 1) % localSearch_.interval == 0) {
+            rearchive = true;
+            const size_t remaining = cfg_.maxEvaluations == 0 ? std::numeric_limits<size_t>::max()
+                : cfg_.maxEvaluations - std::min(cfg_.maxEvaluations, res.evaluations);
+            res.evaluations += refineElites_(pop, idx, separable ? separableWhole : *fitness, separable,
+                                             remaining, learned);
+        }
+        // Incremental sums pick up rounding error; rebuild them from the
+        // stored terms now and then (additions only, no term() calls). A
+        // Baldwinian fitness belongs to refined genes the terms do not
+        // describe, so it survives the rebuild.
+        if (separable && (gen + 1) % kResumInterval == 0) {
+            for (auto& ind : pop) {
+                const double kept = ind.fitness;
+                resumTerms_(ind, *separable, false);
+                if (ind.refined) ind.fitness = kept;
+            }
+            rearchive = true;
+        }
+        if (rearchive) archivePopulation();
         compute_stats(pop);
     }
 
+    // Baldwinian refinement leaves the best fitness on genes that did not
+    // earn it; report the refined point instead
+    if (!lamarckian && learned.fitness >= res.bestFitness && !learned.genes.empty()) {
+        res.bestGenes = learned.genes;
+        res.bestFitness = learned.fitness;
+    }
     return res;
 }
 
@@ -0,0 +1,83 @@
+#include "ga/genome_hash.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace ga {
+
+namespace {
+
+// splitmix64 finaliser: spreads every input bit over the whole word
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+} // namespace
+
+void GenomeHashSet::reset(size_t expected, size_t dimension) {
+    // At most half full, so probe runs stay short
+    size_t capacity = 16;
+    while (capacity < 2 * expected) capacity *= 2;
+    slots_.assign(capacity, Slot());
+    mask_ = capacity - 1;
+    size_ = 0;
+    dimension_ = dimension;
+}
+
+uint64_t GenomeHashSet::key_(double gene) const {
+    if (quantum_ > 0.0) return static_cast<uint64_t>(std::llround(gene / quantum_));
+    if (gene == 0.0) return 0; // +0 and -0 are the same gene
+    uint64_t bits;
+    std::memcpy(&bits, &gene, sizeof bits);
+    return bits;
+}
+
+bool GenomeHashSet::equal_(const double* a, const double* b) const {
+    for (size_t i = 0; i < dimension_; ++i) {
+        if (key_(a[i]) != key_(b[i])) return false;
+    }
+    return true;
+}
+
+uint64_t GenomeHashSet::hash(const double* genes) const {
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ dimension_;
+    for (size_t i = 0; i < dimension_; ++i) h = mix(h ^ key_(genes[i]));
+    return h;
+}
+
+size_t GenomeHashSet::find(const double* genes, uint64_t hash) const {
+    if (slots_.empty()) return npos;
+    for (size_t i = hash & mask_;; i = (i + 1) & mask_) {
+        const Slot& s = slots_[i];
+        if (!s.genes) return npos;
+        if (s.hash == hash && equal_(s.genes, genes)) return s.id;
+    }
+}
+
+void GenomeHashSet::insert(const double* genes, uint64_t hash, size_t id) {
+    if (2 * (size_ + 1) > slots_.size()) grow_();
+    size_t i = hash & mask_;
+    while (slots_[i].genes) i = (i + 1) & mask_;
+    slots_[i] = Slot{hash, genes, id};
+    ++size_;
+}
+
+void GenomeHashSet::grow_() {
+    std::vector<Slot> old;
+    old.swap(slots_);
+    slots_.assign(old.empty() ? 16 : 2 * old.size(), Slot());
+    mask_ = slots_.size() - 1;
+    for (const Slot& s : old) {
+        if (!s.genes) continue;
+        size_t i = s.hash & mask_;
+        while (slots_[i].genes) i = (i + 1) & mask_;
+        slots_[i] = s;
+    }
+}
+
+} // namespace ga
@@ -0,0 +1,303 @@
+#include "ga/gp_evaluator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace ga {
+
+namespace {
+
+constexpr double kProtectEpsilon = 1e-12;
+
+bool parseVariableIndex(const std::string& symbol, uint32_t& index) {
+    if (symbol.size() < 2 || symbol[0] != 'x') return false;
+    for (size_t i = 1; i < symbol.size(); ++i) {
+        if (symbol[i] < '0' || symbol[i] > '9') return false;
+    }
+    index = static_cast<uint32_t>(std::strtoul(symbol.c_str() + 1, nullptr, 10));
+    return true;
+}
+
+bool parseConstant(const std::string& symbol, double& value) {
+    if (symbol.empty()) return false;
+    char* end = nullptr;
+    value = std::strtod(symbol.c_str(), &end);
+    return end == symbol.c_str() + symbol.size();
+}
+
+void checkVariables(const GpProgram& program, const GpDataset& data) {
+    for (const GpInstruction& ins : program.code) {
+        if (ins.op == GpOp::Variable &&
+            (ins.variable >= data.columns.size() || data.columns[ins.variable].size() < data.rows)) {
+            throw std::invalid_argument("GP program reads a variable missing from the dataset");
+        }
+    }
+}
+
+// One opcode over a contiguous run of rows; out may alias the inputs
+void binaryKernel(GpOp op, const double* a, const double* b, double* out, size_t count) {
+    switch (op) {
+    case GpOp::Add:
+        for (size_t i = 0; i < count; ++i) out[i] = a[i] + b[i];
+        break;
+    case GpOp::Sub:
+        for (size_t i = 0; i < count; ++i) out[i] = a[i] - b[i];
+        break;
+    case GpOp::Mul:
+        for (size_t i = 0; i < count; ++i) out[i] = a[i] * b[i];
+        break;
+    default:
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = std::fabs(b[i]) > kProtectEpsilon ? a[i] / b[i] : 1.0;
+        }
+        break;
+    }
+}
+
+void unaryKernel(GpOp op, const double* a, double* out, size_t count) {
+    switch (op) {
+    case GpOp::Neg:
+        for (size_t i = 0; i < count; ++i) out[i] = -a[i];
+        break;
+    case GpOp::Sin:
+        for (size_t i = 0; i < count; ++i) out[i] = std::sin(a[i]);
+        break;
+    case GpOp::Cos:
+        for (size_t i = 0; i < count; ++i) out[i] = std::cos(a[i]);
+        break;
+    case GpOp::Exp:
+        for (size_t i = 0; i < count; ++i) out[i] = std::exp(a[i]);
+        break;
+    case GpOp::Log:
+        for (size_t i = 0; i < count; ++i) {
+            double x = std::fabs(a[i]);
+            out[i] = x > kProtectEpsilon ? std::log(x) : 0.0;
+        }
+        break;
+    default:
+        for (size_t i = 0; i < count; ++i) out[i] = std::sqrt(std::fabs(a[i]));
+        break;
+    }
+}
+
+uint64_t mix(uint64_t x) {
+    // splitmix64 finaliser
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+GpEvaluator::GpEvaluator(const OpcodeTable& opcodes, std::vector<std::string> variableNames)
+    : opcodes_(&opcodes), variableNames_(std::move(variableNames)) {}
+
+const GpEvaluator::Symbol& GpEvaluator::resolve_(Opcode opcode) {
+    if (opcode >= symbols_.size()) symbols_.resize(opcodes_->size());
+    Symbol& sym = symbols_[opcode];
+    if (sym.resolved) return sym;
+
+    struct Builtin { const char* name; GpOp op; uint32_t arity; };
+    static const Builtin builtins[] = {
+        {"+", GpOp::Add, 2}, {"-", GpOp::Sub, 2}, {"*", GpOp::Mul, 2}, {"/", GpOp::Div, 2},
+        {"neg", GpOp::Neg, 1}, {"sin", GpOp::Sin, 1}, {"cos", GpOp::Cos, 1},
+        {"exp", GpOp::Exp, 1}, {"log", GpOp::Log, 1}, {"sqrt", GpOp::Sqrt, 1},
+    };
+
+    const std::string& name = opcodes_->symbol(opcode);
+    for (const Builtin& b : builtins) {
+        if (name == b.name) {
+            sym.instruction.op = b.op;
+            sym.arity = b.arity;
+            sym.resolved = true;
+            return sym;
+        }
+    }
+
+    auto named = std::find(variableNames_.begin(), variableNames_.end(), name);
+    uint32_t index = 0;
+    double value = 0.0;
+    if (named != variableNames_.end()) {
+        sym.instruction.op = GpOp::Variable;
+        sym.instruction.variable = static_cast<uint32_t>(named - variableNames_.begin());
+    } else if (variableNames_.empty() && parseVariableIndex(name, index)) {
+        sym.instruction.op = GpOp::Variable;
+        sym.instruction.variable = index;
+    } else if (parseConstant(name, value)) {
+        sym.instruction.op = GpOp::Constant;
+        sym.instruction.value = value;
+    } else {
+        throw std::invalid_argument("Unknown GP symbol '" + name + "'");
+    }
+    sym.arity = 0;
+    sym.resolved = true;
+    return sym;
+}
+
+GpInstruction GpEvaluator::instructionFor_(const LinearNode& node) {
+    const Symbol& sym = resolve_(node.opcode);
+    GpInstruction ins = sym.instruction;
+    if (ins.op == GpOp::Sub && node.arity == 1) {
+        ins.op = GpOp::Neg;
+    } else if (sym.arity != node.arity) {
+        throw std::invalid_argument("GP symbol '" + opcodes_->symbol(node.opcode) +
+                                    "' has the wrong number of children");
+    }
+    return ins;
+}
+
+GpProgram GpEvaluator::compile(const LinearTree& tree) {
+    GpProgram program;
+    compileInto(tree, program);
+    return program;
+}
+
+void GpEvaluator::compileInto(const LinearTree& tree, GpProgram& program) {
+    if (tree.empty()) throw std::invalid_argument("Cannot compile an empty tree");
+
+    program.code.clear();
+    program.maxStack = 0;
+    size_t depth = 0;
+
+    // Postfix is the prefix order with every node moved after its children
+    auto emit = [&](auto& self, size_t index) -> void {
+        size_t child = index + 1;
+        for (uint32_t k = 0; k < tree[index].arity; ++k) {
+            self(self, child);
+            child = tree.subtreeEnd(child);
+        }
+
+        program.code.push_back(instructionFor_(tree[index]));
+
+        if (tree[index].arity == 0) {
+            program.maxStack = std::max(program.maxStack, ++depth);
+        } else {
+            depth -= tree[index].arity - 1;
+        }
+    };
+    emit(emit, 0);
+}
+
+void GpEvaluator::runBlock_(const GpProgram& program, const GpDataset& data, size_t begin, size_t count) {
+    double* base = stack_.data();
+    size_t sp = 0;
+    auto slot = [&](size_t i) { return base + i * kBlockRows; };
+
+    for (const GpInstruction& ins : program.code) {
+        switch (ins.op) {
+        case GpOp::Variable: {
+            const double* src = data.columns[ins.variable].data() + begin;
+            std::copy(src, src + count, slot(sp++));
+            break;
+        }
+        case GpOp::Constant:
+            std::fill(slot(sp), slot(sp) + count, ins.value);
+            ++sp;
+            break;
+        case GpOp::Add: case GpOp::Sub: case GpOp::Mul: case GpOp::Div:
+            binaryKernel(ins.op, slot(sp - 2), slot(sp - 1), slot(sp - 2), count);
+            --sp;
+            break;
+        default:
+            unaryKernel(ins.op, slot(sp - 1), slot(sp - 1), count);
+            break;
+        }
+    }
+}
+
+void GpEvaluator::evaluate(const GpProgram& program, const GpDataset& data, double* out) {
+    checkVariables(program, data);
+    stack_.resize(program.maxStack * kBlockRows);
+
+    for (size_t begin = 0; begin < data.rows; begin += kBlockRows) {
+        size_t count = std::min(kBlockRows, data.rows - begin);
+        runBlock_(program, data, begin, count);
+        std::copy(stack_.data(), stack_.data() + count, out + begin);
+    }
+}
+
+void GpEvaluator::evaluate(const GpProgram& program, const GpDataset& data, std::vector<double>& out) {
+    out.resize(data.rows);
+    evaluate(program, data, out.data());
+}
+
+double GpEvaluator::meanSquaredError(const GpProgram& program, const GpDataset& data,
+                                     const std::vector<double>& targets) {
+    if (targets.size() < data.rows) {
+        throw std::invalid_argument("Need one target per dataset row");
+    }
+    checkVariables(program, data);
+    if (data.rows == 0) return 0.0;
+    stack_.resize(program.maxStack * kBlockRows);
+
+    double sum = 0.0;
+    for (size_t begin = 0; begin < data.rows; begin += kBlockRows) {
+        size_t count = std::min(kBlockRows, data.rows - begin);
+        runBlock_(program, data, begin, count);
+        const double* y = stack_.data();
+        const double* t = targets.data() + begin;
+        for (size_t i = 0; i < count; ++i) {
+            double e = y[i] - t[i];
+            sum += e * e;
+        }
+    }
+    return sum / static_cast<double>(data.rows);
+}
+
+void GpEvaluator::evaluate(const LinearTree& tree, const GpDataset& data, GpSemanticCache& cache,
+                           std::vector<double>& out) {
+    if (tree.empty()) throw std::invalid_argument("Cannot evaluate an empty tree");
+
+    // Structural hashes, children before parents (children follow in prefix order)
+    hashes_.resize(tree.size());
+    for (size_t i = tree.size(); i-- > 0;) {
+        uint64_t h = mix((uint64_t(tree[i].opcode) << 8) ^ tree[i].arity);
+        size_t child = i + 1;
+        for (uint32_t k = 0; k < tree[i].arity; ++k) {
+            h = mix(h ^ hashes_[child]);
+            child = tree.subtreeEnd(child);
+        }
+        hashes_[i] = h;
+    }
+
+    const double* root = cachedNode_(tree, data, cache, 0);
+    out.assign(root, root + data.rows);
+    cache.trim();
+}
+
+const double* GpEvaluator::cachedNode_(const LinearTree& tree, const GpDataset& data,
+                                       GpSemanticCache& cache, size_t index) {
+    GpInstruction ins = instructionFor_(tree[index]);
+    if (ins.op == GpOp::Variable) {
+        if (ins.variable >= data.columns.size() || data.columns[ins.variable].size() < data.rows) {
+            throw std::invalid_argument("GP program reads a variable missing from the dataset");
+        }
+        return data.columns[ins.variable].data();
+    }
+
+    const uint64_t key = hashes_[index];
+    if (const double* hit = cache.find(key)) return hit;
+
+    if (ins.op == GpOp::Constant) {
+        double* out = cache.insert(key, data.rows);
+        std::fill(out, out + data.rows, ins.value);
+        return out;
+    }
+
+    const size_t first = index + 1;
+    const double* a = cachedNode_(tree, data, cache, first);
+    if (tree[index].arity == 2) {
+        const double* b = cachedNode_(tree, data, cache, tree.subtreeEnd(first));
+        double* out = cache.insert(key, data.rows);
+        binaryKernel(ins.op, a, b, out, data.rows);
+        return out;
+    }
+    double* out = cache.insert(key, data.rows);
+    unaryKernel(ins.op, a, out, data.rows);
+    return out;
+}
+
+} // namespace ga
@@ -0,0 +1,43 @@
+#include "ga/gp_semantic_cache.hpp"
+
+namespace ga {
+
+const double* GpSemanticCache::find(uint64_t key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->values.data();
+}
+
+double* GpSemanticCache::insert(uint64_t key, size_t rows) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->values.data();
+    }
+    lru_.push_front(Entry{key, std::vector<double>(rows)});
+    index_.emplace(key, lru_.begin());
+    bytes_ += rows * sizeof(double);
+    return lru_.front().values.data();
+}
+
+void GpSemanticCache::trim() {
+    while (bytes_ > maxBytes_ && !lru_.empty()) {
+        Entry& victim = lru_.back();
+        bytes_ -= victim.values.size() * sizeof(double);
+        index_.erase(victim.key);
+        lru_.pop_back();
+    }
+}
+
+void GpSemanticCache::clear() {
+    lru_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+} // namespace ga
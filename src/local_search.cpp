@@ -0,0 +1,195 @@
+#include "ga/local_search.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ga {
+
+namespace {
+
+// Steps below this fraction of a coordinate's range count as converged
+constexpr double kTolerance = 1e-12;
+
+double clampTo(double v, double lo, double hi) {
+    return std::min(hi, std::max(lo, v));
+}
+
+} // namespace
+
+double coordinateSearch(const Fitness& fitness, std::vector<double>& x, double fx,
+                        const std::vector<double>& lower, const std::vector<double>& upper,
+                        double step, size_t& budget) {
+    const size_t n = x.size();
+    // Per-coordinate step and the direction that last succeeded; a success
+    // doubles the step, a failure in both directions halves it
+    std::vector<double> steps(n);
+    std::vector<signed char> direction(n, 1);
+    for (size_t i = 0; i < n; ++i) steps[i] = step * (upper[i] - lower[i]);
+
+    bool moving = true;
+    while (moving && budget > 0) {
+        moving = false;
+        for (size_t i = 0; i < n && budget > 0; ++i) {
+            const double range = upper[i] - lower[i];
+            if (steps[i] <= kTolerance * range) continue;
+            moving = true;
+
+            const double origin = x[i];
+            bool improved = false;
+            for (int attempt = 0; attempt < 2 && budget > 0 && !improved; ++attempt) {
+                const int dir = attempt == 0 ? direction[i] : -direction[i];
+                const double v = clampTo(origin + dir * steps[i], lower[i], upper[i]);
+                if (v == origin) continue;
+                x[i] = v;
+                --budget;
+                const double f = fitness(x);
+                if (f > fx) {
+                    fx = f;
+                    direction[i] = static_cast<signed char>(dir);
+                    improved = true;
+                } else {
+                    x[i] = origin;
+                }
+            }
+            steps[i] = improved ? std::min(range, 2.0 * steps[i]) : 0.5 * steps[i];
+        }
+    }
+    return fx;
+}
+
+double nelderMead(const Fitness& fitness, std::vector<double>& x, double fx,
+                  const std::vector<double>& lower, const std::vector<double>& upper,
+                  double step, size_t& budget) {
+    const size_t n = x.size();
+    if (n == 0 || budget <= n) return fx;
+
+    // Coefficients adapted to the dimension (Gao & Han 2012); they reduce to
+    // the standard 1, 2, 1/2, 1/2 for n = 2
+    const double dn = static_cast<double>(n);
+    const double alpha = 1.0;
+    const double beta = 1.0 + 2.0 / dn;
+    const double gamma = 0.75 - 0.5 / dn;
+    const double delta = 1.0 - 1.0 / dn;
+
+    // Vertices are rows of `simplex`; values are fitnesses (maximised)
+    std::vector<double> simplex((n + 1) * n);
+    std::vector<double> value(n + 1);
+    std::vector<double> sum(n, 0.0);
+    std::vector<double> centroid(n), trial(n), second(n);
+    auto row = [&](size_t v) { return &simplex[v * n]; };
+    auto evaluate = [&](const std::vector<double>& p) {
+        --budget;
+        return fitness(p);
+    };
+
+    std::copy(x.begin(), x.end(), row(0));
+    value[0] = fx;
+    for (size_t v = 1; v <= n; ++v) {
+        const size_t i = v - 1;
+        trial = x;
+        const double s = step * (upper[i] - lower[i]);
+        // Step away from the nearer bound so the vertex stays distinct
+        trial[i] = x[i] + s <= upper[i] ? x[i] + s : clampTo(x[i] - s, lower[i], upper[i]);
+        std::copy(trial.begin(), trial.end(), row(v));
+        value[v] = evaluate(trial);
+    }
+    for (size_t v = 0; v <= n; ++v) {
+        for (size_t i = 0; i < n; ++i) sum[i] += row(v)[i];
+    }
+
+    auto replace = [&](size_t v, const std::vector<double>& p, double f) {
+        double* r = row(v);
+        for (size_t i = 0; i < n; ++i) {
+            sum[i] += p[i] - r[i];
+            r[i] = p[i];
+        }
+        value[v] = f;
+    };
+    // Point c + t * (w - c), projected into the bounds
+    auto along = [&](const double* w, double t, std::vector<double>& out) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = clampTo(centroid[i] + t * (w[i] - centroid[i]), lower[i], upper[i]);
+        }
+    };
+
+    while (budget > 0) {
+        size_t best = 0, worst = 0;
+        for (size_t v = 1; v <= n; ++v) {
+            if (value[v] > value[best]) best = v;
+            if (value[v] < value[worst]) worst = v;
+        }
+        size_t nextWorst = best;
+        for (size_t v = 0; v <= n; ++v) {
+            if (v != worst && value[v] < value[nextWorst]) nextWorst = v;
+        }
+
+        // Converged once every vertex sits within tolerance of the best
+        double extent = 0.0;
+        for (size_t v = 0; v <= n && extent <= kTolerance; ++v) {
+            for (size_t i = 0; i < n; ++i) {
+                const double range = upper[i] - lower[i];
+                if (range > 0.0) extent = std::max(extent, std::fabs(row(v)[i] - row(best)[i]) / range);
+            }
+        }
+        if (extent <= kTolerance) break;
+
+        const double* w = row(worst);
+        for (size_t i = 0; i < n; ++i) centroid[i] = (sum[i] - w[i]) / dn;
+
+        along(w, -alpha, trial);
+        const double fr = evaluate(trial);
+        if (fr > value[best]) {
+            if (budget == 0) { replace(worst, trial, fr); break; }
+            along(w, -alpha * beta, second);
+            const double fe = evaluate(second);
+            if (fe > fr) replace(worst, second, fe);
+            else replace(worst, trial, fr);
+            continue;
+        }
+        if (fr > value[nextWorst]) {
+            replace(worst, trial, fr);
+            continue;
+        }
+        if (budget == 0) break;
+
+        // Contract outside (towards the reflection) or inside (towards the worst)
+        const bool outside = fr > value[worst];
+        along(w, outside ? -alpha * gamma : gamma, second);
+        const double fc = evaluate(second);
+        if (outside ? fc >= fr : fc > value[worst]) {
+            replace(worst, second, fc);
+            continue;
+        }
+
+        // Shrink towards the best vertex; stop instead if the budget cannot
+        // re-evaluate the whole simplex
+        if (budget < n) break;
+        const std::vector<double> anchor(row(best), row(best) + n);
+        for (size_t v = 0; v <= n; ++v) {
+            if (v == best) continue;
+            const double* r = row(v);
+            for (size_t i = 0; i < n; ++i) trial[i] = anchor[i] + delta * (r[i] - anchor[i]);
+            replace(v, trial, evaluate(trial));
+        }
+    }
+
+    size_t best = 0;
+    for (size_t v = 1; v <= n; ++v) {
+        if (value[v] > value[best]) best = v;
+    }
+    if (value[best] > fx) {
+        std::copy(row(best), row(best) + n, x.begin());
+        fx = value[best];
+    }
+    return fx;
+}
+
+double refine(const LocalSearchOptions& options, const Fitness& fitness, std::vector<double>& x, double fx,
+              const std::vector<double>& lower, const std::vector<double>& upper, size_t& budget) {
+    if (options.method == LocalSearchOptions::Method::NelderMead && budget > x.size()) {
+        return nelderMead(fitness, x, fx, lower, upper, options.step, budget);
+    }
+    return coordinateSearch(fitness, x, fx, lower, upper, options.step, budget);
+}
+
+} // namespace ga
@@ -0,0 +1,221 @@
+#include "ga/niching.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "ga/parallel.hpp"
+
+namespace ga {
+
+namespace {
+
+// Cells per axis are packed 21 bits apiece into one key; points further out
+// share the last cell, which only adds candidates
+constexpr uint64_t kCellBits = 21;
+constexpr uint64_t kMaxCell = (uint64_t{1} << kCellBits) - 1;
+
+} // namespace
+
+NichingStage::NichingStage(const NichingOptions& options) : options_(options) {
+    if (!(options.radius > 0.0)) throw std::invalid_argument("Niche radius must be positive");
+    if (!(options.alpha > 0.0)) throw std::invalid_argument("Sharing alpha must be positive");
+    if (options.capacity < 1) throw std::invalid_argument("Clearing capacity must be at least 1");
+}
+
+void NichingStage::project_(const double* genes, size_t count, size_t dimension) {
+    if (dimension != dimension_) {
+        dimension_ = dimension;
+        axes_ = std::min(dimension, kMaxAxes);
+        directions_.clear();
+        if (dimension > kMaxAxes) {
+            // Random unit vectors: |u . (a - b)| <= |a - b|
+            std::mt19937 rng(options_.seed);
+            std::normal_distribution<double> normal(0.0, 1.0);
+            directions_.resize(axes_ * dimension);
+            for (size_t a = 0; a < axes_; ++a) {
+                double* u = &directions_[a * dimension];
+                double norm = 0.0;
+                for (size_t d = 0; d < dimension; ++d) {
+                    u[d] = normal(rng);
+                    norm += u[d] * u[d];
+                }
+                norm = std::sqrt(norm);
+                for (size_t d = 0; d < dimension; ++d) u[d] /= norm;
+            }
+        }
+    }
+
+    projected_.resize(count * axes_);
+    for (size_t i = 0; i < count; ++i) {
+        const double* x = genes + i * dimension;
+        for (size_t a = 0; a < axes_; ++a) {
+            if (directions_.empty()) {
+                projected_[i * axes_ + a] = x[a];
+                continue;
+            }
+            const double* u = &directions_[a * dimension];
+            double p = 0.0;
+            for (size_t d = 0; d < dimension; ++d) p += u[d] * x[d];
+            projected_[i * axes_ + a] = p;
+        }
+    }
+
+    double lo[kMaxAxes];
+    for (size_t a = 0; a < axes_; ++a) {
+        lo[a] = projected_[a];
+        for (size_t i = 1; i < count; ++i) lo[a] = std::min(lo[a], projected_[i * axes_ + a]);
+    }
+    cells_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = 0;
+        for (size_t a = 0; a < axes_; ++a) {
+            const double c = std::floor((projected_[i * axes_ + a] - lo[a]) / options_.radius);
+            const uint64_t cell = c < static_cast<double>(kMaxCell) ? static_cast<uint64_t>(c) : kMaxCell;
+            key |= cell << (a * kCellBits);
+        }
+        cells_[i] = key;
+    }
+
+    order_.resize(count);
+    std::iota(order_.begin(), order_.end(), size_t{0});
+    std::sort(order_.begin(), order_.end(), [&](size_t a, size_t b) {
+        return cells_[a] != cells_[b] ? cells_[a] < cells_[b] : a < b;
+    });
+    sortedCells_.resize(count);
+    for (size_t k = 0; k < count; ++k) sortedCells_[k] = cells_[order_[k]];
+}
+
+template <class Visit>
+size_t NichingStage::visitNeighbours_(const double* genes, size_t i, Visit&& visit) const {
+    const double* x = genes + i * dimension_;
+    const double r2 = options_.radius * options_.radius;
+    size_t checks = 0;
+
+    // Walk the 3^axes cells around i's cell
+    uint64_t home[kMaxAxes];
+    for (size_t a = 0; a < axes_; ++a) home[a] = (cells_[i] >> (a * kCellBits)) & kMaxCell;
+    size_t combinations = 1;
+    for (size_t a = 0; a < axes_; ++a) combinations *= 3;
+    for (size_t c = 0; c < combinations; ++c) {
+        uint64_t key = 0;
+        bool inside = true;
+        size_t rest = c;
+        for (size_t a = 0; a < axes_; ++a, rest /= 3) {
+            const int offset = static_cast<int>(rest % 3) - 1;
+            if ((offset < 0 && home[a] == 0) || (offset > 0 && home[a] == kMaxCell)) {
+                inside = false;
+                break;
+            }
+            key |= (home[a] + offset) << (a * kCellBits);
+        }
+        if (!inside) continue;
+
+        auto range = std::equal_range(sortedCells_.begin(), sortedCells_.end(), key);
+        for (auto it = range.first; it != range.second; ++it) {
+            const size_t j = order_[it - sortedCells_.begin()];
+            if (j == i) continue;
+            const double* y = genes + j * dimension_;
+            double d2 = 0.0;
+            for (size_t d = 0; d < dimension_; ++d) {
+                const double diff = x[d] - y[d];
+                d2 += diff * diff;
+            }
+            ++checks;
+            if (d2 < r2) visit(j, std::sqrt(d2));
+        }
+    }
+    return checks;
+}
+
+void NichingStage::apply(const double* genes, size_t count, size_t dimension, const double* fitness, double* out) {
+    checks_ = 0;
+    if (options_.method == NichingOptions::Method::None || count == 0 || dimension == 0) {
+        std::copy(fitness, fitness + count, out);
+        return;
+    }
+    project_(genes, count, dimension);
+    const int threads = resolveThreads(options_.threads);
+    if (options_.method == NichingOptions::Method::Sharing) share_(genes, count, fitness, out, threads);
+    else clear_(genes, count, fitness, out, threads);
+}
+
+void NichingStage::share_(const double* genes, size_t count, const double* fitness, double* out, int threads) {
+    const double base = std::min(0.0, *std::min_element(fitness, fitness + count));
+    std::vector<size_t> checks(static_cast<size_t>(std::max(1, threads)), 0);
+    parallelFor(count, threads, [&](size_t begin, size_t end, size_t worker) {
+        for (size_t i = begin; i < end; ++i) {
+            double niche = 1.0; // sh(0) for the individual itself
+            checks[worker] += visitNeighbours_(genes, i, [&](size_t, double d) {
+                niche += 1.0 - std::pow(d / options_.radius, options_.alpha);
+            });
+            out[i] = base + (fitness[i] - base) / niche;
+        }
+    });
+    for (size_t c : checks) checks_ += c;
+}
+
+void NichingStage::clear_(const double* genes, size_t count, const double* fitness, double* out, int threads) {
+    // Neighbour lists for contiguous chunks of individuals, one per worker,
+    // then concatenated in worker order
+    const size_t workers = std::min(count, static_cast<size_t>(std::max(1, threads)));
+    workerNeighbours_.resize(workers);
+    offsets_.resize(count + 1);
+    std::vector<size_t> checks(workers, 0);
+    parallelFor(count, threads, [&](size_t begin, size_t end, size_t worker) {
+        std::vector<size_t>& list = workerNeighbours_[worker];
+        list.clear();
+        for (size_t i = begin; i < end; ++i) {
+            checks[worker] += visitNeighbours_(genes, i, [&](size_t j, double) { list.push_back(j); });
+            offsets_[i + 1] = list.size();
+        }
+    });
+    size_t total = 0;
+    for (size_t w = 0; w < workers; ++w) {
+        const size_t begin = count * w / workers;
+        const size_t end = count * (w + 1) / workers;
+        for (size_t i = begin; i < end; ++i) offsets_[i + 1] += total;
+        total += workerNeighbours_[w].size();
+        checks_ += checks[w];
+    }
+    offsets_[0] = 0;
+    neighbours_.resize(total);
+    for (size_t w = 0, at = 0; w < workers; ++w) {
+        std::copy(workerNeighbours_[w].begin(), workerNeighbours_[w].end(), neighbours_.begin() + at);
+        at += workerNeighbours_[w].size();
+    }
+
+    // Best first; each individual still standing wins its niche and admits
+    // up to capacity - 1 worse neighbours, clearing the others
+    order_.resize(count);
+    std::iota(order_.begin(), order_.end(), size_t{0});
+    std::sort(order_.begin(), order_.end(), [&](size_t a, size_t b) {
+        return fitness[a] != fitness[b] ? fitness[a] > fitness[b] : a < b;
+    });
+    rank_.resize(count);
+    for (size_t k = 0; k < count; ++k) rank_[order_[k]] = k;
+    cleared_.assign(count, 0);
+    const double floor = fitness[order_.back()];
+    const size_t capacity = static_cast<size_t>(options_.capacity);
+
+    for (size_t k = 0; k < count; ++k) {
+        const size_t i = order_[k];
+        out[i] = cleared_[i] ? floor : fitness[i];
+        if (cleared_[i]) continue;
+        size_t winners = 1;
+        // Neighbours in rank order, so the better ones are admitted first
+        auto first = neighbours_.begin() + offsets_[i];
+        auto last = neighbours_.begin() + offsets_[i + 1];
+        std::sort(first, last, [&](size_t a, size_t b) { return rank_[a] < rank_[b]; });
+        for (auto it = first; it != last; ++it) {
+            const size_t j = *it;
+            if (rank_[j] < k || cleared_[j]) continue;
+            if (winners < capacity) ++winners;
+            else cleared_[j] = 1;
+        }
+    }
+}
+
+} // namespace ga
@@ -0,0 +1,220 @@
+#include "ga/novelty_search.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "ga/genetic_algorithm.hpp"
+#include "ga/parallel.hpp"
+#include "variation.hpp"
+
+#include "mutation/base_mutation.h"
+#include "crossover/base_crossover.h"
+#include "selection-operator/tournament_selection.h"
+
+namespace ga {
+
+static std::mt19937 make_rng(unsigned seed) {
+    if (seed == 0) {
+        std::random_device rd;
+        return std::mt19937{rd()};
+    }
+    return std::mt19937{seed};
+}
+
+NoveltySearch::NoveltySearch(const Config& cfg, const NoveltyOptions& options)
+    : cfg_(cfg), options_(options), rng_(make_rng(cfg.seed)) {
+    if (options.neighbours == 0) throw std::invalid_argument("Novelty needs at least one neighbour");
+    if (options.tournamentSize < 1) throw std::invalid_argument("Tournament size must be at least 1");
+    mutation_ = makeGaussianMutation(cfg.seed);
+    crossover_ = makeOnePointCrossover(cfg.seed);
+}
+
+NoveltySearch::~NoveltySearch() = default;
+
+void NoveltySearch::setMutationOperator(std::unique_ptr<MutationOperator> op) {
+    mutation_ = std::move(op);
+}
+
+void NoveltySearch::setCrossoverOperator(std::unique_ptr<CrossoverOperator> op) {
+    crossover_ = std::move(op);
+}
+
+void NoveltySearch::score_() {
+    const size_t n = novelty_.size();
+    const size_t k = options_.neighbours;
+    const double* rows = behaviours_.data();
+    ids_.resize(n);
+    std::iota(ids_.begin(), ids_.end(), size_t{0});
+    population_.build(rows, behaviourDimension_, ids_.data(), n);
+
+    const int threads = resolveThreads(cfg_.threads);
+    heaps_.resize(static_cast<size_t>(threads));
+    parallelFor(n, threads, [&](size_t begin, size_t end, size_t worker) {
+        std::vector<Neighbour>& heap = heaps_[worker];
+        for (size_t i = begin; i < end; ++i) {
+            const double* query = rows + i * behaviourDimension_;
+            heap.clear();
+            population_.search(rows, query, k, heap, i);
+            archive_.search(query, k, heap);
+            double sum = 0.0;
+            for (const Neighbour& nb : heap) sum += nb.distance;
+            novelty_[i] = heap.empty() ? 0.0 : sum / heap.size();
+        }
+    });
+}
+
+void NoveltySearch::admit_() {
+    const size_t n = novelty_.size();
+    const size_t count = std::min(n, options_.addPerGeneration);
+    if (count == 0) return;
+    std::iota(ids_.begin(), ids_.end(), size_t{0});
+    std::partial_sort(ids_.begin(), ids_.begin() + count, ids_.end(),
+                      [&](size_t a, size_t b) { return novelty_[a] > novelty_[b]; });
+
+    for (size_t t = 0; t < count; ++t) {
+        const double* row = &behaviours_[ids_[t] * behaviourDimension_];
+        if (options_.capacity == 0 || archiveIds_.size() < options_.capacity) {
+            archiveIds_.push_back(archive_.insert(row));
+            continue;
+        }
+        // Full: archiveIds_ is a ring whose oldest member sits at archiveNext_
+        size_t slot = archiveNext_;
+        if (options_.eviction == NoveltyOptions::Eviction::Random) {
+            std::uniform_int_distribution<size_t> pick(0, archiveIds_.size() - 1);
+            slot = pick(rng_);
+        } else {
+            archiveNext_ = (archiveNext_ + 1) % archiveIds_.size();
+        }
+        archive_.erase(archiveIds_[slot]);
+        archiveIds_[slot] = archive_.insert(row);
+    }
+}
+
+Result NoveltySearch::run(const Fitness& objective, const BehaviourDescriptor& behaviour) {
+    if (!crossover_ || !mutation_) throw std::runtime_error("Operators not set");
+    if (!objective || !behaviour) throw std::invalid_argument("Novelty search needs an objective and a behaviour descriptor");
+
+    const size_t n = static_cast<size_t>(std::max(0, cfg_.populationSize));
+    const size_t dim = static_cast<size_t>(std::max(0, cfg_.dimension));
+    if (n == 0) throw std::invalid_argument("Population size must be positive");
+    resolveBounds(cfg_, lower_, upper_);
+    detail::shareBounds(*crossover_, lower_, upper_);
+    const int threads = resolveThreads(cfg_.threads);
+
+    std::vector<std::vector<double>> pop(n, std::vector<double>(dim)), next(n, std::vector<double>(dim));
+    std::vector<double> fitness(n), nextFitness(n);
+    std::vector<std::vector<double>> described(n);
+    std::vector<double> nextBehaviours;
+
+    // Scores rows [first, n) of P: objective and behaviour, the latter packed
+    // into `rows` once every length has been checked
+    auto evaluate = [&](std::vector<std::vector<double>>& P, std::vector<double>& F, std::vector<double>& rows,
+                        size_t first) {
+        parallelFor(n - first, threads, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = first + begin; i < first + end; ++i) {
+                F[i] = objective(P[i]);
+                described[i] = behaviour(P[i]);
+            }
+        });
+        if (behaviourDimension_ == 0) {
+            behaviourDimension_ = described[first].size();
+            if (behaviourDimension_ == 0) throw std::invalid_argument("Behaviour descriptor returned an empty vector");
+        }
+        rows.resize(n * behaviourDimension_);
+        for (size_t i = first; i < n; ++i) {
+            if (described[i].size() != behaviourDimension_) {
+                throw std::invalid_argument("Behaviour descriptor returned vectors of different lengths");
+            }
+            std::copy(described[i].begin(), described[i].end(), rows.begin() + i * behaviourDimension_);
+        }
+    };
+
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (auto& genes : pop) {
+        for (size_t j = 0; j < dim; ++j) genes[j] = lower_[j] + unit(rng_) * (upper_[j] - lower_[j]);
+    }
+    behaviourDimension_ = 0;
+    evaluate(pop, fitness, behaviours_, 0);
+    novelty_.assign(n, 0.0);
+    archive_.reset(behaviourDimension_);
+    archiveIds_.clear();
+    archiveNext_ = 0;
+
+    Result res;
+    res.evaluations = n;
+    res.bestHistory.reserve(cfg_.generations + 1);
+    res.avgHistory.reserve(cfg_.generations + 1);
+    auto record = [&]() {
+        const size_t best = std::max_element(fitness.begin(), fitness.end()) - fitness.begin();
+        if (fitness[best] > res.bestFitness) {
+            res.bestFitness = fitness[best];
+            res.bestGenes = pop[best];
+        }
+        res.bestHistory.push_back(fitness[best]);
+        res.avgHistory.push_back(std::accumulate(fitness.begin(), fitness.end(), 0.0) / n);
+    };
+    record();
+
+    const size_t elites = std::min(n, (size_t)std::max(0, (int)std::round(cfg_.eliteRatio * n)));
+    TournamentSelection selector(static_cast<size_t>(options_.tournamentSize), rng_());
+    std::vector<size_t> parents(2 * ((n - elites + 1) / 2));
+    std::vector<double> spare(dim);
+    std::uniform_real_distribution<double> prob(0.0, 1.0);
+    const detail::GeneMutation mutation = detail::resolveMutation(*mutation_, cfg_.mutationRate, cfg_.boundHandling);
+    // One pass per child: mutate and repair, reading an uncrossed parent directly
+    auto breed = [&](const std::vector<double>& source, const std::vector<double>& parent, std::vector<double>& child) {
+        const uint32_t key1 = static_cast<uint32_t>(rng_());
+        const uint32_t key2 = static_cast<uint32_t>(rng_());
+        detail::breedReal(mutation, source.data(), parent.data(), child.data(), dim, lower_.data(), upper_.data(),
+                          key1, key2);
+    };
+
+    for (int gen = 0; gen < cfg_.generations; ++gen) {
+        if (cfg_.maxEvaluations > 0 && res.evaluations >= cfg_.maxEvaluations) break;
+
+        score_();
+        admit_();
+
+        // The most novel survive unchanged, behaviours included
+        nextBehaviours.resize(behaviours_.size());
+        std::iota(ids_.begin(), ids_.end(), size_t{0});
+        std::partial_sort(ids_.begin(), ids_.begin() + elites, ids_.end(),
+                          [&](size_t a, size_t b) { return novelty_[a] > novelty_[b]; });
+        for (size_t e = 0; e < elites; ++e) {
+            const size_t i = ids_[e];
+            next[e] = pop[i];
+            nextFitness[e] = fitness[i];
+            std::copy(behaviours_.begin() + i * behaviourDimension_, behaviours_.begin() + (i + 1) * behaviourDimension_,
+                      nextBehaviours.begin() + e * behaviourDimension_);
+        }
+
+        if (!parents.empty()) {
+            selector.selectBatch(novelty_.data(), n, parents.data(), parents.size());
+        }
+        for (size_t i = elites, p = 0; i < n; i += 2, p += 2) {
+            const std::vector<double>& p1 = pop[parents[p]];
+            const std::vector<double>& p2 = pop[parents[p + 1]];
+            std::vector<double>& c1 = next[i];
+            std::vector<double>& c2 = i + 1 < n ? next[i + 1] : spare;
+            const bool crossed = prob(rng_) < cfg_.crossoverRate;
+            if (crossed) crossover_->crossoverInto(p1, p2, c1, c2);
+            breed(crossed ? c1 : p1, p1, c1);
+            if (&c2 != &spare) breed(crossed ? c2 : p2, p2, c2);
+        }
+        evaluate(next, nextFitness, nextBehaviours, elites);
+        res.evaluations += n - elites;
+
+        pop.swap(next);
+        fitness.swap(nextFitness);
+        behaviours_.swap(nextBehaviours);
+        record();
+    }
+
+    // Leave novelty() describing the final population
+    score_();
+    return res;
+}
+
+} // namespace ga
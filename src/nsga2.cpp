@@ -0,0 +1,375 @@
+#include "ga/nsga2.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+
+#include "ga/parallel.hpp"
+#include "variation.hpp"
+#include "mutation/gaussian_mutation.h"
+#include "crossover/simulated_binary_crossover.h"
+
+namespace ga {
+
+namespace {
+
+// True when a dominates b: no worse in every objective, better in one
+bool dominates(const double* a, const double* b, size_t m) {
+    bool strict = false;
+    for (size_t k = 0; k < m; ++k) {
+        if (a[k] < b[k]) return false;
+        if (a[k] > b[k]) strict = true;
+    }
+    return strict;
+}
+
+int sortTwoObjectives(const double* obj, size_t n, std::vector<int>& rank) {
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (obj[2 * a] != obj[2 * b]) return obj[2 * a] > obj[2 * b];
+        return obj[2 * a + 1] > obj[2 * b + 1];
+    });
+
+    // Visiting points by decreasing f1, each front's last member has its
+    // largest f2 so far, and only that member needs checking. Domination by
+    // front k is monotone in k, so the rank is found by binary search.
+    std::vector<size_t> last;
+    for (size_t p : order) {
+        const double f1 = obj[2 * p], f2 = obj[2 * p + 1];
+        size_t lo = 0, hi = last.size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            const double* q = obj + 2 * last[mid];
+            bool dominated = q[1] > f2 || (q[1] == f2 && q[0] > f1);
+            if (dominated) lo = mid + 1; else hi = mid;
+        }
+        if (lo == last.size()) last.push_back(p); else last[lo] = p;
+        rank[p] = static_cast<int>(lo);
+    }
+    return static_cast<int>(last.size());
+}
+
+int sortThreeObjectives(const double* obj, size_t n, std::vector<int>& rank) {
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return std::lexicographical_compare(obj + 3 * b, obj + 3 * b + 3, obj + 3 * a, obj + 3 * a + 3);
+    });
+
+    // Sweep by decreasing f1. Every point already placed has f1 at least as
+    // large, so (duplicates aside) it dominates p exactly when it is weakly
+    // better in (f2, f3). Each front keeps the staircase of its maximal
+    // (f2, f3) pairs keyed by f2, which answers that query in O(log n).
+    std::vector<std::map<double, double>> stairs;
+    for (size_t i = 0; i < n; ++i) {
+        const size_t p = order[i];
+        const double f2 = obj[3 * p + 1], f3 = obj[3 * p + 2];
+        if (i > 0 && std::equal(obj + 3 * p, obj + 3 * p + 3, obj + 3 * order[i - 1])) {
+            rank[p] = rank[order[i - 1]];
+            continue;
+        }
+        size_t lo = 0, hi = stairs.size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            auto it = stairs[mid].lower_bound(f2);
+            bool dominated = it != stairs[mid].end() && it->second >= f3;
+            if (dominated) lo = mid + 1; else hi = mid;
+        }
+        if (lo == stairs.size()) stairs.emplace_back();
+        auto& stair = stairs[lo];
+        auto it = stair.upper_bound(f2);
+        while (it != stair.begin() && std::prev(it)->second <= f3) {
+            it = stair.erase(std::prev(it));
+        }
+        stair.emplace_hint(it, f2, f3);
+        rank[p] = static_cast<int>(lo);
+    }
+    return static_cast<int>(stairs.size());
+}
+
+// Best Order Sort (Roy, Islam & Deb 2016)
+int bestOrderSort(const double* obj, size_t n, size_t m, std::vector<int>& rank) {
+    // One lexicographic ordering per objective, led by that objective, so a
+    // dominating point always precedes the points it dominates
+    std::vector<std::vector<size_t>> sorted(m, std::vector<size_t>(n));
+    for (size_t j = 0; j < m; ++j) {
+        std::iota(sorted[j].begin(), sorted[j].end(), 0);
+        std::sort(sorted[j].begin(), sorted[j].end(), [&](size_t a, size_t b) {
+            const double* x = obj + a * m;
+            const double* y = obj + b * m;
+            if (x[j] != y[j]) return x[j] > y[j];
+            for (size_t k = 0; k < m; ++k) {
+                if (x[k] != y[k]) return x[k] > y[k];
+            }
+            return a < b;
+        });
+    }
+
+    // seen[j][k]: points of front k met so far in ordering j
+    std::vector<std::vector<std::vector<size_t>>> seen(m);
+    int fronts = 0;
+    size_t ranked = 0;
+    for (size_t i = 0; i < n && ranked < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            const size_t s = sorted[j][i];
+            if (rank[s] >= 0) {
+                seen[j][rank[s]].push_back(s);
+                continue;
+            }
+            // Every dominator of s precedes it in ordering j, so the first
+            // front without one among the points seen is its front
+            int r = 0;
+            for (; r < fronts; ++r) {
+                bool dominated = false;
+                for (size_t t : seen[j][r]) {
+                    if (dominates(obj + t * m, obj + s * m, m)) { dominated = true; break; }
+                }
+                if (!dominated) break;
+            }
+            if (r == fronts) {
+                ++fronts;
+                for (auto& lists : seen) lists.resize(fronts);
+            }
+            rank[s] = r;
+            seen[j][r].push_back(s);
+            ++ranked;
+        }
+    }
+    return fronts;
+}
+
+} // namespace
+
+int nonDominatedSort(const double* objectives, size_t n, size_t m, std::vector<int>& rank) {
+    rank.assign(n, -1);
+    if (n == 0) return 0;
+    if (m == 0) throw std::invalid_argument("Need at least one objective");
+    if (m == 2) return sortTwoObjectives(objectives, n, rank);
+    if (m == 3) return sortThreeObjectives(objectives, n, rank);
+    return bestOrderSort(objectives, n, m, rank);
+}
+
+int nonDominatedSort(std::vector<MultiObjectiveIndividual>& pop) {
+    if (pop.empty()) return 0;
+    const size_t m = pop.front().objectives.size();
+    std::vector<double> flat(pop.size() * m);
+    for (size_t i = 0; i < pop.size(); ++i) {
+        if (pop[i].objectives.size() != m) throw std::invalid_argument("All individuals need the same number of objectives");
+        std::copy(pop[i].objectives.begin(), pop[i].objectives.end(), flat.begin() + i * m);
+    }
+    std::vector<int> rank;
+    int fronts = nonDominatedSort(flat.data(), pop.size(), m, rank);
+    for (size_t i = 0; i < pop.size(); ++i) pop[i].rank = rank[i];
+    return fronts;
+}
+
+void crowdingDistance(const double* objectives, size_t m, const std::vector<size_t>& front,
+                      std::vector<double>& distance) {
+    const size_t f = front.size();
+    distance.assign(f, 0.0);
+    if (f <= 2) {
+        std::fill(distance.begin(), distance.end(), std::numeric_limits<double>::infinity());
+        return;
+    }
+    std::vector<size_t> pos(f);
+    for (size_t k = 0; k < m; ++k) {
+        auto value = [&](size_t p) { return objectives[front[p] * m + k]; };
+        std::iota(pos.begin(), pos.end(), 0);
+        std::sort(pos.begin(), pos.end(), [&](size_t a, size_t b) { return value(a) < value(b); });
+        const double range = value(pos[f - 1]) - value(pos[0]);
+        distance[pos[0]] = distance[pos[f - 1]] = std::numeric_limits<double>::infinity();
+        if (range <= 0.0) continue;
+        for (size_t i = 1; i + 1 < f; ++i) {
+            distance[pos[i]] += (value(pos[i + 1]) - value(pos[i - 1])) / range;
+        }
+    }
+}
+
+static std::mt19937 make_rng(unsigned seed) {
+    if (seed == 0) {
+        std::random_device rd;
+        return std::mt19937{rd()};
+    }
+    return std::mt19937{seed};
+}
+
+NSGA2::NSGA2(const Config& cfg)
+    : cfg_(cfg), rng_(make_rng(cfg.seed)) {
+    // Defaults suited to real-valued multi-objective problems
+    if (cfg.seed == 0) {
+        mutation_ = std::make_unique<GaussianMutation>();
+        crossover_ = std::make_unique<SimulatedBinaryCrossover>();
+    } else {
+        mutation_ = std::make_unique<GaussianMutation>(cfg.seed);
+        crossover_ = std::make_unique<SimulatedBinaryCrossover>(2.0, cfg.seed);
+    }
+}
+
+NSGA2::~NSGA2() = default;
+
+void NSGA2::setMutationOperator(std::unique_ptr<MutationOperator> op) {
+    mutation_ = std::move(op);
+}
+
+void NSGA2::setCrossoverOperator(std::unique_ptr<CrossoverOperator> op) {
+    crossover_ = std::move(op);
+}
+
+void NSGA2::evaluate_(size_t first, size_t count, const MultiFitness& fitness, size_t& evaluations) {
+    parallelFor(count, resolveThreads(cfg_.threads), [&](size_t begin, size_t end, size_t) {
+        for (size_t i = first + begin; i < first + end; ++i) pool_[i].objectives = fitness(pool_[i].genes);
+    });
+    evaluations += count;
+
+    // Lengths are checked and rows packed once every worker has finished
+    for (size_t i = first; i < first + count; ++i) {
+        const std::vector<double>& objectives = pool_[i].objectives;
+        if (objectiveCount_ == 0) {
+            if (objectives.empty()) throw std::invalid_argument("Fitness must return at least one objective");
+            objectiveCount_ = objectives.size();
+            objectives_.resize(pool_.size() * objectiveCount_);
+        } else if (objectives.size() != objectiveCount_) {
+            throw std::invalid_argument("Fitness returned a different number of objectives");
+        }
+        std::copy(objectives.begin(), objectives.end(), objectives_.begin() + i * objectiveCount_);
+    }
+}
+
+void NSGA2::rankAndCrowd_(size_t count) {
+    const size_t m = objectiveCount_;
+    int fronts = nonDominatedSort(objectives_.data(), count, m, rank_);
+
+    // Group pool indices by front (counting sort on rank)
+    std::vector<size_t> start(fronts + 1, 0);
+    for (size_t i = 0; i < count; ++i) ++start[rank_[i] + 1];
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    order_.resize(count);
+    {
+        std::vector<size_t> fill(start.begin(), start.end() - 1);
+        for (size_t i = 0; i < count; ++i) order_[fill[rank_[i]]++] = i;
+    }
+
+    crowding_.resize(count);
+    for (int f = 0; f < fronts; ++f) {
+        front_.assign(order_.begin() + start[f], order_.begin() + start[f + 1]);
+        crowdingDistance(objectives_.data(), m, front_, frontDistance_);
+        for (size_t i = 0; i < front_.size(); ++i) crowding_[front_[i]] = frontDistance_[i];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        pool_[i].rank = rank_[i];
+        pool_[i].crowdingDistance = crowding_[i];
+    }
+}
+
+void NSGA2::survive_(size_t n) {
+    // order_ lists the pool by front; whole fronts are kept while they fit and
+    // the front straddling n is cut by decreasing crowding distance
+    size_t begin = 0;
+    while (begin < n) {
+        size_t end = begin;
+        while (end < order_.size() && rank_[order_[end]] == rank_[order_[begin]]) ++end;
+        if (end > n) {
+            std::nth_element(order_.begin() + begin, order_.begin() + n, order_.begin() + end,
+                             [&](size_t a, size_t b) { return crowding_[a] > crowding_[b]; });
+        }
+        begin = end;
+    }
+
+    // Move the survivors into [0, n) by swapping, so no genome is copied
+    selected_.assign(order_.size(), 0);
+    for (size_t i = 0; i < n; ++i) selected_[order_[i]] = 1;
+    const size_t m = objectiveCount_;
+    size_t mover = n;
+    for (size_t hole = 0; hole < n; ++hole) {
+        if (selected_[hole]) continue;
+        while (!selected_[mover]) ++mover;
+        std::swap(pool_[hole], pool_[mover]);
+        std::swap_ranges(objectives_.begin() + hole * m, objectives_.begin() + (hole + 1) * m,
+                         objectives_.begin() + mover * m);
+        std::swap(rank_[hole], rank_[mover]);
+        std::swap(crowding_[hole], crowding_[mover]);
+        ++mover;
+    }
+}
+
+size_t NSGA2::tournament_(size_t n) {
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    size_t a = pick(rng_), b = pick(rng_);
+    if (rank_[a] != rank_[b]) return rank_[a] < rank_[b] ? a : b;
+    if (crowding_[a] != crowding_[b]) return crowding_[a] > crowding_[b] ? a : b;
+    return (rng_() & 1u) ? a : b;
+}
+
+ParetoResult NSGA2::run(const MultiFitness& fitness) {
+    if (!crossover_ || !mutation_) throw std::runtime_error("Operators not set");
+    if (cfg_.populationSize < 2) throw std::invalid_argument("NSGA-II needs a population of at least 2");
+
+    const size_t n = static_cast<size_t>(cfg_.populationSize);
+    resolveBounds(cfg_, lower_, upper_);
+    detail::shareBounds(*crossover_, lower_, upper_);
+    objectiveCount_ = 0;
+
+    pool_.assign(2 * n, MultiObjectiveIndividual{});
+    for (auto& ind : pool_) ind.genes.resize(cfg_.dimension);
+    spare_.genes.resize(cfg_.dimension);
+
+    ParetoResult res;
+    res.frontSizeHistory.reserve(cfg_.generations + 1);
+
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<double>& genes = pool_[i].genes;
+        for (size_t j = 0; j < genes.size(); ++j) genes[j] = lower_[j] + unit(rng_) * (upper_[j] - lower_[j]);
+    }
+    evaluate_(0, n, fitness, res.evaluations);
+    rankAndCrowd_(n);
+
+    auto front_size = [&]() {
+        return static_cast<size_t>(std::count(rank_.begin(), rank_.begin() + n, 0));
+    };
+    res.frontSizeHistory.push_back(front_size());
+
+    std::uniform_real_distribution<double> prob(0.0, 1.0);
+    const detail::GeneMutation mutation = detail::resolveMutation(*mutation_, cfg_.mutationRate, cfg_.boundHandling);
+    // One pass per child: mutate and repair, reading an uncrossed parent directly
+    auto breed = [&](const std::vector<double>& source, const std::vector<double>& parent, std::vector<double>& child) {
+        const uint32_t key1 = static_cast<uint32_t>(rng_());
+        const uint32_t key2 = static_cast<uint32_t>(rng_());
+        detail::breedReal(mutation, source.data(), parent.data(), child.data(), child.size(), lower_.data(),
+                          upper_.data(), key1, key2);
+    };
+    for (int gen = 0; gen < cfg_.generations; ++gen) {
+        if (cfg_.maxEvaluations > 0 && res.evaluations >= cfg_.maxEvaluations) break;
+
+        // Breed the whole offspring half serially, then score it in one batch
+        for (size_t i = 0; i < n; i += 2) {
+            const auto& p1 = pool_[tournament_(n)];
+            const auto& p2 = pool_[tournament_(n)];
+            MultiObjectiveIndividual& c1 = pool_[n + i];
+            MultiObjectiveIndividual& c2 = (i + 1 < n) ? pool_[n + i + 1] : spare_;
+            const bool crossed = prob(rng_) < cfg_.crossoverRate;
+            if (crossed) crossover_->crossoverInto(p1.genes, p2.genes, c1.genes, c2.genes);
+            breed(crossed ? c1.genes : p1.genes, p1.genes, c1.genes);
+            if (&c2 != &spare_) breed(crossed ? c2.genes : p2.genes, p2.genes, c2.genes);
+        }
+        evaluate_(n, n, fitness, res.evaluations);
+
+        rankAndCrowd_(2 * n);
+        survive_(n);
+        res.frontSizeHistory.push_back(front_size());
+    }
+
+    // Ranks of the survivors come from the combined sort; re-sort so the
+    // reported front is exactly the non-dominated set of the final population
+    rankAndCrowd_(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (rank_[i] == 0) res.front.push_back(pool_[i]);
+    }
+    return res;
+}
+
+} // namespace ga
@@ -0,0 +1,150 @@
+#include "ga/tour_cost.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ga {
+
+TourCost::TourCost(std::vector<double> distances, size_t cities)
+    : distances_(std::move(distances)), cities_(cities) {
+    if (distances_.size() != cities_ * cities_) {
+        throw std::invalid_argument("Distance matrix must have cities * cities entries");
+    }
+    for (size_t a = 0; a < cities_ && symmetric_; ++a) {
+        for (size_t b = a + 1; b < cities_; ++b) {
+            if (distances_[a * cities_ + b] != distances_[b * cities_ + a]) {
+                symmetric_ = false;
+                break;
+            }
+        }
+    }
+}
+
+TourCost TourCost::euclidean(const std::vector<double>& x, const std::vector<double>& y) {
+    if (x.size() != y.size()) throw std::invalid_argument("Coordinate vectors must have the same length");
+    const size_t n = x.size();
+    std::vector<double> d(n * n);
+    for (size_t a = 0; a < n; ++a) {
+        for (size_t b = 0; b < n; ++b) d[a * n + b] = std::hypot(x[a] - x[b], y[a] - y[b]);
+    }
+    return TourCost(std::move(d), n);
+}
+
+double TourCost::operator()(const std::vector<int>& tour) const {
+    if (tour.size() != cities_) throw std::invalid_argument("Tour length does not match the distance matrix");
+    if (tour.empty()) return 0.0;
+    double total = distance(tour.back(), tour.front());
+    for (size_t i = 0; i + 1 < tour.size(); ++i) total += distance(tour[i], tour[i + 1]);
+    return total;
+}
+
+double TourCost::moveDelta_(const std::vector<int>& after, size_t from, size_t to) const {
+    const size_t n = after.size();
+    auto at = [&](size_t k) { return after[(k + n) % n]; };
+    const int e = after[to];
+
+    // Moving an end city to the other end is a rotation of the cycle
+    if ((from == 0 && to == n - 1) || (from == n - 1 && to == 0)) return 0.0;
+
+    // The neighbours e had before the move, read from the shifted tour
+    const int prev = from < to ? at(from - 1) : at(from);
+    const int next = from < to ? at(from) : at(from + 1);
+    const int left = at(to - 1);
+    const int right = at(to + 1);
+
+    const double inserted = distance(left, e) + distance(e, right) - distance(left, right);
+    const double removed = distance(prev, e) + distance(e, next) - distance(prev, next);
+    return inserted - removed;
+}
+
+double TourCost::delta(const std::vector<int>& after, const PermutationEdit& edit) const {
+    const size_t n = after.size();
+    if (n != cities_) throw std::invalid_argument("Tour length does not match the distance matrix");
+    if (edit.kind == PermutationEdit::Kind::None || n < 2) return 0.0;
+    if (edit.first >= n || edit.second >= n) throw std::invalid_argument("Edit positions out of range");
+
+    const size_t i = edit.first;
+    const size_t j = edit.second;
+    switch (edit.kind) {
+    case PermutationEdit::Kind::Swap: {
+        auto before = [&](size_t k) { return k == i ? after[j] : (k == j ? after[i] : after[k]); };
+        // Edges leaving positions i-1, i, j-1, j are the only ones touched
+        size_t starts[4] = {(i + n - 1) % n, i, (j + n - 1) % n, j};
+        double change = 0.0;
+        for (int s = 0; s < 4; ++s) {
+            if (std::find(starts, starts + s, starts[s]) != starts + s) continue;
+            const size_t k = starts[s];
+            const size_t k1 = (k + 1) % n;
+            change += distance(after[k], after[k1]) - distance(before(k), before(k1));
+        }
+        return change;
+    }
+    case PermutationEdit::Kind::Reverse: {
+        if (i >= j) return 0.0;
+        const size_t s = i;
+        const size_t e = j;
+        if (e - s + 1 >= n) {
+            // The whole cycle reversed: same edges, traversed backwards
+            if (symmetric_) return 0.0;
+        }
+        const int a = after[(s + n - 1) % n];
+        const int b = after[(e + 1) % n];
+        double change = 0.0;
+        if (e - s + 1 < n) {
+            change = distance(a, after[s]) + distance(after[e], b)
+                   - distance(a, after[e]) - distance(after[s], b);
+        }
+        if (!symmetric_) {
+            // Interior edges now run the other way
+            for (size_t k = s; k < e; ++k) {
+                change += distance(after[k], after[k + 1]) - distance(after[k + 1], after[k]);
+            }
+            if (e - s + 1 >= n) change += distance(after[e], after[s]) - distance(after[s], after[e]);
+        }
+        return change;
+    }
+    case PermutationEdit::Kind::Move: {
+        if (i == j) return 0.0;
+        if (n < 4) {
+            // Too few cities for distinct neighbours; undo into a small buffer
+            int before[3];
+            for (size_t k = 0; k < n; ++k) before[k] = after[k];
+            const int e = before[j];
+            if (i < j) { for (size_t k = j; k > i; --k) before[k] = before[k - 1]; }
+            else { for (size_t k = j; k < i; ++k) before[k] = before[k + 1]; }
+            before[i] = e;
+            double old = distance(before[n - 1], before[0]);
+            for (size_t k = 0; k + 1 < n; ++k) old += distance(before[k], before[k + 1]);
+            return (*this)(after) - old;
+        }
+        return moveDelta_(after, i, j);
+    }
+    case PermutationEdit::Kind::Scramble:
+        throw std::invalid_argument("Scramble edits need the tour before the edit");
+    case PermutationEdit::Kind::None:
+        break;
+    }
+    return 0.0;
+}
+
+double TourCost::delta(const std::vector<int>& before, const std::vector<int>& after,
+                       const PermutationEdit& edit) const {
+    if (edit.kind != PermutationEdit::Kind::Scramble) return delta(after, edit);
+
+    const size_t n = after.size();
+    if (n != cities_ || before.size() != n) throw std::invalid_argument("Tour length does not match the distance matrix");
+    if (edit.first > edit.second || edit.second >= n) throw std::invalid_argument("Edit positions out of range");
+    if (edit.second - edit.first + 1 >= n) return (*this)(after) - (*this)(before);
+
+    // Edges leaving positions first-1 .. second
+    double change = 0.0;
+    for (size_t k = edit.first + n - 1; k <= edit.second + n; ++k) {
+        const size_t p = k % n;
+        const size_t q = (k + 1) % n;
+        change += distance(after[p], after[q]) - distance(before[p], before[q]);
+    }
+    return change;
+}
+
+} // namespace ga
@@ -0,0 +1,275 @@
+#include "ga/tour_local_search.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "ga/parallel.hpp"
+
+namespace ga {
+
+namespace {
+
+// Moves must gain more than this to count, so rounding cannot cycle
+constexpr double kEpsilon = 1e-10;
+
+// Per-thread state of one improve() call, reused across calls
+struct SearchState {
+    std::vector<int>* tour = nullptr;
+    std::vector<int> pos;
+    std::vector<int> queue; // circular FIFO of active cities
+    std::vector<char> active;
+    size_t head = 0;
+    size_t count = 0;
+    size_t n = 0;
+
+    void reset(std::vector<int>& t) {
+        tour = &t;
+        n = t.size();
+        pos.resize(n);
+        for (size_t i = 0; i < n; ++i) pos[t[i]] = static_cast<int>(i);
+        queue.resize(n);
+        active.assign(n, 1);
+        for (size_t i = 0; i < n; ++i) queue[i] = t[i];
+        head = 0;
+        count = n;
+    }
+
+    int at(size_t position) const { return (*tour)[position % n]; }
+    int succ(int c) const { return at(pos[c] + 1); }
+    int pred(int c) const { return at(pos[c] + n - 1); }
+
+    // Clears the don't-look bit of c
+    void wake(int c) {
+        if (active[c]) return;
+        active[c] = 1;
+        queue[(head + count) % n] = c;
+        ++count;
+    }
+
+    int pop() {
+        const int c = queue[head];
+        head = (head + 1) % n;
+        --count;
+        active[c] = 0;
+        return c;
+    }
+
+    // Reverses the cyclic run of positions i..j (inclusive, going forward)
+    void reverse(size_t i, size_t j) {
+        const size_t len = (j + n - i) % n + 1;
+        std::vector<int>& t = *tour;
+        for (size_t k = 0; k < len / 2; ++k) {
+            const size_t a = (i + k) % n;
+            const size_t b = (j + n - k) % n;
+            std::swap(t[a], t[b]);
+            pos[t[a]] = static_cast<int>(a);
+            pos[t[b]] = static_cast<int>(b);
+        }
+    }
+
+    // Reverses the shorter of i..j and its complement; on a symmetric matrix
+    // both give the same cycle
+    void reverseShorter(size_t i, size_t j) {
+        const size_t len = (j + n - i) % n + 1;
+        if (2 * len > n && len < n) reverse((j + 1) % n, (i + n - 1) % n);
+        else reverse(i, j);
+    }
+};
+
+thread_local SearchState t_state;
+
+} // namespace
+
+TourLocalSearch::TourLocalSearch(const TourCost& cost)
+    : TourLocalSearch(cost, Options()) {}
+
+TourLocalSearch::TourLocalSearch(const TourCost& cost, const Options& options)
+    : cost_(&cost), options_(options) {
+    if (!cost.symmetric()) throw std::invalid_argument("TourLocalSearch needs a symmetric distance matrix");
+
+    const size_t n = cost.cities();
+    k_ = n > 1 ? std::min(options_.neighbours, n - 1) : 0;
+    neighbours_.resize(n * k_);
+    std::vector<int> others(n);
+    for (size_t c = 0; c < n && k_ > 0; ++c) {
+        std::iota(others.begin(), others.end(), 0);
+        std::swap(others[c], others[n - 1]);
+        auto byDistance = [&](int a, int b) { return cost.distance(c, a) < cost.distance(c, b); };
+        std::partial_sort(others.begin(), others.begin() + k_, others.end() - 1, byDistance);
+        std::copy(others.begin(), others.begin() + k_, neighbours_.begin() + c * k_);
+    }
+}
+
+double TourLocalSearch::improve(std::vector<int>& tour, double cost, size_t& budget) const {
+    const size_t n = tour.size();
+    if (n != cost_->cities()) throw std::invalid_argument("Tour length does not match the distance matrix");
+    if (n < 5 || budget == 0) return cost;
+
+    SearchState& s = t_state;
+    s.reset(tour);
+    const TourCost& d = *cost_;
+
+    auto neighboursOf = [&](int c) { return &neighbours_[static_cast<size_t>(c) * k_]; };
+
+    // 2-opt: replace (a, b) and (c, e) by (a, c) and (b, e), trying b as a's
+    // successor and as its predecessor
+    auto twoOpt = [&](int a) {
+        for (int dir = 0; dir < 2; ++dir) {
+            const int b = dir == 0 ? s.succ(a) : s.pred(a);
+            const double dab = d.distance(a, b);
+            const int* nb = neighboursOf(a);
+            for (size_t k = 0; k < k_; ++k) {
+                const int c = nb[k];
+                const double dac = d.distance(a, c);
+                if (dac >= dab - kEpsilon) break; // later neighbours are farther still
+                const int e = dir == 0 ? s.succ(c) : s.pred(c);
+                if (c == b || e == a) continue;
+                if (budget == 0) return false;
+                --budget;
+                const double delta = dac + d.distance(b, e) - dab - d.distance(c, e);
+                if (delta < -kEpsilon) {
+                    if (dir == 0) s.reverseShorter(s.pos[b], s.pos[c]);
+                    else s.reverseShorter(s.pos[c], s.pos[b]);
+                    cost += delta;
+                    s.wake(a); s.wake(b); s.wake(c); s.wake(e);
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    // Or-opt: move the segment of up to maxSegment cities starting at a
+    // between two neighbouring cities x, y = succ(x), either way round
+    auto orOpt = [&](int a) {
+        const size_t maxLen = std::min(options_.maxSegment, n - 3);
+        for (size_t len = 1; len <= maxLen; ++len) {
+            const size_t i = s.pos[a];
+            const int first = a;
+            const int last = s.at(i + len - 1);
+            const int p = s.pred(first);
+            const int nx = s.succ(last);
+            const double removeGain = d.distance(p, first) + d.distance(last, nx) - d.distance(p, nx);
+            if (removeGain <= kEpsilon) continue;
+            auto inSegment = [&](int c) { return (static_cast<size_t>(s.pos[c]) + n - i) % n < len; };
+
+            for (int end = 0; end < 2; ++end) {
+                // end 0: `first` goes next to a neighbour c; end 1: `last` does
+                const int anchor = end == 0 ? first : last;
+                const int* nb = neighboursOf(anchor);
+                for (size_t k = 0; k < k_; ++k) {
+                    const int c = nb[k];
+                    const double dc = d.distance(anchor, c);
+                    if (dc >= removeGain - kEpsilon) break;
+                    if (inSegment(c)) continue;
+                    for (int side = 0; side < 2; ++side) {
+                        // Insert between x and y = succ(x), with c being x or y
+                        const int x = side == 0 ? c : s.pred(c);
+                        const int y = side == 0 ? s.succ(c) : c;
+                        if (inSegment(x) || inSegment(y)) continue;
+                        // Orientation follows from which end meets c
+                        const bool reversed = (end == 0) == (side == 1);
+                        const int left = reversed ? last : first;   // city next to x
+                        const int right = reversed ? first : last;  // city next to y
+                        if (budget == 0) return false;
+                        --budget;
+                        const double add = d.distance(x, left) + d.distance(right, y) - d.distance(x, y);
+                        const double delta = add - removeGain;
+                        if (delta >= -kEpsilon) continue;
+
+                        // Blocks after the segment: B1 = nx..x, B2 = y..p
+                        const size_t j = (i + len - 1) % n;
+                        const size_t m = (static_cast<size_t>(s.pos[x]) + n - s.pos[nx]) % n + 1;
+                        if (len + m <= n - m) {
+                            // Swap S and B1: reverse both, then each part back
+                            const size_t px = s.pos[x];
+                            s.reverse(i, px);
+                            s.reverse(i, (i + m - 1) % n);
+                            if (!reversed) s.reverse((i + m) % n, px);
+                        } else {
+                            // Swap B2 and S
+                            const size_t py = s.pos[y];
+                            s.reverse(py, j);
+                            s.reverse((py + len) % n, j);
+                            if (!reversed) s.reverse(py, (py + len - 1) % n);
+                        }
+                        cost += delta;
+                        s.wake(p); s.wake(nx); s.wake(first); s.wake(last); s.wake(x); s.wake(y);
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    };
+
+    while (s.count > 0 && budget > 0) {
+        const int a = s.pop();
+        bool improved = false;
+        if (options_.twoOpt) improved = twoOpt(a);
+        if (!improved && options_.orOpt) improved = orOpt(a);
+        if (improved) s.wake(a);
+    }
+    return cost;
+}
+
+MemeticStage::MemeticStage(std::unique_ptr<TourImprover> improver, const Options& options)
+    : improver_(std::move(improver)), options_(options) {
+    if (!improver_) throw std::invalid_argument("MemeticStage needs an improver");
+    if (options_.fraction < 0.0 || options_.fraction > 1.0) {
+        throw std::invalid_argument("MemeticStage fraction must be in [0, 1]");
+    }
+}
+
+size_t MemeticStage::apply(std::vector<std::vector<int>>& tours, std::vector<double>& costs, std::mt19937& rng) {
+    if (tours.size() != costs.size()) throw std::invalid_argument("Tours and costs must have the same length");
+    const size_t total = tours.size();
+    size_t k = std::min(total, static_cast<size_t>(std::round(options_.fraction * total)));
+    if (k == 0 || exhausted()) return 0;
+    // Every improved tour gets at least one move, so a nearly spent budget
+    // improves fewer tours
+    const size_t remaining = options_.totalBudget > 0 ? options_.totalBudget - used_ : 0;
+    if (options_.totalBudget > 0) k = std::min(k, remaining);
+
+    // Partial Fisher-Yates picks the k tours
+    chosen_.resize(total);
+    std::iota(chosen_.begin(), chosen_.end(), 0);
+    for (size_t i = 0; i < k; ++i) {
+        std::uniform_int_distribution<size_t> pick(i, total - 1);
+        std::swap(chosen_[i], chosen_[pick(rng)]);
+    }
+
+    // The remaining budget is split evenly, its remainder going one move each
+    // to the first tours, so the shares never sum to more than it
+    const size_t cap = options_.movesPerTour > 0 ? options_.movesPerTour : std::numeric_limits<size_t>::max();
+    auto share = [&](size_t t) {
+        if (options_.totalBudget == 0) return cap;
+        return std::min(cap, remaining / k + (t < remaining % k ? 1 : 0));
+    };
+
+    spent_.assign(k, 0);
+    improved_.assign(k, 0);
+    parallelFor(k, resolveThreads(options_.threads), [&](size_t begin, size_t end, size_t) {
+        for (size_t t = begin; t < end; ++t) {
+            const size_t idx = chosen_[t];
+            const size_t allowed = share(t);
+            size_t budget = allowed;
+            const double before = costs[idx];
+            costs[idx] = improver_->improve(tours[idx], before, budget);
+            spent_[t] = allowed - budget;
+            improved_[t] = costs[idx] < before;
+        }
+    });
+
+    size_t improved = 0;
+    for (size_t t = 0; t < k; ++t) {
+        used_ += spent_[t];
+        improved += improved_[t];
+    }
+    return improved;
+}
+
+} // namespace ga
@@ -0,0 +1,37 @@
+#include "variation.hpp"
+
+#include <stdexcept>
+
+#include "mutation/gaussian_mutation.h"
+#include "mutation/uniform_mutation.h"
+#include "crossover/simulated_binary_crossover.h"
+
+namespace ga {
+namespace detail {
+
+GeneMutation resolveMutation(const MutationOperator& op, double rate, BoundHandling handling) {
+    if (!(rate >= 0.0 && rate <= 1.0)) throw std::invalid_argument("Mutation rate must be in [0, 1]");
+    GeneMutation m;
+    m.rate = rate;
+    m.handling = handling;
+    if (dynamic_cast<const GaussianMutation*>(&op)) {
+        m.kind = GeneMutation::Kind::Gaussian;
+    } else if (dynamic_cast<const UniformMutation*>(&op)) {
+        m.kind = GeneMutation::Kind::Uniform;
+    }
+    return m;
+}
+
+void breedReal(const GeneMutation& mutation, const double* source, const double* parent, double* child, size_t n,
+               const double* lower, const double* upper, uint32_t key1, uint32_t key2) {
+    for (size_t i = 0; i < n; ++i) {
+        child[i] = mutation.apply(source[i], i, lower[i], upper[i], parent[i], key1, key2);
+    }
+}
+
+void shareBounds(CrossoverOperator& op, const std::vector<double>& lower, const std::vector<double>& upper) {
+    if (auto* sbx = dynamic_cast<SimulatedBinaryCrossover*>(&op)) sbx->setBounds(lower, upper);
+}
+
+} // namespace detail
+} // namespace ga
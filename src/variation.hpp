@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ga/bounds.hpp"
+#include "ga/config.hpp"
+#include "common/recombination_kernels.h"
+
+class MutationOperator;
+class CrossoverOperator;
+
+namespace ga {
+namespace detail {
+
+// A real-valued mutation operator (Gaussian or uniform) reduced to what the
+// engines' gene loops need, with the run's bound handling. Resolved and
+// validated once per run, so the offspring loops neither look the operator
+// up nor re-check parameters.
+struct GeneMutation {
+    enum class Kind { None, Gaussian, Uniform };
+    Kind kind = Kind::None;
+    double rate = 0.0;
+    double sigma = 0.1; // Gaussian step
+    BoundHandling handling = BoundHandling::Clamp;
+
+    // Gene `locus` of a child after mutation and repair into [lower, upper];
+    // `parent` is the gene the child inherited there. A child's draws come
+    // from the counter-based stream keyed by key1/key2: counter 4 locus
+    // decides whether the gene mutates, + 1 and + 2 feed the perturbation
+    // and + 3 a Resample repair.
+    double apply(double x, size_t locus, double lower, double upper, double parent,
+                 uint32_t key1, uint32_t key2) const {
+        const uint32_t counter = static_cast<uint32_t>(4 * locus);
+        if (kind != Kind::None && uniform(counter, key1, key2) < rate) {
+            const double u1 = uniform(counter + 1, key1, key2);
+            if (kind == Kind::Uniform) {
+                x = lower + u1 * (upper - lower);
+            } else {
+                // Box-Muller, one normal per mutated gene
+                const double u2 = uniform(counter + 2, key1, key2);
+                x += sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+            }
+        }
+        if (x >= lower && x <= upper) return x;
+        const double u3 = handling == BoundHandling::Resample ? uniform(counter + 3, key1, key2) : 0.0;
+        return repairGene(handling, x, lower, upper, parent, u3);
+    }
+
+    static double uniform(uint32_t counter, uint32_t key1, uint32_t key2) {
+        using recombination_kernels::hash32;
+        return (hash32(hash32(counter + key1) ^ key2) + 0.5) * (1.0 / 4294967296.0);
+    }
+};
+
+// Throws std::invalid_argument for a rate outside [0, 1]; operators other
+// than Gaussian and uniform mutation resolve to Kind::None (repair only)
+GeneMutation resolveMutation(const MutationOperator& op, double rate, BoundHandling handling);
+
+// Fused offspring pass: child[i] = repair(mutate(source[i])) for every gene.
+// source is the crossover output already in child or, for a pair that was
+// not crossed, the parent itself, so copying it costs no extra pass; parent
+// is the parent the child is repaired towards.
+void breedReal(const GeneMutation& mutation, const double* source, const double* parent, double* child, size_t n,
+               const double* lower, const double* upper, uint32_t key1, uint32_t key2);
+
+// Points a bounded operator (SBX) at the run's bounds; they are viewed, so
+// they must stay in place for the run
+void shareBounds(CrossoverOperator& op, const std::vector<double>& lower, const std::vector<double>& upper);
+
+} // namespace detail
+} // namespace ga
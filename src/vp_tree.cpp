@@ -0,0 +1,202 @@
+#include "ga/vp_tree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ga {
+
+namespace {
+
+// Max-heap order on distance
+bool closer(const Neighbour& a, const Neighbour& b) {
+    return a.distance < b.distance;
+}
+
+void offer(std::vector<Neighbour>& heap, size_t k, double distance, size_t id) {
+    if (heap.size() < k) {
+        heap.push_back(Neighbour{distance, id});
+        std::push_heap(heap.begin(), heap.end(), closer);
+    } else if (distance < heap.front().distance) {
+        std::pop_heap(heap.begin(), heap.end(), closer);
+        heap.back() = Neighbour{distance, id};
+        std::push_heap(heap.begin(), heap.end(), closer);
+    }
+}
+
+double bound(const std::vector<Neighbour>& heap, size_t k) {
+    return heap.size() < k ? std::numeric_limits<double>::infinity() : heap.front().distance;
+}
+
+double euclidean(const double* a, const double* b, size_t dimension) {
+    double s = 0.0;
+    for (size_t d = 0; d < dimension; ++d) {
+        const double t = a[d] - b[d];
+        s += t * t;
+    }
+    return std::sqrt(s);
+}
+
+} // namespace
+
+double VpTree::distance_(const double* points, const double* a, size_t id) const {
+    return euclidean(a, points + id * dimension_, dimension_);
+}
+
+void VpTree::build(const double* points, size_t dimension, const size_t* ids, size_t count) {
+    dimension_ = dimension;
+    ids_.assign(ids, ids + count);
+    radius_.assign(count, 0.0);
+    work_.resize(count);
+    uint64_t state = 0x9e3779b97f4a7c15ULL ^ count;
+    build_(points, 0, count, state);
+}
+
+void VpTree::clear() {
+    ids_.clear();
+    radius_.clear();
+}
+
+void VpTree::build_(const double* points, size_t lo, size_t hi, uint64_t& state) {
+    if (hi - lo <= 1) return;
+
+    // xorshift64 picks the vantage point
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    std::swap(ids_[lo], ids_[lo + state % (hi - lo)]);
+
+    const double* vantage = points + ids_[lo] * dimension_;
+    for (size_t i = lo + 1; i < hi; ++i) work_[i] = Neighbour{distance_(points, vantage, ids_[i]), ids_[i]};
+    const size_t mid = lo + 1 + (hi - lo - 1) / 2;
+    std::nth_element(work_.begin() + (lo + 1), work_.begin() + mid, work_.begin() + hi, closer);
+    radius_[lo] = work_[mid].distance;
+    for (size_t i = lo + 1; i < hi; ++i) ids_[i] = work_[i].id;
+
+    build_(points, lo + 1, mid, state);
+    build_(points, mid, hi, state);
+}
+
+void VpTree::search(const double* points, const double* query, size_t k, std::vector<Neighbour>& heap,
+                    size_t exclude, const std::vector<char>* removed) const {
+    if (k == 0) return;
+    search_(points, 0, ids_.size(), query, k, heap, exclude, removed);
+}
+
+void VpTree::search_(const double* points, size_t lo, size_t hi, const double* query, size_t k,
+                     std::vector<Neighbour>& heap, size_t exclude, const std::vector<char>* removed) const {
+    if (lo >= hi) return;
+    const size_t id = ids_[lo];
+    const double d = distance_(points, query, id);
+    if (id != exclude && !(removed && (*removed)[id])) offer(heap, k, d, id);
+    if (hi - lo == 1) return;
+
+    // Inside points lie within r of the vantage point, outside points beyond
+    // it; the triangle inequality bounds their distance to the query
+    const size_t mid = lo + 1 + (hi - lo - 1) / 2;
+    const double r = radius_[lo];
+    if (d < r) {
+        search_(points, lo + 1, mid, query, k, heap, exclude, removed);
+        if (d + bound(heap, k) >= r) search_(points, mid, hi, query, k, heap, exclude, removed);
+    } else {
+        search_(points, mid, hi, query, k, heap, exclude, removed);
+        if (d - bound(heap, k) <= r) search_(points, lo + 1, mid, query, k, heap, exclude, removed);
+    }
+}
+
+void VpForest::reset(size_t dimension) {
+    dimension_ = dimension;
+    points_.clear();
+    removed_.clear();
+    free_.clear();
+    live_ = 0;
+    erased_ = 0;
+    buffer_.clear();
+    trees_.clear();
+}
+
+size_t VpForest::insert(const double* point) {
+    size_t id;
+    if (!free_.empty()) {
+        id = free_.back();
+        free_.pop_back();
+        removed_[id] = 0;
+    } else {
+        id = removed_.size();
+        points_.resize(points_.size() + dimension_);
+        removed_.push_back(0);
+    }
+    std::copy(point, point + dimension_, points_.begin() + id * dimension_);
+    ++live_;
+
+    buffer_.push_back(id);
+    if (buffer_.size() == kBuffer) {
+        addToTrees_(buffer_);
+        buffer_.clear();
+    }
+    return id;
+}
+
+void VpForest::erase(size_t id) {
+    if (id >= removed_.size() || removed_[id]) return;
+    removed_[id] = 1;
+    --live_;
+    ++erased_;
+    if (erased_ > kBuffer && erased_ > live_) rebuild_();
+}
+
+void VpForest::addToTrees_(std::vector<size_t>& ids) {
+    // Binary counter: merge with each occupied level until a free one is found
+    carry_.assign(ids.begin(), ids.end());
+    for (size_t l = 0;; ++l) {
+        if (l == trees_.size()) trees_.emplace_back();
+        if (trees_[l].size() == 0) {
+            trees_[l].build(points_.data(), dimension_, carry_.data(), carry_.size());
+            return;
+        }
+        carry_.insert(carry_.end(), trees_[l].ids().begin(), trees_[l].ids().end());
+        trees_[l].clear();
+    }
+}
+
+void VpForest::rebuild_() {
+    std::vector<size_t> live;
+    live.reserve(live_);
+    auto collect = [&](const std::vector<size_t>& ids) {
+        for (size_t id : ids) {
+            if (removed_[id]) free_.push_back(id);
+            else live.push_back(id);
+        }
+    };
+    for (const VpTree& tree : trees_) collect(tree.ids());
+    collect(buffer_);
+    erased_ = 0;
+
+    // Refill the levels from the binary representation of the live count;
+    // the remainder goes back to the buffer
+    const size_t blocks = live.size() / kBuffer;
+    size_t at = 0;
+    for (size_t l = 0; l < trees_.size() || (blocks >> l) != 0; ++l) {
+        if (l == trees_.size()) trees_.emplace_back();
+        if ((blocks >> l) & 1) {
+            const size_t count = kBuffer << l;
+            trees_[l].build(points_.data(), dimension_, live.data() + at, count);
+            at += count;
+        } else {
+            trees_[l].clear();
+        }
+    }
+    buffer_.assign(live.begin() + at, live.end());
+}
+
+void VpForest::search(const double* query, size_t k, std::vector<Neighbour>& heap) const {
+    if (k == 0) return;
+    for (size_t id : buffer_) {
+        if (!removed_[id]) offer(heap, k, euclidean(query, point(id), dimension_), id);
+    }
+    for (const VpTree& tree : trees_) {
+        tree.search(points_.data(), query, k, heap, VpTree::npos, &removed_);
+    }
+}
+
+} // namespace ga
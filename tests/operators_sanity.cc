@@ -2,8 +2,27 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <numeric>
 #include <stdexcept>
 #include <utility>
+#include <cstdlib>
+#include <cmath>
+#include <new>
+
+#include "ga/genetic_algorithm.hpp"
+#include "ga/bounds.hpp"
+#include "ga/gp_evaluator.hpp"
+#include "ga/cmaes.hpp"
+#include "ga/differential_evolution.hpp"
+#include "ga/eda.hpp"
+#include "ga/genome_hash.hpp"
+#include "ga/local_search.hpp"
+#include "ga/niching.hpp"
+#include "ga/novelty_search.hpp"
+#include "ga/nsga2.hpp"
+#include "ga/tour_cost.hpp"
+#include "ga/tour_local_search.hpp"
+#include "ga/vp_tree.hpp"
 
 // Crossover operators
 #include "crossover/base_crossover.h"
@@ -24,6 +43,7 @@
 #include "crossover/subtree_crossover.h"
 #include "crossover/diploid_recombination.h"
 #include "crossover/differential_evolution_crossover.h"
+#include "common/recombination_kernels.h"
 
 // Mutation operators
 #include "mutation/base_mutation.h"
@@ -45,10 +65,25 @@
 #include "selection-operator/rank_selection.h"
 #include "selection-operator/stochastic_universal_sampling.h"
 #include "selection-operator/elitism_selection.h"
+#include "selection-operator/elite_archive.h"
 
 using std::cout;
 using std::endl;
 
+// Count heap allocations so steady-state code paths can be checked for reuse.
+// GCC cannot see that the replaced operators pair malloc with free.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+static size_t g_allocations = 0;
+void* operator new(std::size_t n) {
+    ++g_allocations;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
 static void print_status(const std::string& name, bool ok, const std::string& note = "") {
     if (ok) cout << "[PASS] " << name << (note.empty()?"":" - "+note) << endl;
     else cout << "[FAIL] " << name << (note.empty()?"":" - "+note) << endl;
@@ -70,6 +105,11 @@ static std::vector<int> make_ints(int n) {
     return v;
 }
 static std::vector<int> make_perm(int n) { return make_ints(n); }
+static bool is_perm(const std::vector<int>& v) {
+    std::vector<int> s = v; std::sort(s.begin(), s.end());
+    for (int i=0;i<(int)s.size();++i) if (s[i]!=i) return false;
+    return true;
+}
 
 int main(){
     bool all_ok = true;
@@ -107,10 +147,6 @@ int main(){
     // Permutation crossovers
     {
         auto a = make_perm(10), b = make_perm(10);
-        auto is_perm = [](const std::vector<int>& v){
-            std::vector<int> s = v; std::sort(s.begin(), s.end());
-            for (int i=0;i<(int)s.size();++i) if (s[i]!=i) return false; return true;
-        };
         try { OrderCrossover op; auto c = op.crossover(a,b); bool ok = is_perm(c.first) && is_perm(c.second); print_status("OrderCrossover<Perm>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("OrderCrossover<Perm>", false, e.what()); all_ok=false; }
         try { PartiallyMappedCrossover op; auto c = op.crossover(a,b); bool ok = is_perm(c.first) && is_perm(c.second); print_status("PMX<Perm>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("PMX<Perm>", false, e.what()); all_ok=false; }
         try { CycleCrossover op; auto c = op.crossover(a,b); bool ok = is_perm(c.first) && is_perm(c.second); print_status("CycleCrossover<Perm>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("CycleCrossover<Perm>", false, e.what()); all_ok=false; }
@@ -118,6 +154,731 @@ int main(){
         try { CutAndCrossfillCrossover op; auto c = op.crossover(a,b); bool ok = is_perm(c.first) && is_perm(c.second); print_status("CutAndCrossfill<Perm>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("CutAndCrossfill<Perm>", false, e.what()); all_ok=false; }
     }
 
+    // Buffer-based crossovers (children written into caller-owned storage)
+    {
+        auto a = make_real(10), b = make_real(10);
+        RealVector c1(10), c2(10);
+        auto in_range = [&](){ for (int i=0;i<10;++i) if (!std::isfinite(c1[i]) || !std::isfinite(c2[i])) return false; return true; };
+        try { OnePointCrossover op; op.crossoverInto(a,b,c1,c2); bool ok = in_range(); print_status("OnePointCrossover::crossoverInto<Real>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("OnePointCrossover::crossoverInto<Real>", false, e.what()); all_ok=false; }
+        try { MultiPointCrossover op(3); op.crossoverInto(a,b,c1,c2); bool ok = in_range(); print_status("MultiPointCrossover::crossoverInto<Real>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("MultiPointCrossover::crossoverInto<Real>", false, e.what()); all_ok=false; }
+        try { SimulatedBinaryCrossover op(2.0); op.crossoverInto(a,b,c1,c2); bool ok = in_range(); print_status("SBX::crossoverInto<Real>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("SBX::crossoverInto<Real>", false, e.what()); all_ok=false; }
+        try { RealVector short_child(5); OnePointCrossover op; op.crossoverInto(a,b,short_child,c2); print_status("crossoverInto rejects unsized child", false); all_ok=false; } catch(const std::invalid_argument&){ print_status("crossoverInto rejects unsized child", true); }
+
+        auto p = make_perm(10), q = make_perm(10);
+        std::reverse(q.begin(), q.end());
+        Permutation d1(10), d2(10);
+        try { OrderCrossover op; op.crossoverInto(p,q,d1,d2); bool ok = is_perm(d1) && is_perm(d2); print_status("OrderCrossover::crossoverInto<Perm>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("OrderCrossover::crossoverInto<Perm>", false, e.what()); all_ok=false; }
+        try { PartiallyMappedCrossover op; op.crossoverInto(p,q,d1,d2); bool ok = is_perm(d1) && is_perm(d2); print_status("PMX::crossoverInto<Perm>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("PMX::crossoverInto<Perm>", false, e.what()); all_ok=false; }
+        try { CycleCrossover op; op.crossoverInto(p,q,d1,d2); bool ok = is_perm(d1) && is_perm(d2); print_status("CycleCrossover::crossoverInto<Perm>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("CycleCrossover::crossoverInto<Perm>", false, e.what()); all_ok=false; }
+        try { EdgeCrossover op; op.crossoverInto(p,q,d1,d2); bool ok = is_perm(d1) && is_perm(d2); print_status("EdgeCrossover::crossoverInto<Perm>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("EdgeCrossover::crossoverInto<Perm>", false, e.what()); all_ok=false; }
+        try { CutAndCrossfillCrossover op; op.crossoverInto(p,q,d1,d2); bool ok = is_perm(d1) && is_perm(d2); print_status("CutAndCrossfill::crossoverInto<Perm>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("CutAndCrossfill::crossoverInto<Perm>", false, e.what()); all_ok=false; }
+
+        // Large tours exercise the linear-time index paths; non-permutations are rejected
+        const int big = 20000;
+        auto bp = make_perm(big), bq = make_perm(big);
+        std::mt19937 shuffle_rng(3); std::shuffle(bq.begin(), bq.end(), shuffle_rng);
+        Permutation b1(big), b2(big);
+        try { PartiallyMappedCrossover op; for(int r=0;r<5;++r) op.crossoverInto(bp,bq,b1,b2); bool ok = is_perm(b1) && is_perm(b2); print_status("PMX::crossoverInto<Perm 20000>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("PMX::crossoverInto<Perm 20000>", false, e.what()); all_ok=false; }
+        try { OrderCrossover op; for(int r=0;r<5;++r) op.crossoverInto(bp,bq,b1,b2); bool ok = is_perm(b1) && is_perm(b2); print_status("OrderCrossover::crossoverInto<Perm 20000>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("OrderCrossover::crossoverInto<Perm 20000>", false, e.what()); all_ok=false; }
+        try { CycleCrossover op; for(int r=0;r<5;++r) op.crossoverInto(bp,bq,b1,b2); bool ok = is_perm(b1) && is_perm(b2); print_status("CycleCrossover::crossoverInto<Perm 20000>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("CycleCrossover::crossoverInto<Perm 20000>", false, e.what()); all_ok=false; }
+        for (auto variant : {EdgeCrossover::Variant::ER, EdgeCrossover::Variant::ER4, EdgeCrossover::Variant::EAX}) {
+            std::string name = std::string("EdgeCrossover(") + (variant == EdgeCrossover::Variant::ER ? "ER" : variant == EdgeCrossover::Variant::ER4 ? "ER4" : "EAX") + ")::crossoverInto<Perm 20000>";
+            try { EdgeCrossover op(variant, 11); for(int r=0;r<3;++r) op.crossoverInto(bp,bq,b1,b2); bool ok = is_perm(b1) && is_perm(b2); print_status(name, ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status(name, false, e.what()); all_ok=false; }
+        }
+        try { EdgeCrossover op(EdgeCrossover::Variant::EAX, 5); op.setEdgeCost([](int a, int b){ return std::abs(a - b); }); bool ok = true; for(int r=0;r<50;++r){ auto s = make_perm(12), t = make_perm(12); std::shuffle(s.begin(), s.end(), shuffle_rng); std::shuffle(t.begin(), t.end(), shuffle_rng); Permutation e1(12), e2(12); op.crossoverInto(s,t,e1,e2); ok = ok && is_perm(e1) && is_perm(e2); } print_status("EdgeCrossover(EAX) with edge cost", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("EdgeCrossover(EAX) with edge cost", false, e.what()); all_ok=false; }
+        // EAX children take an AB-cycle's parent2 edges, whichever parity the cycle
+        // starts on; only the few whose subtour merge drops them again may lack one
+        try {
+            const int n = 30;
+            auto edges = [&](const Permutation& t){ std::vector<std::pair<int,int>> e; for (int i=0;i<n;++i) e.emplace_back(std::min(t[i], t[(i+1)%n]), std::max(t[i], t[(i+1)%n])); std::sort(e.begin(), e.end()); return e; };
+            EdgeCrossover op(EdgeCrossover::Variant::EAX, 17);
+            int matings = 400, borrowed = 0; bool ok = true;
+            for (int r=0;r<matings;++r) {
+                auto s = make_perm(n), t = make_perm(n); std::shuffle(s.begin(), s.end(), shuffle_rng); std::shuffle(t.begin(), t.end(), shuffle_rng);
+                Permutation e1(n), e2(n); op.crossoverInto(s,t,e1,e2);
+                auto es = edges(s), et = edges(t), ec = edges(e1);
+                ok = ok && is_perm(e1) && is_perm(e2);
+                borrowed += std::any_of(ec.begin(), ec.end(), [&](const std::pair<int,int>& e){ return std::binary_search(et.begin(), et.end(), e) && !std::binary_search(es.begin(), es.end(), e); });
+            }
+            ok = ok && borrowed >= matings * 85 / 100;
+            print_status("EdgeCrossover(EAX) takes parent2 edges", ok, std::to_string(borrowed) + "/" + std::to_string(matings)); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("EdgeCrossover(EAX) takes parent2 edges", false, e.what()); all_ok=false; }
+        try { Permutation bad = p; bad[0] = bad[1]; PartiallyMappedCrossover op; op.crossoverInto(bad,q,d1,d2); print_status("PMX rejects non-permutation", false); all_ok=false; } catch(const std::invalid_argument&){ print_status("PMX rejects non-permutation", true); }
+    }
+
+    // Batched real-valued recombination over a population matrix
+    {
+        const size_t dim = 37, rows = 40, pairs = 64;
+        std::mt19937 rng(17); std::uniform_real_distribution<double> u(-5.0, 5.0);
+        std::vector<double> pop(rows * dim), out(2 * pairs * dim), again(out.size());
+        for (double& v : pop) v = u(rng);
+        for (size_t j = 0; j < dim; ++j) pop[3 * dim + j] = pop[2 * dim + j]; // rows 2 and 3 identical
+        std::vector<size_t> parents(2 * pairs);
+        for (size_t t = 0; t < pairs; ++t) { parents[2 * t] = t % rows; parents[2 * t + 1] = (7 * t + 3) % rows; }
+        parents[0] = 2; parents[1] = 3;
+        auto row = [&](const std::vector<double>& m, size_t r){ return &m[r * dim]; };
+        try {
+            bool ok = true; double worst = 0.0;
+            for (double x = 1e-6; x < 1e6; x *= 1.37) {
+                for (double y : {-31.0, -2.5, -0.3, 0.07, 0.5, 1.0 / 3, 2.0, 11.0}) {
+                    double ref = std::pow(x, y), got = recombination_kernels::fastPow(x, y);
+                    worst = std::max(worst, std::fabs(got - ref) / ref);
+                }
+            }
+            ok = worst < 1e-8;
+            print_status("recombination_kernels::fastPow", ok, "max rel err " + std::to_string(worst * 1e12) + "e-12"); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("recombination_kernels::fastPow", false, e.what()); all_ok=false; }
+        try {
+            // Unbounded SBX spreads the children symmetrically about the parents' mean
+            SimulatedBinaryCrossover op(15.0, 5), same(15.0, 5);
+            op.crossoverBatch(pop.data(), dim, parents.data(), pairs, out.data());
+            same.crossoverBatch(pop.data(), dim, parents.data(), pairs, again.data());
+            bool ok = out == again && op.getOperationCount() == pairs;
+            for (size_t t = 0; ok && t < pairs; ++t) {
+                const double *p1 = row(pop, parents[2 * t]), *p2 = row(pop, parents[2 * t + 1]);
+                const double *c1 = row(out, 2 * t), *c2 = row(out, 2 * t + 1);
+                for (size_t j = 0; ok && j < dim; ++j) ok = std::isfinite(c1[j]) && std::fabs((c1[j] + c2[j]) - (p1[j] + p2[j])) < 1e-9;
+            }
+            for (size_t j = 0; ok && j < dim; ++j) ok = out[j] == pop[2 * dim + j] && out[dim + j] == pop[3 * dim + j];
+            print_status("SBX::crossoverBatch", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("SBX::crossoverBatch", false, e.what()); all_ok=false; }
+        try {
+            // Bounded SBX keeps every child inside the box, also for parents on a bound
+            std::vector<double> lo(dim, -5.0), hi(dim, 5.0);
+            for (size_t j = 0; j < dim; ++j) pop[5 * dim + j] = j % 2 ? -5.0 : 5.0;
+            SimulatedBinaryCrossover op(2.0, 8);
+            op.setBounds(lo, hi);
+            op.crossoverBatch(pop.data(), dim, parents.data(), pairs, out.data());
+            RealVector c1(dim), c2(dim);
+            op.crossoverInto(ConstRealSpan(row(pop, 5), dim), ConstRealSpan(row(pop, 6), dim), c1, c2);
+            bool ok = op.isBounded();
+            for (double v : out) ok = ok && v >= -5.0 && v <= 5.0;
+            for (size_t j = 0; j < dim; ++j) ok = ok && c1[j] >= -5.0 && c1[j] <= 5.0 && c2[j] >= -5.0 && c2[j] <= 5.0;
+            bool rejected = false;
+            try { std::vector<double> bad(dim + 1, 0.0); op.setBounds(lo, bad); } catch(const std::invalid_argument&){ rejected = true; }
+            ok = ok && rejected;
+            print_status("SBX bounded", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("SBX bounded", false, e.what()); all_ok=false; }
+        try {
+            // BLX-0.5 children fall inside the parents' interval extended by alpha I on both sides
+            BlendCrossover op(0.5, 3);
+            op.crossoverBatch(pop.data(), dim, parents.data(), pairs, out.data());
+            bool ok = true; double sum = 0.0;
+            for (size_t t = 0; t < pairs; ++t) {
+                const double *p1 = row(pop, parents[2 * t]), *p2 = row(pop, parents[2 * t + 1]);
+                for (size_t k = 0; k < 2; ++k) {
+                    const double* c = row(out, 2 * t + k);
+                    for (size_t j = 0; j < dim; ++j) {
+                        double l = std::min(p1[j], p2[j]), h = std::max(p1[j], p2[j]), I = h - l;
+                        ok = ok && c[j] >= l - 0.5 * I - 1e-12 && c[j] <= h + 0.5 * I + 1e-12;
+                        if (I > 0) sum += (c[j] - (l - 0.5 * I)) / (2 * I);
+                    }
+                }
+            }
+            // Positions within the extended interval are uniform: mean near 1/2
+            double mean = sum / (2 * (pairs - 1) * dim);
+            ok = ok && std::fabs(mean - 0.5) < 0.02;
+            print_status("BlendCrossover::crossoverBatch", ok, "mean position " + std::to_string(mean)); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("BlendCrossover::crossoverBatch", false, e.what()); all_ok=false; }
+        try {
+            // Line recombination children lie on the line through the parents
+            LineRecombination op(0.25, 3);
+            op.crossoverBatch(pop.data(), dim, parents.data(), pairs, out.data());
+            bool ok = true;
+            for (size_t t = 1; t < pairs; ++t) {
+                const double *p1 = row(pop, parents[2 * t]), *p2 = row(pop, parents[2 * t + 1]);
+                for (size_t j = 0; j < dim; ++j) {
+                    if (std::fabs(p1[j] - p2[j]) < 1e-9) continue;
+                    double a = (out[2 * t * dim + j] - p2[j]) / (p1[j] - p2[j]);
+                    ok = ok && a >= -0.25 - 1e-9 && a <= 1.25 + 1e-9;
+                }
+            }
+            print_status("LineRecombination::crossoverBatch", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("LineRecombination::crossoverBatch", false, e.what()); all_ok=false; }
+        try {
+            // Intermediate is deterministic: the batch matches crossoverInto pair by pair, and the
+            // base-class default (one-point) fills every child row from its two parents
+            IntermediateRecombination op(0.3);
+            op.crossoverBatch(pop.data(), dim, parents.data(), pairs, out.data());
+            bool ok = true;
+            RealVector c1(dim), c2(dim);
+            for (size_t t = 0; t < pairs; ++t) {
+                const double *p1 = row(pop, parents[2 * t]), *p2 = row(pop, parents[2 * t + 1]);
+                op.crossoverInto(ConstRealSpan(p1, dim), ConstRealSpan(p2, dim), c1, c2);
+                ok = ok && std::equal(c1.begin(), c1.end(), row(out, 2 * t)) && std::equal(c2.begin(), c2.end(), row(out, 2 * t + 1));
+            }
+            OnePointCrossover one(4);
+            one.crossoverBatch(pop.data(), dim, parents.data(), pairs, out.data());
+            for (size_t t = 0; t < pairs; ++t) {
+                const double *p1 = row(pop, parents[2 * t]), *p2 = row(pop, parents[2 * t + 1]);
+                for (size_t j = 0; j < dim; ++j) {
+                    double a = out[2 * t * dim + j], b = out[(2 * t + 1) * dim + j];
+                    ok = ok && ((a == p1[j] && b == p2[j]) || (a == p2[j] && b == p1[j]));
+                }
+            }
+            print_status("IntermediateRecombination/default crossoverBatch", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("IntermediateRecombination/default crossoverBatch", false, e.what()); all_ok=false; }
+    }
+
+    // Linear GP trees: subtree crossover keeps prefix order and subtree sizes consistent
+    {
+        auto node = [](const std::string& v, std::vector<TreeNode*> kids = {}){ auto* n = new TreeNode(v); n->children = kids; return n; };
+        TreeNode* t1 = node("+", {node("x0"), node("*", {node("x1"), node("2")})});
+        TreeNode* t2 = node("sin", {node("-", {node("x0"), node("x1")})});
+        auto consistent = [](const LinearTree& t){
+            for (size_t i = 0; i < t.size(); ++i) {
+                size_t end = i + 1;
+                for (uint32_t k = 0; k < t[i].arity; ++k) end = t.subtreeEnd(end);
+                if (end != t.subtreeEnd(i) || t.subtreeEnd(i) > t.size()) return false;
+            }
+            return !t.empty() && t.subtreeEnd(0) == t.size();
+        };
+        try {
+            OpcodeTable opcodes; TreeArena current(64), next(64);
+            LinearTree a = LinearTree::fromTree(t1, opcodes, current), b = LinearTree::fromTree(t2, opcodes, current);
+            TreeNode* back = a.toTree(opcodes);
+            bool ok = a.size() == 5 && a.depth() == 3 && back->value == "+" && back->children[1]->children[1]->value == "2";
+            delete back;
+            SubtreeCrossover op(9);
+            for (int gen = 0; gen < 200 && ok; ++gen) {
+                auto children = op.crossover(a, b, next);
+                ok = consistent(children.first) && consistent(children.second) &&
+                     children.first.size() + children.second.size() == a.size() + b.size();
+                // Keep trees small: carry whichever children stay under 64 nodes
+                a = children.first.size() < 64 ? children.first.copyTo(current) : a;
+                b = children.second.size() < 64 ? children.second.copyTo(current) : b;
+                next.reset();
+            }
+            print_status("SubtreeCrossover<LinearTree>", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("SubtreeCrossover<LinearTree>", false, e.what()); all_ok=false; }
+
+        // Block evaluator matches row-by-row arithmetic across block boundaries
+        try {
+            OpcodeTable opcodes; TreeArena arena;
+            ga::GpDataset data; data.rows = 1000; data.columns.assign(2, std::vector<double>(data.rows));
+            for (size_t r = 0; r < data.rows; ++r) { data.columns[0][r] = 0.01 * r; data.columns[1][r] = 1.0 - 0.003 * r; }
+            ga::GpEvaluator eval(opcodes);
+            std::vector<double> y1, y2;
+            eval.evaluate(eval.compile(LinearTree::fromTree(t1, opcodes, arena)), data, y1);
+            eval.evaluate(eval.compile(LinearTree::fromTree(t2, opcodes, arena)), data, y2);
+            bool ok = y1.size() == data.rows;
+            std::vector<double> target(data.rows);
+            for (size_t r = 0; r < data.rows && ok; ++r) {
+                double x0 = data.columns[0][r], x1 = data.columns[1][r];
+                ok = std::fabs(y1[r] - (x0 + x1 * 2)) < 1e-12 && std::fabs(y2[r] - std::sin(x0 - x1)) < 1e-12;
+                target[r] = y1[r] + 1.0;
+            }
+            ok = ok && std::fabs(eval.meanSquaredError(eval.compile(LinearTree::fromTree(t1, opcodes, arena)), data, target) - 1.0) < 1e-12;
+            print_status("GpEvaluator block evaluation", ok); if(!ok) all_ok=false;
+            // Semantic cache: a crossover child only recomputes its root path
+            {
+                ga::GpSemanticCache cache;
+                TreeArena parents, kids;
+                LinearTree a = LinearTree::fromTree(t1, opcodes, parents), b = LinearTree::fromTree(t2, opcodes, parents);
+                std::vector<double> ya, yb, yc, ref;
+                eval.evaluate(a, data, cache, ya); eval.evaluate(b, data, cache, yb);
+                SubtreeCrossover op(4);
+                bool cache_ok = ya == y1 && yb == y2;
+                for (int r = 0; r < 20 && cache_ok; ++r) {
+                    auto children = op.crossover(a, b, kids);
+                    size_t missesBefore = cache.misses();
+                    eval.evaluate(children.first, data, cache, yc);
+                    eval.evaluate(eval.compile(children.first), data, ref);
+                    cache_ok = yc == ref && cache.misses() - missesBefore < children.first.depth();
+                    kids.reset();
+                }
+                ga::GpSemanticCache tiny(data.rows * sizeof(double));
+                eval.evaluate(a, data, tiny, ya);
+                cache_ok = cache_ok && ya == y1 && tiny.bytes() <= data.rows * sizeof(double);
+                print_status("GpSemanticCache reuse", cache_ok); if(!cache_ok) all_ok=false;
+            }
+            TreeNode bad("pow"); bad.children = {new TreeNode("x0"), new TreeNode("x1")};
+            try { eval.compile(LinearTree::fromTree(&bad, opcodes, arena)); print_status("GpEvaluator rejects unknown symbol", false); all_ok=false; }
+            catch(const std::invalid_argument&){ print_status("GpEvaluator rejects unknown symbol", true); }
+        } catch(const std::exception& e){ print_status("GpEvaluator block evaluation", false, e.what()); all_ok=false; }
+        delete t1; delete t2;
+    }
+
+    // Non-dominated sorting agrees with the pairwise definition; NSGA-II returns a Pareto set
+    {
+        std::mt19937 rng(21);
+        std::uniform_int_distribution<int> coarse(0, 6); // coarse values force ties and duplicates
+        bool ok = true;
+        for (size_t m = 1; m <= 4 && ok; ++m) {
+            const size_t n = 300;
+            std::vector<double> obj(n * m);
+            for (double& v : obj) v = coarse(rng);
+            std::vector<int> rank;
+            ga::nonDominatedSort(obj.data(), n, m, rank);
+            auto dom = [&](size_t a, size_t b){ bool strict=false; for(size_t k=0;k<m;++k){ if(obj[a*m+k]<obj[b*m+k]) return false; if(obj[a*m+k]>obj[b*m+k]) strict=true; } return strict; };
+            for (size_t i = 0; i < n && ok; ++i) {
+                int expected = 0; // 1 + highest rank among dominators
+                for (size_t j = 0; j < n; ++j) if (dom(j, i)) expected = std::max(expected, rank[j] + 1);
+                ok = rank[i] == expected;
+            }
+        }
+        print_status("nonDominatedSort matches pairwise ranks (m=1..4)", ok); if(!ok) all_ok=false;
+
+        try {
+            ga::Config cfg; cfg.populationSize = 60; cfg.generations = 40; cfg.dimension = 3; cfg.seed = 5;
+            cfg.bounds = {-1.0, 3.0};
+            ga::NSGA2 nsga(cfg);
+            auto res = nsga.run([](const std::vector<double>& x){
+                double a = 0, b = 0; for (double v : x) { a += v*v; b += (v-2)*(v-2); }
+                return std::vector<double>{-a, -b};
+            });
+            bool front_ok = res.front.size() > 5 && res.evaluations == 60u * 41u;
+            for (auto& p : res.front) for (auto& q : res.front) {
+                bool qd = q.objectives[0] >= p.objectives[0] && q.objectives[1] >= p.objectives[1] && q.objectives != p.objectives;
+                if (qd) front_ok = false;
+            }
+            print_status("NSGA2 Pareto front", front_ok, std::to_string(res.front.size()) + " points"); if(!front_ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("NSGA2 Pareto front", false, e.what()); all_ok=false; }
+        try {
+            // Threaded scoring reproduces the serial run; the budget stops it early
+            ga::Config cfg; cfg.populationSize = 50; cfg.generations = 30; cfg.dimension = 4; cfg.seed = 8;
+            auto objectives = [](const std::vector<double>& x){
+                double a = 0, b = 0; for (double v : x) { a += v*v; b += (v-1)*(v-1); }
+                return std::vector<double>{-a, -b};
+            };
+            ga::NSGA2 serial(cfg);
+            auto a = serial.run(objectives);
+            cfg.threads = 3;
+            ga::NSGA2 threaded(cfg);
+            auto b = threaded.run(objectives);
+            bool ok = a.frontSizeHistory == b.frontSizeHistory && a.front.size() == b.front.size();
+            for (size_t i = 0; ok && i < a.front.size(); ++i) ok = a.front[i].genes == b.front[i].genes;
+            cfg.maxEvaluations = 420;
+            ga::NSGA2 budgeted(cfg);
+            auto c = budgeted.run(objectives);
+            ok = ok && c.evaluations == 450u && c.frontSizeHistory.size() == 9u;
+            print_status("NSGA2 threads and evaluation budget", ok, std::to_string(c.evaluations) + " evaluations"); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("NSGA2 threads and evaluation budget", false, e.what()); all_ok=false; }
+    }
+
+    // CMA-ES: full covariance on Rosenbrock, sep-CMA in high dimension, IPOP restarts
+    {
+        try {
+            ga::Config cfg; cfg.dimension = 10; cfg.generations = 3000; cfg.seed = 11; cfg.bounds = {-5.0, 5.0};
+            ga::CMAES cma(cfg);
+            auto res = cma.run([](const std::vector<double>& x){
+                double s = 0; for (size_t i = 0; i + 1 < x.size(); ++i) s += 100*(x[i+1]-x[i]*x[i])*(x[i+1]-x[i]*x[i]) + (1-x[i])*(1-x[i]);
+                return -s;
+            });
+            bool ok = res.bestFitness > -1e-8 && res.bestHistory.size() == res.avgHistory.size();
+            print_status("CMAES<Full> Rosenbrock", ok, std::to_string(-res.bestFitness) + " after " + std::to_string(cma.evaluations()) + " evaluations"); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("CMAES<Full> Rosenbrock", false, e.what()); all_ok=false; }
+        try {
+            ga::Config cfg; cfg.dimension = 1000; cfg.generations = 4000; cfg.seed = 12; cfg.bounds = {-5.0, 5.0};
+            ga::CmaesOptions opt; opt.covariance = ga::CmaesOptions::Covariance::Separable;
+            ga::CMAES cma(cfg, opt);
+            auto res = cma.run([](const std::vector<double>& x){ double s=0; for (size_t i=0;i<x.size();++i) s += (1.0 + i % 10) * x[i]*x[i]; return -s; });
+            bool ok = -res.bestFitness < 1e-3 * -res.bestHistory.front();
+            print_status("CMAES<Separable> 1000-D ellipsoid", ok, std::to_string(-res.bestHistory.front()) + " -> " + std::to_string(-res.bestFitness)); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("CMAES<Separable> 1000-D ellipsoid", false, e.what()); all_ok=false; }
+        try {
+            ga::Config cfg; cfg.dimension = 5; cfg.generations = 2000; cfg.seed = 13;
+            ga::CmaesOptions opt; opt.restarts = 6;
+            ga::CMAES cma(cfg, opt);
+            auto res = cma.run([](const std::vector<double>& x){
+                double s = 10.0 * x.size(); for (double v : x) s += v*v - 10*std::cos(2*M_PI*v); return -s;
+            });
+            bool ok = cma.restartsUsed() > 0 && res.bestFitness > -2.0;
+            print_status("CMAES IPOP Rastrigin", ok, std::to_string(cma.restartsUsed()) + " restarts, f=" + std::to_string(-res.bestFitness)); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("CMAES IPOP Rastrigin", false, e.what()); all_ok=false; }
+    }
+
+    // Differential evolution: every strategy converges; threads and batching do not change the run
+    {
+        auto rastrigin = [](const std::vector<double>& x){ double s = 10.0 * x.size(); for (double v : x) s += v*v - 10*std::cos(2*M_PI*v); return -s; };
+        const std::pair<const char*, ga::DeOptions::Strategy> strategies[] = {
+            {"rand/1", ga::DeOptions::Strategy::Rand1}, {"best/1", ga::DeOptions::Strategy::Best1},
+            {"current-to-pbest/1", ga::DeOptions::Strategy::CurrentToPBest1}};
+        for (auto& st : strategies) {
+            std::string name = std::string("DifferentialEvolution ") + st.first;
+            try {
+                ga::Config cfg; cfg.populationSize = 50; cfg.generations = 600; cfg.dimension = 10; cfg.seed = 21; cfg.crossoverRate = 0.9;
+                ga::DeOptions opt; opt.strategy = st.second;
+                opt.adaptation = st.second == ga::DeOptions::Strategy::CurrentToPBest1 ? ga::DeOptions::Adaptation::SHADE : ga::DeOptions::Adaptation::None;
+                if (st.second == ga::DeOptions::Strategy::Rand1) cfg.crossoverRate = 0.1; // separable problem
+                if (st.second == ga::DeOptions::Strategy::Best1) cfg.crossoverRate = 0.5;  // high CR collapses best/1
+                ga::DifferentialEvolution de(cfg, opt);
+                // best/1 is greedy and stalls on Rastrigin; give it a sphere
+                auto sphere = [](const std::vector<double>& x){ double s=0; for (double v : x) s += v*v; return -s; };
+                auto res = st.second == ga::DeOptions::Strategy::Best1 ? de.run(sphere) : de.run(rastrigin);
+                bool ok = res.bestFitness > -1e-3 && de.evaluations() == 50u * 601u && res.bestHistory.size() == 601u;
+                print_status(name, ok, "f=" + std::to_string(-res.bestFitness)); if(!ok) all_ok=false;
+            } catch(const std::exception& e){ print_status(name, false, e.what()); all_ok=false; }
+        }
+        try {
+            ga::Config cfg; cfg.populationSize = 40; cfg.generations = 50; cfg.dimension = 6; cfg.seed = 22;
+            ga::DeOptions opt; opt.adaptation = ga::DeOptions::Adaptation::JADE;
+            ga::DifferentialEvolution serial(cfg, opt);
+            auto a = serial.run(rastrigin);
+            cfg.threads = 4;
+            ga::DifferentialEvolution threaded(cfg, opt);
+            auto b = threaded.run(rastrigin);
+            cfg.threads = 1;
+            ga::DifferentialEvolution batched(cfg, opt);
+            size_t batches = 0;
+            auto c = batched.run([&](const double* genes, size_t count, size_t dim, double* out){
+                ++batches;
+                std::vector<double> x(dim);
+                for (size_t i = 0; i < count; ++i) { std::copy(genes + i*dim, genes + (i+1)*dim, x.begin()); out[i] = rastrigin(x); }
+            });
+            bool ok = a.bestHistory == b.bestHistory && a.bestHistory == c.bestHistory && batches == 51u;
+            print_status("DifferentialEvolution threaded/batched match serial", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("DifferentialEvolution threaded/batched match serial", false, e.what()); all_ok=false; }
+    }
+
+    // EDAs: every algorithm solves OneMax; samples do not depend on the thread
+    // count, and the packed sample bits follow the marginals
+    {
+        try {
+            bool ok = true;
+            std::string detail;
+            const size_t bits = 300;
+            auto onemax = [](const uint64_t* words, size_t length) {
+                size_t ones = 0;
+                for (size_t w = 0; w < (length + 63) / 64; ++w) ones += __builtin_popcountll(words[w]);
+                return static_cast<double>(ones);
+            };
+            for (auto algorithm : {ga::EdaOptions::Algorithm::UMDA, ga::EdaOptions::Algorithm::PBIL, ga::EdaOptions::Algorithm::CompactGA}) {
+                ga::Config cfg; cfg.dimension = bits; cfg.populationSize = 100; cfg.generations = 150; cfg.seed = 3;
+                ga::EdaOptions opts; opts.algorithm = algorithm; opts.learningRate = 0.2;
+                ga::EDA serial(cfg, opts);
+                auto a = serial.run(ga::BitFitness(onemax));
+                cfg.threads = 4;
+                ga::EDA parallel(cfg, opts);
+                auto b = parallel.run(ga::BitFitness(onemax));
+                const double found = std::accumulate(a.bestGenes.begin(), a.bestGenes.end(), 0.0);
+                ok = ok && a.bestHistory == b.bestHistory && a.bestFitness >= 0.97 * bits && found == a.bestFitness
+                        && a.evaluations == 151 * 100 && a.bestHistory.size() == 151;
+                detail += std::to_string((int)a.bestFitness) + " ";
+            }
+            // Without generations only the initial samples are drawn, from p = 0.5:
+            // about half the bits are set and none past L
+            ga::Config cfg; cfg.dimension = 70; cfg.populationSize = 400; cfg.generations = 0; cfg.seed = 9;
+            ga::EDA eda(cfg);
+            double ones = 0; bool tail = true;
+            auto r = eda.run(ga::BitFitness([&](const uint64_t* w, size_t l){ tail = tail && (w[1] >> 6) == 0; double c = 0; for (size_t i = 0; i < l; ++i) c += (w[i / 64] >> (i % 64)) & 1; ones += c; return c; }));
+            ok = ok && tail && std::fabs(ones / (400.0 * 70) - 0.5) < 0.02 && r.evaluations == 400;
+            // One- and two-bit strings still learn: borders only apply past L = 2
+            for (size_t length : {1, 2}) {
+                for (auto algorithm : {ga::EdaOptions::Algorithm::UMDA, ga::EdaOptions::Algorithm::PBIL, ga::EdaOptions::Algorithm::CompactGA}) {
+                    ga::Config small; small.dimension = length; small.populationSize = 20; small.generations = 100; small.seed = 5;
+                    ga::EdaOptions opts; opts.algorithm = algorithm;
+                    ga::EDA short_eda(small, opts);
+                    auto s = short_eda.run(ga::BitFitness(onemax));
+                    for (double p : short_eda.probabilities()) ok = ok && p > 0.9;
+                    ok = ok && s.bestFitness == static_cast<double>(length);
+                }
+            }
+            print_status("EDA UMDA/PBIL/cGA on OneMax", ok, detail); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("EDA UMDA/PBIL/cGA on OneMax", false, e.what()); all_ok=false; }
+    }
+
+    // GA engine: separable fitness only evaluates the terms of changed loci
+    {
+        try {
+            ga::Config cfg; cfg.populationSize = 20; cfg.dimension = 1000; cfg.generations = 100; cfg.mutationRate = 0.001; cfg.seed = 9;
+            size_t term_calls = 0;
+            auto term = [&](size_t, double v){ ++term_calls; return v*v - 10*std::cos(2*M_PI*v) + 10; };
+            ga::SeparableFitness sep{term, [](double s){ return -s; }};
+            ga::GeneticAlgorithm incremental(cfg);
+            auto a = incremental.run(sep);
+            size_t incremental_calls = term_calls; term_calls = 0;
+            ga::GeneticAlgorithm whole(cfg);
+            auto b = whole.run([&](const std::vector<double>& x){ double s = 0; for (size_t i = 0; i < x.size(); ++i) s += term(i, x[i]); return -s; });
+            bool same = a.bestHistory.size() == b.bestHistory.size();
+            for (size_t g = 0; same && g < a.bestHistory.size(); ++g) same = std::fabs(a.bestHistory[g] - b.bestHistory[g]) <= 1e-9 * std::fabs(b.bestHistory[g]);
+            bool ok = same && incremental_calls * 20 < term_calls;
+            print_status("GeneticAlgorithm SeparableFitness", ok, std::to_string(incremental_calls) + " term calls vs " + std::to_string(term_calls)); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("GeneticAlgorithm SeparableFitness", false, e.what()); all_ok=false; }
+    }
+
+    // GA engine: the fused offspring pass keeps children in bounds, is seeded, and
+    // rejects a mutation rate outside [0, 1] before the run starts
+    {
+        try {
+            ga::Config cfg; cfg.populationSize = 40; cfg.dimension = 20; cfg.generations = 30; cfg.seed = 12;
+            cfg.bounds = {-1.0, 1.0}; cfg.mutationRate = 0.3; cfg.eliteRatio = 0.1;
+            // Maximising the distance from the origin pushes line recombination past the bounds
+            auto far = [](const std::vector<double>& x){ double s = 0; for (double v : x) s += v * v; return s; };
+            auto run = [&](std::unique_ptr<MutationOperator> mutation){
+                ga::GeneticAlgorithm alg(cfg);
+                alg.setCrossoverOperator(std::make_unique<LineRecombination>(0.5, 4));
+                alg.setMutationOperator(std::move(mutation));
+                return alg.run(far);
+            };
+            auto a = run(std::make_unique<GaussianMutation>(5)), b = run(std::make_unique<GaussianMutation>(5));
+            auto u = run(std::make_unique<UniformMutation>(5));
+            bool ok = a.bestHistory == b.bestHistory && a.bestGenes == b.bestGenes;
+            for (const auto* r : {&a, &u}) for (double v : r->bestGenes) ok = ok && v >= -1.0 && v <= 1.0;
+            ok = ok && a.bestFitness > a.bestHistory.front();
+            bool rejected = false;
+            cfg.mutationRate = 1.5;
+            try { ga::GeneticAlgorithm bad(cfg); bad.run(far); } catch(const std::invalid_argument&){ rejected = true; }
+            ok = ok && rejected;
+            print_status("GeneticAlgorithm fused offspring pass", ok, "best " + std::to_string(a.bestFitness)); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("GeneticAlgorithm fused offspring pass", false, e.what()); all_ok=false; }
+    }
+
+    // Per-dimension bounds: every repair strategy lands inside the box and leaves
+    // in-bounds genes alone; engines keep each gene within its own interval
+    {
+        try {
+            using BH = ga::BoundHandling;
+            bool ok = std::fabs(ga::repairGene(BH::Reflect, 1.3, 0.0, 1.0, 0.0, 0.0) - 0.7) < 1e-12
+                    && std::fabs(ga::repairGene(BH::Reflect, -0.25, 0.0, 1.0, 0.0, 0.0) - 0.25) < 1e-12
+                    && std::fabs(ga::repairGene(BH::Reflect, 2.5, 0.0, 1.0, 0.0, 0.0) - 0.5) < 1e-12
+                    && std::fabs(ga::repairGene(BH::Wrap, 1.25, 0.0, 1.0, 0.0, 0.0) - 0.25) < 1e-12
+                    && std::fabs(ga::repairGene(BH::Wrap, -0.25, 0.0, 1.0, 0.0, 0.0) - 0.75) < 1e-12
+                    && ga::repairGene(BH::MidpointToParent, 1.5, 0.0, 1.0, 0.4, 0.0) == 0.7
+                    && ga::repairGene(BH::Clamp, -3.0, 0.0, 1.0, 0.0, 0.0) == 0.0
+                    && ga::repairGene(BH::Resample, 5.0, 0.0, 2.0, 0.0, 0.25) == 0.5;
+            for (BH h : {BH::Clamp, BH::Reflect, BH::Wrap, BH::Resample, BH::MidpointToParent}) {
+                ok = ok && ga::repairGene(h, 0.3, 0.0, 1.0, 0.9, 0.5) == 0.3;
+                for (double x : {-7.3, -1.0, 1.0001, 4.6, 1e6}) {
+                    const double r = ga::repairGene(h, x, -1.0, 1.0, 0.2, 0.999);
+                    ok = ok && r >= -1.0 && r <= 1.0;
+                }
+            }
+            ga::Config cfg; cfg.dimension = 3;
+            std::vector<double> lo, hi;
+            int rejected = 0;
+            cfg.lower = {0, 0}; cfg.upper = {1, 1, 1};
+            try { ga::resolveBounds(cfg, lo, hi); } catch(const std::invalid_argument&){ rejected++; }
+            cfg.lower = {0, 2, 0};
+            try { ga::resolveBounds(cfg, lo, hi); } catch(const std::invalid_argument&){ rejected++; }
+            cfg.lower = {0, 1, 0};
+            ga::resolveBounds(cfg, lo, hi);
+            ok = ok && rejected == 2 && lo == cfg.lower && hi == cfg.upper;
+            print_status("repairGene strategies", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("repairGene strategies", false, e.what()); all_ok=false; }
+        try {
+            ga::Config cfg; cfg.populationSize = 30; cfg.dimension = 8; cfg.generations = 25; cfg.seed = 9;
+            cfg.mutationRate = 0.3; cfg.eliteRatio = 0.1;
+            for (int j = 0; j < cfg.dimension; ++j) { cfg.lower.push_back(0.5 * j); cfg.upper.push_back(0.5 * j + 0.25 * (j + 1)); }
+            auto far = [](const std::vector<double>& x){ double s = 0; for (double v : x) s += v * v; return s; };
+            auto inside = [&](const std::vector<double>& g){
+                bool in = g.size() == cfg.lower.size();
+                for (size_t j = 0; in && j < g.size(); ++j) in = g[j] >= cfg.lower[j] && g[j] <= cfg.upper[j];
+                return in;
+            };
+            bool ok = true;
+            for (auto h : {ga::BoundHandling::Clamp, ga::BoundHandling::Reflect, ga::BoundHandling::Wrap,
+                           ga::BoundHandling::Resample, ga::BoundHandling::MidpointToParent}) {
+                cfg.boundHandling = h;
+                ga::GeneticAlgorithm alg(cfg);
+                alg.setCrossoverOperator(std::make_unique<LineRecombination>(0.5, 4));
+                ok = ok && inside(alg.run(far).bestGenes);
+            }
+            ga::DifferentialEvolution de(cfg);
+            ok = ok && inside(de.run(far).bestGenes);
+            ga::CMAES es(cfg);
+            ok = ok && inside(es.run(far).bestGenes);
+            print_status("Per-dimension bounds", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("Per-dimension bounds", false, e.what()); all_ok=false; }
+    }
+
+    // Continuous local search: Nelder-Mead and coordinate search polish elites
+    // within the evaluation budget, identically for any thread count
+    {
+        auto sphere = [](const std::vector<double>& x){ double s=0; for(double v:x) s+=(v-1.0)*(v-1.0); return -s; };
+        try {
+            std::vector<double> x = {-1.2, 1.0}, lo(2, -5.0), hi(2, 5.0);
+            auto rosen = [](const std::vector<double>& v){ return -(100*std::pow(v[1]-v[0]*v[0], 2) + std::pow(1-v[0], 2)); };
+            size_t budget = 2000;
+            double f = ga::nelderMead(rosen, x, rosen(x), lo, hi, 0.1, budget);
+            bool ok = f > -1e-8 && std::fabs(x[0]-1) < 1e-3 && std::fabs(x[1]-1) < 1e-3 && f == rosen(x);
+            print_status("nelderMead Rosenbrock", ok, std::to_string(2000 - budget) + " evaluations"); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("nelderMead Rosenbrock", false, e.what()); all_ok=false; }
+        try {
+            ga::Config cfg; cfg.populationSize = 30; cfg.dimension = 10; cfg.generations = 1000; cfg.seed = 21; cfg.maxEvaluations = 6000;
+            ga::GeneticAlgorithm plain(cfg);
+            auto a = plain.run(sphere);
+            ga::LocalSearchOptions ls; ls.interval = 5; ls.elites = 2; ls.evaluations = 200;
+            bool ok = a.evaluations >= cfg.maxEvaluations && a.evaluations < cfg.maxEvaluations + cfg.populationSize;
+            for (auto method : {ga::LocalSearchOptions::Method::Coordinate, ga::LocalSearchOptions::Method::NelderMead}) {
+                ls.method = method;
+                ga::GeneticAlgorithm serial(cfg); serial.setLocalSearch(ls);
+                auto b = serial.run(sphere);
+                cfg.threads = 2;
+                ga::GeneticAlgorithm threaded(cfg); threaded.setLocalSearch(ls);
+                auto c = threaded.run(sphere);
+                cfg.threads = 1;
+                ok = ok && b.bestFitness > 1e3 * a.bestFitness && b.bestHistory == c.bestHistory && b.evaluations == c.evaluations
+                        && b.evaluations < cfg.maxEvaluations + cfg.populationSize;
+            }
+            ls.method = ga::LocalSearchOptions::Method::Coordinate;
+            ls.inheritance = ga::LocalSearchOptions::Inheritance::Baldwinian;
+            ga::GeneticAlgorithm baldwin(cfg); baldwin.setLocalSearch(ls);
+            auto d = baldwin.run(sphere);
+            ok = ok && d.bestFitness == sphere(d.bestGenes) && d.bestFitness > a.bestFitness;
+            // Baldwinian fitness survives the periodic re-summation of separable
+            // terms: a separable run follows the plain one through refinements
+            // that land on re-summation generations
+            cfg.maxEvaluations = 0; cfg.generations = 128;
+            ls.interval = 64; ls.evaluations = 50;
+            ga::SeparableFitness sep{[](size_t, double v){ return (v-1.0)*(v-1.0); }, [](double s){ return -s; }};
+            ga::GeneticAlgorithm baldwinSeparable(cfg); baldwinSeparable.setLocalSearch(ls);
+            auto e = baldwinSeparable.run(sep);
+            ga::GeneticAlgorithm baldwinWhole(cfg); baldwinWhole.setLocalSearch(ls);
+            auto w = baldwinWhole.run(sphere);
+            bool same = e.bestHistory.size() == w.bestHistory.size() && std::is_sorted(e.bestHistory.begin(), e.bestHistory.end());
+            for (size_t g = 0; same && g < e.bestHistory.size(); ++g) same = std::fabs(e.bestHistory[g] - w.bestHistory[g]) <= 1e-9 * std::fabs(w.bestHistory[g]);
+            ok = ok && same && e.bestFitness == e.bestHistory.back();
+            print_status("GeneticAlgorithm local search", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("GeneticAlgorithm local search", false, e.what()); all_ok=false; }
+    }
+
+    // Duplicate genomes: hashing finds exact and quantised copies; skipping
+    // exact duplicates saves evaluations without changing the run
+    {
+        try {
+            ga::GenomeHashSet exact, coarse(0.01);
+            std::vector<double> a = {0.0, 1.5, -2.0}, b = {-0.0, 1.5, -2.0}, c = {0.001, 1.502, -2.003};
+            exact.reset(4, 3); coarse.reset(4, 3);
+            exact.insert(a.data(), exact.hash(a.data()), 7);
+            coarse.insert(a.data(), coarse.hash(a.data()), 7);
+            bool ok = exact.find(b.data(), exact.hash(b.data())) == 7 && exact.find(c.data(), exact.hash(c.data())) == ga::GenomeHashSet::npos
+                   && coarse.find(c.data(), coarse.hash(c.data())) == 7;
+            std::vector<std::vector<double>> many(100, std::vector<double>(3));
+            for (size_t i = 0; i < many.size(); ++i) { many[i][0] = i; exact.insert(many[i].data(), exact.hash(many[i].data()), i); }
+            for (size_t i = 0; i < many.size() && ok; ++i) ok = exact.find(many[i].data(), exact.hash(many[i].data())) == i;
+            print_status("GenomeHashSet", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("GenomeHashSet", false, e.what()); all_ok=false; }
+        try {
+            auto sphere = [](const std::vector<double>& x){ double s=0; for(double v:x) s+=v*v; return -s; };
+            ga::Config cfg; cfg.populationSize = 40; cfg.dimension = 5; cfg.generations = 60; cfg.mutationRate = 0.05; cfg.seed = 12;
+            ga::GeneticAlgorithm plain(cfg);
+            auto a = plain.run(sphere);
+            ga::GeneticAlgorithm skipping(cfg);
+            ga::DuplicateOptions dup; dup.policy = ga::DuplicateOptions::Policy::Skip;
+            skipping.setDuplicatePolicy(dup);
+            auto b = skipping.run(sphere);
+            dup.policy = ga::DuplicateOptions::Policy::Remutate;
+            ga::GeneticAlgorithm remutating(cfg);
+            remutating.setDuplicatePolicy(dup);
+            auto c = remutating.run(sphere);
+            bool ok = a.bestHistory == b.bestHistory && b.evaluationsSaved > 0 && b.duplicates == b.evaluationsSaved
+                   && b.evaluations + b.evaluationsSaved == a.evaluations && c.evaluationsSaved < c.duplicates;
+            print_status("GeneticAlgorithm duplicate elimination", ok, std::to_string(b.evaluationsSaved) + " of " + std::to_string(a.evaluations) + " evaluations saved"); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("GeneticAlgorithm duplicate elimination", false, e.what()); all_ok=false; }
+    }
+
+    // Niching: the grid finds exactly the pairs a brute-force scan finds, in
+    // few distance checks, and the result does not depend on the thread count
+    {
+        try {
+            bool ok = true;
+            std::string detail;
+            for (size_t dim : {2, 10}) {
+                std::mt19937 rng(21); std::uniform_real_distribution<double> u(-50.0, 50.0); std::normal_distribution<double> jitter(0.0, 0.3);
+                const size_t n = 2000;
+                std::vector<double> genes(n * dim), f(n);
+                for (size_t i = 0; i < n; ++i) {
+                    const double centre = std::floor(u(rng) / 10.0) * 10.0; // clusters along the diagonal
+                    for (size_t d = 0; d < dim; ++d) genes[i * dim + d] = centre + jitter(rng);
+                    f[i] = u(rng);
+                }
+                const double radius = 1.5;
+                auto dist = [&](size_t i, size_t j){ double s = 0; for (size_t d = 0; d < dim; ++d) { double t = genes[i*dim+d] - genes[j*dim+d]; s += t*t; } return std::sqrt(s); };
+                // Brute-force references
+                const double base = std::min(0.0, *std::min_element(f.begin(), f.end()));
+                std::vector<double> shared(n), cleared(f);
+                for (size_t i = 0; i < n; ++i) {
+                    double m = 1.0;
+                    for (size_t j = 0; j < n; ++j) if (j != i && dist(i, j) < radius) m += 1.0 - dist(i, j) / radius;
+                    shared[i] = base + (f[i] - base) / m;
+                }
+                std::vector<size_t> order(n); std::iota(order.begin(), order.end(), 0);
+                std::sort(order.begin(), order.end(), [&](size_t a, size_t b){ return f[a] > f[b]; });
+                std::vector<char> gone(n, 0);
+                for (size_t k = 0; k < n; ++k) {
+                    size_t i = order[k]; if (gone[i]) continue; size_t winners = 1;
+                    for (size_t l = k + 1; l < n; ++l) { size_t j = order[l]; if (gone[j] || dist(i, j) >= radius) continue; if (winners < 2) ++winners; else gone[j] = 1; }
+                }
+                for (size_t i = 0; i < n; ++i) if (gone[i]) cleared[i] = f[order.back()];
+
+                ga::NichingOptions opts; opts.radius = radius; opts.method = ga::NichingOptions::Method::Sharing;
+                ga::NichingStage sharing(opts);
+                opts.threads = 4;
+                ga::NichingStage sharing4(opts);
+                opts.method = ga::NichingOptions::Method::Clearing; opts.capacity = 2;
+                ga::NichingStage clearing4(opts);
+                std::vector<double> s1(n), s4(n), c4(n);
+                sharing.apply(genes.data(), n, dim, f.data(), s1.data());
+                sharing4.apply(genes.data(), n, dim, f.data(), s4.data());
+                clearing4.apply(genes.data(), n, dim, f.data(), c4.data());
+                for (size_t i = 0; i < n; ++i) ok = ok && std::fabs(s1[i] - shared[i]) < 1e-9 && s1[i] == s4[i] && c4[i] == cleared[i];
+                ok = ok && sharing.distanceChecks() < n * n / 10;
+                detail += std::to_string(dim) + "-D: " + std::to_string(sharing.distanceChecks()) + " checks ";
+            }
+            bool threw = false;
+            try { ga::NichingOptions bad; bad.radius = 0.0; ga::NichingStage s(bad); } catch (const std::invalid_argument&) { threw = true; }
+            ok = ok && threw;
+            print_status("NichingStage sharing/clearing", ok, detail); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("NichingStage sharing/clearing", false, e.what()); all_ok=false; }
+    }
+
+    // Novelty search: the incremental VP-tree archive answers kNN exactly through
+    // insertions and evictions; the engine keeps the archive bounded
+    {
+        try {
+            std::mt19937 rng(8); std::uniform_real_distribution<double> u(-1.0, 1.0);
+            const size_t dim = 4;
+            ga::VpForest forest(dim);
+            std::vector<std::vector<double>> pts;
+            std::vector<size_t> live;
+            auto add = [&](){ std::vector<double> p(dim); for (double& v : p) v = u(rng); size_t id = forest.insert(p.data()); if (id >= pts.size()) pts.resize(id + 1); pts[id] = p; live.push_back(id); };
+            for (int i = 0; i < 3000; ++i) add();
+            std::shuffle(live.begin(), live.end(), rng);
+            for (int i = 0; i < 2000; ++i) { forest.erase(live.back()); live.pop_back(); }
+            for (int i = 0; i < 500; ++i) add();
+            bool ok = forest.size() == live.size() && pts.size() <= 3000;
+            std::vector<ga::Neighbour> heap;
+            for (int q = 0; q < 100 && ok; ++q) {
+                std::vector<double> x(dim); for (double& v : x) v = u(rng);
+                heap.clear(); forest.search(x.data(), 10, heap);
+                std::vector<double> got, want;
+                for (auto& nb : heap) got.push_back(nb.distance);
+                for (size_t id : live) { double s = 0; for (size_t d = 0; d < dim; ++d) s += (x[d]-pts[id][d])*(x[d]-pts[id][d]); want.push_back(std::sqrt(s)); }
+                std::sort(got.begin(), got.end()); std::sort(want.begin(), want.end()); want.resize(10);
+                for (size_t i = 0; i < 10 && ok; ++i) ok = got.size() == 10 && std::fabs(got[i] - want[i]) < 1e-12;
+            }
+            print_status("VpForest exact kNN", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("VpForest exact kNN", false, e.what()); all_ok=false; }
+        try {
+            auto sphere = [](const std::vector<double>& x){ double s=0; for(double v:x) s+=v*v; return -s; };
+            auto position = [](const std::vector<double>& x){ return std::vector<double>{x[0], x[1]}; };
+            ga::Config cfg; cfg.populationSize = 60; cfg.dimension = 5; cfg.generations = 40; cfg.mutationRate = 0.2; cfg.seed = 5;
+            ga::NoveltyOptions opts; opts.capacity = 50; opts.eviction = ga::NoveltyOptions::Eviction::Random;
+            ga::NoveltySearch serial(cfg, opts);
+            auto a = serial.run(sphere, position);
+            cfg.threads = 4;
+            ga::NoveltySearch parallel(cfg, opts);
+            auto b = parallel.run(sphere, position);
+            bool ok = a.bestHistory == b.bestHistory && serial.archive().size() == 50 && parallel.archive().size() == 50
+                   && a.evaluations == 60 + 40 * (60 - 3) && serial.novelty().size() == 60;
+            print_status("NoveltySearch bounded archive", ok, "best objective " + std::to_string(a.bestFitness)); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("NoveltySearch bounded archive", false, e.what()); all_ok=false; }
+    }
+
+    // GA engine: the generation loop must not allocate once buffers are sized
+    {
+        auto sphere = [](const std::vector<double>& x){ double s=0; for(double v:x) s+=v*v; return 1.0/(1.0+s); };
+        auto allocations_for = [&](int generations){
+            ga::Config cfg; cfg.populationSize = 31; cfg.dimension = 8; cfg.generations = generations; cfg.seed = 7;
+            ga::GeneticAlgorithm alg(cfg);
+            size_t before = g_allocations;
+            alg.run(sphere);
+            return g_allocations - before;
+        };
+        try { size_t shortRun = allocations_for(2), longRun = allocations_for(40); bool ok = shortRun == longRun; print_status("GeneticAlgorithm steady-state allocations", ok, std::to_string(shortRun) + " vs " + std::to_string(longRun)); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("GeneticAlgorithm steady-state allocations", false, e.what()); all_ok=false; }
+    }
+
     // Mutation real-valued
     {
         auto x = make_real(10);
@@ -127,6 +888,78 @@ int main(){
         try { UniformMutation op; op.mutate(x, 0.5, lo, hi); print_status("UniformMutation<Real>", x.size()==10); } catch(const std::exception& e){ print_status("UniformMutation<Real>", false, e.what()); all_ok=false; }
     }
 
+    // Population-level mutation: Box-Muller normals have unit moments, and one
+    // mutateBatch call mutates about pm of a whole matrix within the bounds,
+    // reproducibly, after validation at prepareBatch
+    {
+        try {
+            double sum = 0, sq = 0, quad = 0, worst = 0;
+            const size_t pairs = 100000;
+            for (uint32_t i = 0; i < pairs; ++i) {
+                const double u1 = (recombination_kernels::hash32(2 * i) + 0.5) / 4294967296.0;
+                const double u2 = (recombination_kernels::hash32(2 * i + 1) + 0.5) / 4294967296.0;
+                double z0, z1;
+                recombination_kernels::normalPair(u1, u2, z0, z1);
+                const double r = std::sqrt(-2 * std::log(u1)), angle = 2 * M_PI * (u2 - 0.5);
+                worst = std::max({worst, std::fabs(z0 - r * std::cos(angle)), std::fabs(z1 - r * std::sin(angle))});
+                for (double z : {z0, z1}) { sum += z; sq += z * z; quad += z * z * z * z; }
+            }
+            const double n = 2.0 * pairs;
+            bool ok = worst < 1e-9 && std::fabs(sum / n) < 0.01 && std::fabs(sq / n - 1) < 0.02 && std::fabs(quad / n - 3) < 0.1;
+            print_status("recombination_kernels::normalPair", ok, "max abs err " + std::to_string(worst * 1e12) + "e-12"); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("recombination_kernels::normalPair", false, e.what()); all_ok=false; }
+        try {
+            // Row sub-streams must not repeat past 2^32 uniforms nor share values with each other
+            using recombination_kernels::streamKey;
+            const uint64_t wrap = uint64_t(1) << 32;
+            bool ok = true;
+            for (uint64_t r = 0; r < 64; ++r) ok = ok && streamKey(7, r) != streamKey(7, r + wrap) && streamKey(7, r) != streamKey(7, r + 1);
+            std::vector<double> s0(4096), s1(4096);
+            recombination_kernels::fillUniform(s0.data(), s0.size(), 0, 11, streamKey(7, 0));
+            recombination_kernels::fillUniform(s1.data(), s1.size(), 0, 11, streamKey(7, 1));
+            std::sort(s0.begin(), s0.end());
+            for (double v : s1) ok = ok && !std::binary_search(s0.begin(), s0.end(), v);
+            print_status("recombination_kernels::streamKey", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("recombination_kernels::streamKey", false, e.what()); all_ok=false; }
+        const size_t rows = 2000, dim = 25;
+        std::vector<double> lo(dim, -0.05), hi(dim, 1.0);
+        auto changed = [&](const std::vector<double>& m, size_t& count){
+            bool inside = true;
+            count = 0;
+            for (double v : m) { count += v != 0.0; inside = inside && v >= -0.05 && v <= 1.0; }
+            return inside;
+        };
+        try {
+            GaussianMutation a(31), b(31);
+            std::vector<double> ma(rows * dim, 0.0), mb(rows * dim, 0.0);
+            int rejected = 0;
+            try { a.mutateBatch(ma.data(), rows, dim); } catch(const MutationOperator::InvalidParameterException&){ rejected++; }
+            try { a.prepareBatch(0.2, 0.0, lo, hi); } catch(const MutationOperator::InvalidParameterException&){ rejected++; }
+            a.prepareBatch(0.2, 0.1, lo, hi); b.prepareBatch(0.2, 0.1, lo, hi);
+            try { a.mutateBatch(ma.data(), rows, dim - 1); } catch(const MutationOperator::InvalidParameterException&){ rejected++; }
+            a.mutateBatch(ma.data(), rows, dim); b.mutateBatch(mb.data(), rows, dim);
+            size_t count = 0;
+            bool ok = rejected == 3 && changed(ma, count) && ma == mb && count == a.getStatistics().successfulMutations
+                    && std::fabs(count / double(rows * dim) - 0.2) < 0.01 && a.getStatistics().totalMutations == rows;
+            print_status("GaussianMutation::mutateBatch", ok, std::to_string(count) + " genes mutated"); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("GaussianMutation::mutateBatch", false, e.what()); all_ok=false; }
+        try {
+            UniformMutation op(32);
+            std::vector<double> m(rows * dim, 0.0);
+            op.prepareBatch(0.0, lo, hi);
+            op.mutateBatch(m.data(), rows, dim);
+            size_t none = 0, some = 0, all = 0;
+            bool ok = changed(m, none) && none == 0;
+            op.prepareBatch(0.3, lo, hi);
+            op.mutateBatch(m.data(), rows, dim);
+            ok = ok && changed(m, some) && std::fabs(some / double(rows * dim) - 0.3) < 0.01;
+            op.prepareBatch(1.0, lo, hi);
+            op.mutateBatch(m.data(), rows, dim);
+            ok = ok && changed(m, all) && all == rows * dim;
+            print_status("UniformMutation::mutateBatch", ok, std::to_string(some) + " genes mutated"); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("UniformMutation::mutateBatch", false, e.what()); all_ok=false; }
+    }
+
     // Mutation binary
     {
         auto b = make_bits(12);
@@ -153,6 +986,110 @@ int main(){
         try { InversionMutation op; op.mutate(p, 0.8); bool ok = (int)p.size()==10; print_status("InversionMutation<Perm>", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("InversionMutation<Perm>", false, e.what()); all_ok=false; }
     }
 
+    // Permutation mutators report their edits; TourCost deltas match full re-evaluation
+    {
+        std::mt19937 rng(17);
+        std::uniform_real_distribution<double> coord(0.0, 100.0);
+        for (bool symmetric : {true, false}) {
+            for (int n : {2, 3, 4, 5, 60}) {
+                std::vector<double> d(n * n);
+                for (int a = 0; a < n; ++a) for (int b = 0; b < n; ++b) d[a*n+b] = a == b ? 0.0 : coord(rng);
+                if (symmetric) for (int a = 0; a < n; ++a) for (int b = 0; b < a; ++b) d[a*n+b] = d[b*n+a];
+                ga::TourCost cost(d, n);
+                std::string name = std::string("TourCost delta (") + (symmetric ? "symmetric" : "asymmetric") + ", n=" + std::to_string(n) + ")";
+                try {
+                    SwapMutation swap(1); InversionMutation inversion(2); InsertMutation insert(3); ScrambleMutation scramble(4);
+                    auto tour = make_perm(n);
+                    double current = cost(tour);
+                    bool ok = cost.symmetric() == symmetric || n <= 2;
+                    for (int it = 0; it < 400 && ok; ++it) {
+                        auto before = tour;
+                        PermutationEdit edit;
+                        switch (it % 4) {
+                            case 0: swap.mutate(tour, 1.0, edit); break;
+                            case 1: inversion.mutate(tour, 1.0, edit); break;
+                            case 2: insert.mutate(tour, 1.0, edit); break;
+                            default: scramble.mutate(tour, 1.0, edit); break;
+                        }
+                        current += edit.kind == PermutationEdit::Kind::Scramble ? cost.delta(before, tour, edit) : cost.delta(tour, edit);
+                        ok = std::fabs(current - cost(tour)) < 1e-6;
+                    }
+                    print_status(name, ok); if(!ok) all_ok=false;
+                } catch(const std::exception& e){ print_status(name, false, e.what()); all_ok=false; }
+            }
+        }
+        try {
+            ga::TourCost cost({0, 1, 1, 0}, 2); std::vector<int> t = {0, 1};
+            bool threw = false;
+            try { cost.delta(t, PermutationEdit{PermutationEdit::Kind::Scramble, 0, 1}); } catch(const std::invalid_argument&) { threw = true; }
+            print_status("TourCost scramble needs the previous tour", threw); if(!threw) all_ok=false;
+        } catch(const std::exception& e){ print_status("TourCost scramble needs the previous tour", false, e.what()); all_ok=false; }
+    }
+
+    // Memetic local search: 2-opt/Or-opt keeps tours valid, tracks cost exactly,
+    // honours its budget and does not depend on the thread count
+    {
+        std::mt19937 rng(23);
+        std::uniform_real_distribution<double> coord(0.0, 100.0);
+        const int n = 300;
+        std::vector<double> x(n), y(n);
+        for (int i = 0; i < n; ++i) { x[i] = coord(rng); y[i] = coord(rng); }
+        ga::TourCost cost = ga::TourCost::euclidean(x, y);
+        auto isPermutation = [](std::vector<int> t) {
+            std::sort(t.begin(), t.end());
+            for (size_t i = 0; i < t.size(); ++i) if (t[i] != static_cast<int>(i)) return false;
+            return true;
+        };
+        try {
+            ga::TourLocalSearch search(cost);
+            auto tour = make_perm(n);
+            std::shuffle(tour.begin(), tour.end(), rng);
+            const double start = cost(tour);
+            size_t budget = static_cast<size_t>(-1);
+            const double improved = search.improve(tour, start, budget);
+            bool ok = isPermutation(tour) && improved < 0.3 * start && std::fabs(improved - cost(tour)) < 1e-6;
+            print_status("TourLocalSearch 2-opt/Or-opt", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("TourLocalSearch 2-opt/Or-opt", false, e.what()); all_ok=false; }
+        try {
+            auto runStage = [&](int threads, std::vector<std::vector<int>>& tours, std::vector<double>& costs) {
+                ga::MemeticStage::Options options;
+                options.fraction = 0.5; options.totalBudget = 20000; options.threads = threads;
+                ga::MemeticStage stage(std::make_unique<ga::TourLocalSearch>(cost), options);
+                std::mt19937 pick(5);
+                tours.assign(16, make_perm(n)); costs.assign(16, 0.0);
+                std::mt19937 shuffle(9);
+                for (size_t i = 0; i < tours.size(); ++i) { std::shuffle(tours[i].begin(), tours[i].end(), shuffle); costs[i] = cost(tours[i]); }
+                stage.apply(tours, costs, pick);
+                return stage.evaluationsUsed();
+            };
+            std::vector<std::vector<int>> serialTours, parallelTours;
+            std::vector<double> serialCosts, parallelCosts;
+            const size_t used = runStage(1, serialTours, serialCosts);
+            runStage(4, parallelTours, parallelCosts);
+            bool ok = used > 0 && used <= 20000 && serialTours == parallelTours && serialCosts == parallelCosts;
+            for (size_t i = 0; i < serialTours.size() && ok; ++i) {
+                ok = isPermutation(serialTours[i]) && std::fabs(serialCosts[i] - cost(serialTours[i])) < 1e-6;
+            }
+            print_status("MemeticStage budget and threads", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("MemeticStage budget and threads", false, e.what()); all_ok=false; }
+        try {
+            // Budgets smaller than the number of chosen tours are still respected
+            bool ok = true;
+            for (size_t total : {5, 13}) {
+                ga::MemeticStage::Options options;
+                options.fraction = 0.5; options.totalBudget = total;
+                ga::MemeticStage stage(std::make_unique<ga::TourLocalSearch>(cost), options);
+                std::vector<std::vector<int>> tours(16, make_perm(n));
+                std::vector<double> costs(16);
+                std::mt19937 pick(6), shuffle(10);
+                for (size_t i = 0; i < tours.size(); ++i) { std::shuffle(tours[i].begin(), tours[i].end(), shuffle); costs[i] = cost(tours[i]); }
+                for (int round = 0; round < 3; ++round) stage.apply(tours, costs, pick);
+                ok = ok && stage.evaluationsUsed() > 0 && stage.evaluationsUsed() <= total && stage.exhausted();
+            }
+            print_status("MemeticStage budget below tour count", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("MemeticStage budget below tour count", false, e.what()); all_ok=false; }
+    }
+
     // List mutation
     {
         std::vector<int> list = {1,2,3,4,5};
@@ -164,11 +1101,95 @@ int main(){
         std::vector<Individual> pop;
         for(int i=0;i<20;++i){ Individual ind; ind.fitness = i; ind.genes = std::vector<double>(5, i); pop.push_back(ind);} // increasing fitness
         try { auto idx = TournamentSelection::selectIndices(pop, 3); bool ok = !idx.empty() && idx[0] < pop.size(); print_status("TournamentSelection", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("TournamentSelection", false, e.what()); all_ok=false; }
+        try {
+            // Batched tournaments: with replacement the best wins ~1-(1-1/n)^k of them;
+            // without, every individual enters the same number, so the best wins exactly that many
+            std::vector<double> f(pop.size()); for (size_t i = 0; i < f.size(); ++i) f[i] = pop[i].fitness;
+            TournamentSelection ts(2, 5);
+            std::vector<size_t> winners(20000);
+            ts.selectBatch(f.data(), f.size(), winners.data(), winners.size(), true);
+            const double bestShare = std::count(winners.begin(), winners.end(), 19) / 20000.0;
+            bool ok = std::fabs(bestShare - (1.0 - 0.95*0.95)) < 0.01 && std::count(winners.begin(), winners.end(), 0) < 200;
+            ts.selectBatch(f.data(), f.size(), winners.data(), 1000, false);
+            ok = ok && std::count(winners.begin(), winners.begin() + 1000, 19) == 100 && std::count(winners.begin(), winners.begin() + 1000, 0) == 0;
+            size_t before = g_allocations;
+            ts.selectBatch(f.data(), f.size(), winners.data(), winners.size(), false);
+            ts.selectBatch(f.data(), f.size(), winners.data(), winners.size(), true);
+            ok = ok && g_allocations == before;
+            // Tournaments larger than the population draw n candidates, not tournament_size
+            TournamentSelection large(50, 6);
+            auto picked = large.select(pop, 20000);
+            const double largeShare = std::count_if(picked.begin(), picked.end(), [](const Individual& ind){ return ind.fitness == 19; }) / 20000.0;
+            ok = ok && std::fabs(largeShare - (1.0 - std::pow(0.95, 20))) < 0.015;
+            print_status("TournamentSelection batched", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("TournamentSelection batched", false, e.what()); all_ok=false; }
         try { auto idx = RouletteWheelSelection::selectIndices(pop, 5); bool ok = !idx.empty() && idx[0] < pop.size(); print_status("RouletteWheelSelection", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("RouletteWheelSelection", false, e.what()); all_ok=false; }
         try { std::vector<unsigned int> idx; // RankSelection selection API returns vectors of Individuals via select; use select on top
               RankSelection rank; auto sel = rank.select(pop, 5); bool ok = sel.size()==5; print_status("RankSelection", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("RankSelection", false, e.what()); all_ok=false; }
+        try {
+            // Radix ranking matches a stable sort; alias draws follow the rank CDF
+            std::vector<double> f = {3.5, -1.0, 0.0, -0.0, 1e300, -1e-300, 2.0, 3.5, -7.25, 0.5};
+            RankSelection rank(2.0); rank.setSeed(11);
+            rank.prepare(f.data(), f.size());
+            std::vector<size_t> expect(f.size()); std::iota(expect.begin(), expect.end(), 0);
+            std::stable_sort(expect.begin(), expect.end(), [&](size_t a, size_t b){ return f[a] < f[b]; });
+            bool ok = rank.rankedIndices() == expect;
+            for (auto scheme : {RankSelection::Scheme::Linear, RankSelection::Scheme::Exponential}) {
+                rank.setScheme(scheme, 0.7);
+                rank.prepare(f.data(), f.size());
+                std::vector<double> freq(f.size(), 0.0);
+                const int draws = 200000;
+                for (int i = 0; i < draws; ++i) freq[rank.sample()] += 1.0 / draws;
+                for (size_t r = 0; r < f.size() && ok; ++r) {
+                    const double p = rank.rankCdf()[r] - (r ? rank.rankCdf()[r-1] : 0.0);
+                    ok = std::fabs(freq[expect[r]] - p) < 0.005;
+                }
+            }
+            ok = ok && RankSelection::selectIndices(pop, 7).size() == 7;
+            print_status("RankSelection prepared ranking", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("RankSelection prepared ranking", false, e.what()); all_ok=false; }
         try { StochasticUniversalSampling sus; auto sel = sus.select(pop, 5); bool ok = sel.size()==5; print_status("StochasticUniversalSampling", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("StochasticUniversalSampling", false, e.what()); all_ok=false; }
-        try { auto idx = ElitismSelection::selectIndices(pop, 3); bool ok = idx.size()==3; print_status("ElitismSelection", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("ElitismSelection", false, e.what()); all_ok=false; }
+        try {
+            // Every individual gets floor or ceil of its expected count; the shuffled
+            // variant yields the same multiset, and the legacy indices are valid
+            std::mt19937 rng(9); std::uniform_real_distribution<double> u(0.0, 1.0);
+            std::vector<double> f(300); for (double& v : f) v = u(rng);
+            f[7] = -1.0; f[8] = 0.0;
+            const size_t count = 1000;
+            const double total = std::accumulate(f.begin(), f.end(), 0.0, [](double s, double v){ return s + std::max(0.0, v); });
+            StochasticUniversalSampling sus; sus.setSeed(3);
+            std::vector<size_t> sorted(count), shuffled(count);
+            sus.sampleIndices(f.data(), f.size(), sorted.data(), count);
+            sus.sampleIndicesShuffled(f.data(), f.size(), shuffled.data(), count);
+            std::vector<int> hits(f.size(), 0), hits2(f.size(), 0);
+            for (size_t i : sorted) hits[i]++;
+            for (size_t i : shuffled) hits2[i]++;
+            bool ok = std::is_sorted(sorted.begin(), sorted.end()) && !std::is_sorted(shuffled.begin(), shuffled.end());
+            for (size_t i = 0; i < f.size(); ++i) {
+                const double expected = std::max(0.0, f[i]) * count / total;
+                ok = ok && std::fabs(hits[i] - expected) < 1.0 + 1e-9 && std::fabs(hits2[i] - expected) < 1.0 + 1e-9;
+            }
+            ok = ok && hits[7] == 0 && hits[8] == 0;
+            auto legacy = StochasticUniversalSampling::selectIndices(pop, 5);
+            ok = ok && legacy.size() == 5;
+            for (unsigned idx : legacy) ok = ok && idx < pop.size();
+            print_status("StochasticUniversalSampling indices", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("StochasticUniversalSampling indices", false, e.what()); all_ok=false; }
+        try { auto idx = ElitismSelection::selectIndices(pop, 3); bool ok = idx == std::vector<unsigned int>{19, 18, 17}; print_status("ElitismSelection", ok); if(!ok) all_ok=false; } catch(const std::exception& e){ print_status("ElitismSelection", false, e.what()); all_ok=false; }
+        try {
+            // Top-k of a stream matches a full sort, also when split over two archives and merged
+            std::mt19937 rng(4); std::uniform_real_distribution<double> u(0.0, 1.0);
+            std::vector<double> f(1000); for (double& v : f) v = u(rng);
+            EliteArchive whole(25), left(25), right(25);
+            for (size_t i = 0; i < f.size(); ++i) { whole.offer(i, f[i]); (i % 2 ? left : right).offer(i, f[i]); }
+            left.merge(right);
+            std::vector<size_t> order(f.size()); std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b){ return f[a] > f[b]; });
+            order.resize(25);
+            std::vector<size_t> top, merged; whole.sortedIds(top); left.sortedIds(merged);
+            bool ok = top == order && merged == order && whole.threshold() == f[order.back()];
+            print_status("EliteArchive", ok); if(!ok) all_ok=false;
+        } catch(const std::exception& e){ print_status("EliteArchive", false, e.what()); all_ok=false; }
     }
 
     cout << (all_ok?"ALL PASS":"SOME FAILURES") << endl;